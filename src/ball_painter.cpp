@@ -38,8 +38,8 @@
 
 #include "ball_painter.h"
 
-#include "disp_holder.h"
-#include "options.h"
+#include "render_frame.h"
+#include "render_settings.h"
 #include "vector_2d.h"
 
 #include <rcsslogplayer/types.h>
@@ -50,8 +50,8 @@
 /*!
 
 */
-BallPainter::BallPainter( const DispHolder & disp_holder )
-    : M_disp_holder( disp_holder )
+BallPainter::BallPainter( const RenderFrame & frame )
+    : M_frame( frame )
 {
 
 }
@@ -70,16 +70,15 @@ BallPainter::~BallPainter()
 
 */
 void
-BallPainter::draw( QPainter & painter )
+BallPainter::draw( QPainter & painter,
+                   const RenderSettings & settings )
 {
-    const Options & opt = Options::instance();
-
-    if ( ! opt.showBall() )
+    if ( ! settings.showBall() )
     {
         return;
     }
 
-    DispConstPtr disp = M_disp_holder.currentDisp();
+    DispConstPtr disp = M_frame.currentDisp();
 
     if ( ! disp )
     {
@@ -87,29 +86,29 @@ BallPainter::draw( QPainter & painter )
         return;
     }
 
-    const rcss::rcg::ServerParamT & SP = M_disp_holder.serverParam();
+    const rcss::rcg::ServerParamT & SP = M_frame.serverParam();
 
     // decide radius
-    const int ball_radius = ( opt.ballSize() >= 0.01
-                              ? opt.scale( opt.ballSize() )
-                              : std::max( 1, opt.scale( SP.ball_size_ ) ) );
+    const int ball_radius = ( settings.ballSize() >= 0.01
+                              ? settings.scale( settings.ballSize() )
+                              : std::max( 1, settings.scale( SP.ball_size_ ) ) );
     const int kickable_radius
-        = std::max( 1, opt.scale( SP.player_size_
-                                  + SP.kickable_margin_
-                                  + SP.ball_size_ ) );
-    const int ix = opt.screenX( disp->show_.ball_.x_ );
-    const int iy = opt.screenY( disp->show_.ball_.y_ );
+        = std::max( 1, settings.scale( SP.player_size_
+                                       + SP.kickable_margin_
+                                       + SP.ball_size_ ) );
+    const int ix = settings.screenX( disp->show_.ball_.x_ );
+    const int iy = settings.screenY( disp->show_.ball_.y_ );
 
     // draw ball body
     painter.setPen( Qt::NoPen );
-    painter.setBrush( opt.ballBrush() );
+    painter.setBrush( settings.ballBrush() );
     painter.drawEllipse( ix - ball_radius,
                          iy - ball_radius,
                          ball_radius * 2,
                          ball_radius * 2 );
 
     // draw kickable margin
-    painter.setPen( opt.ballPen() );
+    painter.setPen( settings.ballPen() );
     painter.setBrush( Qt::NoBrush );
     painter.drawEllipse( ix - kickable_radius,
                          iy - kickable_radius,
@@ -117,10 +116,10 @@ BallPainter::draw( QPainter & painter )
                          kickable_radius * 2 );
 
     // draw future status
-    if ( opt.ballVelCycle() > 0
+    if ( settings.ballVelCycle() > 0
          && disp->show_.ball_.hasVelocity() )
     {
-        drawVelocity( painter );
+        drawVelocity( painter, settings );
     }
 }
 
@@ -129,18 +128,17 @@ BallPainter::draw( QPainter & painter )
 
 */
 void
-BallPainter::drawVelocity( QPainter & painter ) const
+BallPainter::drawVelocity( QPainter & painter,
+                           const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-
-    if ( opt.antiAliasing() )
+    if ( settings.antiAliasing() )
     {
         painter.setRenderHint( QPainter::Antialiasing, false );
     }
 
-    const rcss::rcg::ServerParamT & SP = M_disp_holder.serverParam();
+    const rcss::rcg::ServerParamT & SP = M_frame.serverParam();
 
-    DispConstPtr disp = M_disp_holder.currentDisp();
+    DispConstPtr disp = M_frame.currentDisp();
 
     const double bdecay = SP.ball_decay_;
 
@@ -149,20 +147,20 @@ BallPainter::drawVelocity( QPainter & painter ) const
     Vector2D bvel( disp->show_.ball_.vx_,
                    disp->show_.ball_.vy_ );
 
-    QPoint first_point( opt.screenX( bpos.x ),
-                        opt.screenY( bpos.y ) );
+    QPoint first_point( settings.screenX( bpos.x ),
+                        settings.screenY( bpos.y ) );
     QPoint last_point = first_point;
 
     QPainterPath path;
 
-    const int max_cycle = std::min( 100,  Options::instance().ballVelCycle() );
+    const int max_cycle = std::min( 100,  settings.ballVelCycle() );
     for ( int i = 0; i < max_cycle; ++i )
     {
         bpos += bvel;
         bvel *= bdecay;
 
-        QPoint pt( opt.screenX( bpos.x ),
-                   opt.screenY( bpos.y ) );
+        QPoint pt( settings.screenX( bpos.x ),
+                   settings.screenY( bpos.y ) );
         if ( std::abs( last_point.x() - pt.x() ) < 1
              && std::abs( last_point.y() - pt.y() ) < 1 )
         {
@@ -178,12 +176,12 @@ BallPainter::drawVelocity( QPainter & painter ) const
     path.moveTo( first_point );
     path.lineTo( last_point );
 
-    painter.setPen( opt.ballVelPen() );
+    painter.setPen( settings.ballVelPen() );
     painter.setBrush( Qt::NoBrush );
 
     painter.drawPath( path );
 
-    if ( opt.antiAliasing() )
+    if ( settings.antiAliasing() )
     {
         painter.setRenderHint( QPainter::Antialiasing );
     }
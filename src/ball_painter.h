@@ -35,12 +35,12 @@
 
 #include "painter_interface.h"
 
-class DispHolder;
+class RenderFrame;
 
 class BallPainter
     : public PainterInterface {
 private:
-    const DispHolder & M_disp_holder;
+    const RenderFrame & M_frame;
 
     // not used
     BallPainter();
@@ -48,14 +48,16 @@ private:
     const BallPainter & operator=( const BallPainter & );
 public:
 
-    BallPainter( const DispHolder & disp_holder );
+    BallPainter( const RenderFrame & frame );
     ~BallPainter();
 
-    void draw( QPainter & painter );
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
 
 private:
 
-    void drawVelocity( QPainter & painter ) const;
+    void drawVelocity( QPainter & painter,
+                       const RenderSettings & settings ) const;
 
 };
 
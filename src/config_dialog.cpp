@@ -262,6 +262,10 @@ ConfigDialog::createWidgets()
                            0, Qt::AlignLeft );
         layout->addWidget( createBallInfoControls(),
                            0, Qt::AlignLeft );
+        layout->addWidget( createTraceControls(),
+                           0, Qt::AlignLeft );
+        layout->addWidget( createHeatMapControls(),
+                           0, Qt::AlignLeft );
 
         layout->addStretch();
 
@@ -946,106 +950,89 @@ ConfigDialog::createGridStepControls()
 /*!
 
 */
-#if 0
 QWidget *
 ConfigDialog::createTraceControls()
 {
     QGroupBox * group_box = new QGroupBox( tr( "Trace" ) );
 
-    QVBoxLayout * top_layout = new QVBoxLayout();
-    top_layout->setMargin( 0 );
+    QHBoxLayout * top_layout = new QHBoxLayout();
+    top_layout->setMargin( 1 );
     top_layout->setSpacing( 0 );
 
-    {
-        QGroupBox * ball_box = new QGroupBox( tr( "Ball" ) );
-
-        QHBoxLayout * layout = new QHBoxLayout();
-        layout->setSizeConstraint( QLayout::SetFixedSize );
-        layout->setMargin( 0 );
-        layout->setSpacing( 0 );
+    top_layout->addWidget( new QLabel( tr( "Ball:" ) ) );
+    top_layout->addSpacing( 2 );
 
-        M_ball_trace_start = new QLineEdit( tr( "0" ) );
-        M_ball_trace_start->setValidator( new QIntValidator( 0, 200000, M_ball_trace_start ) );
-        M_ball_trace_start->setMaximumSize( 36, 24 );
-        connect( M_ball_trace_start, SIGNAL( textEdited( const QString & ) ),
-                 this, SLOT( editBallTraceStart( const QString & ) ) );
-        layout->addWidget( M_ball_trace_start, 0, Qt::AlignVCenter );
+    M_ball_trace_cycle = new QSpinBox();
+    M_ball_trace_cycle->setRange( 0, 6000 );
+    M_ball_trace_cycle->setValue( Options::instance().ballTraceCycle() );
+    connect( M_ball_trace_cycle, SIGNAL( valueChanged( int ) ),
+             this, SLOT( changeBallTraceCycle( int ) ) );
+    top_layout->addWidget( M_ball_trace_cycle );
 
-        layout->addWidget( new QLabel( tr( "-" ) ), 0, Qt::AlignVCenter );
+    top_layout->addSpacing( 8 );
 
-        M_ball_trace_end = new QLineEdit( tr( "0" ) );
-        M_ball_trace_end->setValidator( new QIntValidator( 0, 200000, M_ball_trace_end ) );
-        M_ball_trace_end->setMaximumSize( 36, 24 );
-        connect( M_ball_trace_end, SIGNAL( textEdited( const QString & ) ),
-                 this, SLOT( editBallTraceEnd( const QString & ) ) );
-        layout->addWidget( M_ball_trace_end, 0, Qt::AlignVCenter );
+    top_layout->addWidget( new QLabel( tr( "Player:" ) ) );
+    top_layout->addSpacing( 2 );
 
-        QPushButton * all_btn = new QPushButton( tr( "All" ) );
-        all_btn->setMaximumSize( 48, this->fontMetrics().height() + 12 );
-        all_btn->setSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed );
-        connect( all_btn, SIGNAL( clicked() ),
-                 this, SLOT( clickBallTraceAll() ) );
-        layout->addWidget( all_btn, 0, Qt::AlignVCenter );
+    M_player_trace_cycle = new QSpinBox();
+    M_player_trace_cycle->setRange( 0, 6000 );
+    M_player_trace_cycle->setValue( Options::instance().playerTraceCycle() );
+    connect( M_player_trace_cycle, SIGNAL( valueChanged( int ) ),
+             this, SLOT( changePlayerTraceCycle( int ) ) );
+    top_layout->addWidget( M_player_trace_cycle );
 
-        ball_box->setLayout( layout );
-        //first_layout->addWidget( ball_box );
-        top_layout->addWidget( ball_box );
-    }
+    top_layout->addSpacing( 4 );
 
-    top_layout->addSpacing( 2 );
-    {
-        QGroupBox * player_box = new QGroupBox( tr( "Player" ) );
+    M_player_trace_all_cb = new QCheckBox( tr( "All Players" ) );
+    M_player_trace_all_cb->setChecked( Options::instance().playerTraceAll() );
+    connect( M_player_trace_all_cb, SIGNAL( clicked( bool ) ),
+             this, SLOT( clickPlayerTraceAll( bool ) ) );
+    top_layout->addWidget( M_player_trace_all_cb );
 
-        QHBoxLayout * layout= new QHBoxLayout();
-        layout->setSizeConstraint( QLayout::SetFixedSize );
-        layout->setMargin( 0 );
-        layout->setSpacing( 0 );
+    group_box->setLayout( top_layout );
+    return group_box;
+}
 
-        M_player_trace_start = new QLineEdit( tr( "0" ) );
-        M_player_trace_start->setValidator( new QIntValidator( 0, 200000, M_player_trace_start ) );
-        M_player_trace_start->setMaximumSize( 36, 24 );
-        connect( M_player_trace_start, SIGNAL( textEdited( const QString & ) ),
-                 this, SLOT( editPlayerTraceStart( const QString & ) ) );
-        layout->addWidget( M_player_trace_start, 0, Qt::AlignVCenter );
+/*-------------------------------------------------------------------*/
+/*!
 
-        layout->addWidget( new QLabel( tr( "-" ) ), 0, Qt::AlignVCenter );
+*/
+QWidget *
+ConfigDialog::createHeatMapControls()
+{
+    QGroupBox * group_box = new QGroupBox( tr( "Heat Map" ) );
 
-        M_player_trace_end = new QLineEdit( tr( "0" ) );
-        M_player_trace_end->setValidator( new QIntValidator( 0, 200000, M_player_trace_end ) );
-        M_player_trace_end->setMaximumSize( 36, 24 );
-        connect( M_ball_trace_end, SIGNAL( textEdited( const QString & ) ),
-                 this, SLOT( editBallTraceEnd( const QString & ) ) );
-        layout->addWidget( M_player_trace_end, 0, Qt::AlignVCenter );
+    QHBoxLayout * top_layout = new QHBoxLayout();
+    top_layout->setMargin( 1 );
+    top_layout->setSpacing( 0 );
 
-        QPushButton * all_btn = new QPushButton( tr( "All" ) );
-        all_btn->setMaximumSize( 48, this->fontMetrics().height() + 12 );
-        all_btn->setSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed );
-        connect( all_btn, SIGNAL( clicked() ),
-                 this, SLOT( clickPlayerTraceAll() ) );
-        layout->addWidget( all_btn, 0, Qt::AlignVCenter );
+    M_heat_map_type_choice = new QComboBox();
+    M_heat_map_type_choice->addItem( tr( "None" ) );
+    M_heat_map_type_choice->addItem( tr( "Left Team" ) );
+    M_heat_map_type_choice->addItem( tr( "Right Team" ) );
+    M_heat_map_type_choice->addItem( tr( "Selected Player" ) );
+    M_heat_map_type_choice->setCurrentIndex( Options::instance().heatMapType() );
+    connect( M_heat_map_type_choice, SIGNAL( activated( int ) ),
+             this, SLOT( selectHeatMapType( int ) ) );
+    top_layout->addWidget( M_heat_map_type_choice );
 
-        player_box->setLayout( layout );
-        //first_layout->addWidget( player_box );
-        top_layout->addWidget( player_box );
-    }
+    top_layout->addSpacing( 8 );
 
+    top_layout->addWidget( new QLabel( tr( "Cycles:" ) ) );
     top_layout->addSpacing( 2 );
 
-    {
-        QPushButton * line_point_btn = new QPushButton( tr( "Line/Point" ) );
-        line_point_btn->setMaximumSize( 80, this->fontMetrics().height() + 12 );
-        connect( line_point_btn, SIGNAL( clicked() ),
-                 this, SLOT( clickLinePointButton() ) );
-
-        top_layout->addWidget( line_point_btn, 0, Qt::AlignLeft );
-    }
+    M_heat_map_cycle = new QSpinBox();
+    M_heat_map_cycle->setRange( 0, 65535 );
+    M_heat_map_cycle->setSpecialValueText( tr( "All" ) );
+    M_heat_map_cycle->setValue( Options::instance().heatMapCycle() );
+    connect( M_heat_map_cycle, SIGNAL( valueChanged( int ) ),
+             this, SLOT( changeHeatMapCycle( int ) ) );
+    top_layout->addWidget( M_heat_map_cycle );
 
     group_box->setLayout( top_layout );
-    return group_box;;
+    return group_box;
 }
 
-#endif
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1314,11 +1301,12 @@ ConfigDialog::updateAll()
         break;
     }
 
-//     M_ball_trace_start->setText( QString::number( opt.ballTraceStart() ) );
-//     M_ball_trace_end->setText( QString::number( opt.ballTraceEnd() ) );
+    M_ball_trace_cycle->setValue( opt.ballTraceCycle() );
+    M_player_trace_cycle->setValue( opt.playerTraceCycle() );
+    M_player_trace_all_cb->setChecked( opt.playerTraceAll() );
 
-//     M_player_trace_start->setText( QString::number( opt.playerTraceStart() ) );
-//     M_player_trace_end->setText( QString::number( opt.playerTraceEnd() ) );
+    M_heat_map_type_choice->setCurrentIndex( opt.heatMapType() );
+    M_heat_map_cycle->setValue( opt.heatMapCycle() );
 
 //     M_ball_vel_cycle->setValue( opt.ballVelCycle() );
 
@@ -2442,20 +2430,16 @@ ConfigDialog::selectPlayerWithKey()
     }
 }
 
-#if 0
 /*-------------------------------------------------------------------*/
 /*!
 
 */
 void
-ConfigDialog::editBallTraceStart( const QString & text )
+ConfigDialog::changeBallTraceCycle( int value )
 {
-    bool ok = true;
-    long value = text.toLong( & ok );
-
-    if ( ok )
+    if ( Options::instance().ballTraceCycle() != value )
     {
-        Options::instance().setBallTraceStart( value );
+        Options::instance().setBallTraceCycle( value );
 
         emit configured();
     }
@@ -2466,14 +2450,11 @@ ConfigDialog::editBallTraceStart( const QString & text )
 
 */
 void
-ConfigDialog::editBallTraceEnd( const QString & text )
+ConfigDialog::changePlayerTraceCycle( int value )
 {
-    bool ok = true;
-    long value = text.toLong( & ok );
-
-    if ( ok )
+    if ( Options::instance().playerTraceCycle() != value )
     {
-        Options::instance().setBallTraceEnd( value );
+        Options::instance().setPlayerTraceCycle( value );
 
         emit configured();
     }
@@ -2484,29 +2465,11 @@ ConfigDialog::editBallTraceEnd( const QString & text )
 
 */
 void
-ConfigDialog::clickBallTraceAll()
+ConfigDialog::clickPlayerTraceAll( bool checked )
 {
-    const std::vector< DispPtr > & cont = M_main_data.dispHolder().dispInfoCont();
-
-    if ( ! cont.empty() )
+    if ( Options::instance().playerTraceAll() != checked )
     {
-        if ( Options::instance().ballTraceStart() == cont.front()->show_.time_
-             && Options::instance().ballTraceEnd() == cont.back()->show_.time_ )
-        {
-            M_ball_trace_start->setText( QString::number( 0 ) );
-            M_ball_trace_end->setText( QString::number( 0 ) );
-
-            Options::instance().setBallTraceStart( 0 );
-            Options::instance().setBallTraceEnd( 0 );
-        }
-        else
-        {
-            M_ball_trace_start->setText( QString::number( cont.front()->show_.time_ ) );
-            M_ball_trace_end->setText( QString::number( cont.back()->show_.time_ ) );
-
-            Options::instance().setBallTraceStart( cont.front()->show_.time_ );
-            Options::instance().setBallTraceEnd( cont.back()->show_.time_ );
-        }
+        Options::instance().togglePlayerTraceAll();
 
         emit configured();
     }
@@ -2517,14 +2480,11 @@ ConfigDialog::clickBallTraceAll()
 
 */
 void
-ConfigDialog::editPlayerTraceStart( const QString & text )
+ConfigDialog::selectHeatMapType( int index )
 {
-    bool ok = true;
-    long value = text.toLong( & ok );
-
-    if ( ok )
+    if ( Options::instance().heatMapType() != index )
     {
-        Options::instance().setPlayerTraceStart( value );
+        Options::instance().setHeatMapType( static_cast< Options::HeatMapType >( index ) );
 
         emit configured();
     }
@@ -2535,17 +2495,12 @@ ConfigDialog::editPlayerTraceStart( const QString & text )
 
 */
 void
-ConfigDialog::editPlayerTraceEnd( const QString & text )
+ConfigDialog::changeHeatMapType()
 {
-    bool ok = true;
-    long value = text.toLong( & ok );
+    Options::instance().changeHeatMapType();
+    M_heat_map_type_choice->setCurrentIndex( Options::instance().heatMapType() );
 
-    if ( ok )
-    {
-        Options::instance().setPlayerTraceEnd( value );
-
-        emit configured();
-    }
+    emit configured();
 }
 
 /*-------------------------------------------------------------------*/
@@ -2553,33 +2508,17 @@ ConfigDialog::editPlayerTraceEnd( const QString & text )
 
 */
 void
-ConfigDialog::clickPlayerTraceAll()
+ConfigDialog::changeHeatMapCycle( int value )
 {
-    const std::vector< DispPtr > & cont = M_main_data.dispHolder().dispInfoCont();
-    if ( ! cont.empty() )
+    if ( Options::instance().heatMapCycle() != value )
     {
-        if ( Options::instance().playerTraceStart() == cont.front()->show_.time_
-             && Options::instance().playerTraceEnd() == cont.back()->show_.time_ )
-        {
-            M_player_trace_start->setText( QString::number( 0 ) );
-            M_player_trace_end->setText( QString::number( 0 ) );
-
-            Options::instance().setPlayerTraceStart( 0 );
-            Options::instance().setPlayerTraceEnd( 0 );
-        }
-        else
-        {
-            M_player_trace_start->setText( QString::number( cont.front()->show_.time_ ) );
-            M_player_trace_end->setText( QString::number( cont.back()->show_.time_ ) );
-
-            Options::instance().setPlayerTraceStart( cont.front()->show_.time_ );
-            Options::instance().setPlayerTraceEnd( cont.back()->show_.time_ );
-        }
+        Options::instance().setHeatMapCycle( value );
 
         emit configured();
     }
 }
 
+#if 0
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -195,11 +195,14 @@ private:
 
     QComboBox * M_player_choice;
 
-//     // trace control
-//     QLineEdit * M_ball_trace_start;
-//     QLineEdit * M_ball_trace_end;
-//     QLineEdit * M_player_trace_start;
-//     QLineEdit * M_player_trace_end;
+    // trace control
+    QSpinBox * M_ball_trace_cycle;
+    QSpinBox * M_player_trace_cycle;
+    QCheckBox * M_player_trace_all_cb;
+
+    // heat map control
+    QComboBox * M_heat_map_type_choice;
+    QSpinBox * M_heat_map_cycle;
 
     // inertia movement control
     QSpinBox * M_ball_vel_cycle;
@@ -221,6 +224,8 @@ private:
     QWidget * createCanvasSizeControls();
     QWidget * createPlayerInfoControls();
     QWidget * createBallInfoControls();
+    QWidget * createTraceControls();
+    QWidget * createHeatMapControls();
     QWidget * createShowControls();
     QWidget * createFieldStyleControls();
     QWidget * createMiscControls();
@@ -286,13 +291,12 @@ private slots:
 
     void choicePlayer( int number );
 
-//     void editBallTraceStart( const QString & text );
-//     void editBallTraceEnd( const QString & text );
-//     void clickBallTraceAll();
+    void changeBallTraceCycle( int value );
+    void changePlayerTraceCycle( int value );
+    void clickPlayerTraceAll( bool checked );
 
-//     void editPlayerTraceStart( const QString & text );
-//     void editPlayerTraceEnd( const QString & text );
-//     void clickPlayerTraceAll();
+    void selectHeatMapType( int index );
+    void changeHeatMapCycle( int value );
 
 //     void clickLinePointButton();
 
@@ -324,6 +328,8 @@ public slots:
     void toggleShowPlayer();
     void toggleShowBall();
 
+    void changeHeatMapType();
+
     void toggleShowPlayerNumber();
     void toggleShowPlayerType();
     void toggleShowStamina();
@@ -0,0 +1,205 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_stats.cpp
+  \brief live cycle statistics class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "cycle_stats.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+
+namespace {
+//! the skipped cycles older than this window are not waited any more.
+const int REORDER_WINDOW = 50;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CycleStats::CycleStats()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CycleStats::clear()
+{
+    M_last_cycle = -1;
+    M_last_stoppage = false;
+    M_missing.clear();
+
+    M_received = 0;
+    M_substeps = 0;
+    M_gaps = 0;
+    M_lost = 0;
+    M_reordered = 0;
+    M_duplicated = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CycleStats::Result
+CycleStats::add( const int cycle,
+                 const bool stoppage )
+{
+    ++M_received;
+
+    if ( M_last_cycle < 0
+         || cycle < M_last_cycle - REORDER_WINDOW )
+    {
+        // the first show, or the server has been restarted.
+        M_last_cycle = cycle;
+        M_last_stoppage = stoppage;
+        M_missing.clear();
+        return IN_ORDER;
+    }
+
+    if ( cycle == M_last_cycle )
+    {
+        if ( stoppage
+             || M_last_stoppage )
+        {
+            M_last_stoppage = stoppage;
+            ++M_substeps;
+            return IN_ORDER;
+        }
+
+        ++M_duplicated;
+        return DUPLICATED;
+    }
+
+    if ( cycle < M_last_cycle )
+    {
+        std::set< int >::iterator it = M_missing.find( cycle );
+        if ( it == M_missing.end() )
+        {
+            ++M_duplicated;
+            return DUPLICATED;
+        }
+
+        M_missing.erase( it );
+        --M_lost;
+        ++M_reordered;
+        return REORDERED;
+    }
+
+    Result result = IN_ORDER;
+
+    if ( cycle > M_last_cycle + 1 )
+    {
+        ++M_gaps;
+        M_lost += cycle - M_last_cycle - 1;
+
+        for ( int c = std::max( M_last_cycle + 1, cycle - REORDER_WINDOW );
+              c < cycle;
+              ++c )
+        {
+            M_missing.insert( c );
+        }
+
+        result = GAP;
+    }
+
+    M_last_cycle = cycle;
+    M_last_stoppage = stoppage;
+
+    // forget the cycles that cannot be filled any more
+    M_missing.erase( M_missing.begin(),
+                     M_missing.lower_bound( cycle - REORDER_WINDOW ) );
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+CycleStats::lostRate() const
+{
+    const long expected = M_received - M_duplicated - M_substeps + M_lost;
+    return ( expected > 0
+             ? static_cast< double >( M_lost ) / expected
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+CycleStats::reorderedRate() const
+{
+    return ( M_received > 0
+             ? static_cast< double >( M_reordered ) / M_received
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+CycleStats::duplicatedRate() const
+{
+    return ( M_received > 0
+             ? static_cast< double >( M_duplicated ) / M_received
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+CycleStats::print( std::ostream & os ) const
+{
+    char buf[256];
+    std::snprintf( buf, sizeof( buf ),
+                   "received %ld, substeps %ld, gaps %ld, lost %ld (%.2f%%),"
+                   " reordered %ld (%.2f%%), duplicated %ld (%.2f%%)",
+                   M_received, M_substeps, M_gaps,
+                   M_lost, lostRate() * 100.0,
+                   M_reordered, reorderedRate() * 100.0,
+                   M_duplicated, duplicatedRate() * 100.0 );
+    return os << buf;
+}
@@ -0,0 +1,125 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_stats.h
+  \brief live cycle statistics class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_CYCLE_STATS_H
+#define RCSSMONITOR_CYCLE_STATS_H
+
+#include <set>
+#include <iosfwd>
+
+/*!
+  \class CycleStats
+  \brief continuity check of the show cycles received from the live path.
+
+  The expected next cycle is the last cycle + 1. The same cycle is
+  accepted as a stoppage sub-step if the playmode of the new show or the
+  previous show is not play_on, because the server does not advance the
+  time during the stoppage, and the show of the kick-off or set piece
+  step has the same time with the playmode already switched to play_on.
+  The cycles skipped by a jump are remembered for a while, and the late
+  show of such a cycle is counted as reordered and removed from the
+  lost cycles. Any other old or repeated show is counted as duplicated.
+*/
+class CycleStats {
+public:
+
+    //! the kind of the received show
+    enum Result {
+        IN_ORDER, //!< the expected next cycle or a stoppage sub-step
+        GAP, //!< in order, but some cycles have been skipped
+        REORDERED, //!< late show of a skipped cycle
+        DUPLICATED //!< already received or too old show
+    };
+
+private:
+
+    //! the last cycle received in order. -1 if not received yet.
+    int M_last_cycle;
+    //! true if the last show received in order was in the stoppage.
+    bool M_last_stoppage;
+    //! skipped cycles that can still be filled by the late shows
+    std::set< int > M_missing;
+
+    long M_received; //!< the number of received shows
+    long M_substeps; //!< the number of stoppage sub-steps
+    long M_gaps; //!< the number of detected jumps
+    long M_lost; //!< the number of skipped cycles not filled yet
+    long M_reordered; //!< the number of late shows
+    long M_duplicated; //!< the number of duplicated shows
+
+public:
+
+    CycleStats();
+
+    void clear();
+
+    /*!
+      \brief classify the received show and update the counters.
+      \param cycle game time of the show
+      \param stoppage true if the playmode is not play_on
+      \return the kind of the show
+     */
+    Result add( const int cycle,
+                const bool stoppage );
+
+    int lastCycle() const { return M_last_cycle; }
+
+    long received() const { return M_received; }
+    long substeps() const { return M_substeps; }
+    long gaps() const { return M_gaps; }
+    long lost() const { return M_lost; }
+    long reordered() const { return M_reordered; }
+    long duplicated() const { return M_duplicated; }
+
+    /*!
+      \brief get the ratio of the lost cycles to the expected cycles.
+     */
+    double lostRate() const;
+
+    /*!
+      \brief get the ratio of the late shows to the received shows.
+     */
+    double reorderedRate() const;
+
+    /*!
+      \brief get the ratio of the duplicated shows to the received shows.
+     */
+    double duplicatedRate() const;
+
+    /*!
+      \brief print the summary of the counters.
+     */
+    std::ostream & print( std::ostream & os ) const;
+
+};
+
+#endif
@@ -57,6 +57,12 @@
 const size_t DispHolder::INVALID_INDEX = size_t( -1 );
 
 namespace {
+
+//! the late show is inserted only within this number of the last buffered data.
+const size_t LATE_SHOW_WINDOW = 256;
+//! the number of the insertions tracked for firstShiftedIndex().
+const size_t MAX_SHIFT_HISTORY = 64;
+
 struct TimeCmp {
     bool operator()( const DispConstPtr & lhs,
                      const rcss::rcg::UInt32 rhs )
@@ -64,17 +70,110 @@ struct TimeCmp {
           return lhs->show_.time_ < rhs;
       }
 };
+
+const char *
+cycle_result_name( const CycleStats::Result result )
+{
+    switch ( result ) {
+    case CycleStats::GAP:
+        return "gap";
+    case CycleStats::REORDERED:
+        return "reordered";
+    case CycleStats::DUPLICATED:
+        return "duplicated";
+    default:
+        break;
+    }
+    return "in order";
+}
+
+/*!
+  \brief compare the contents of the show data.
+  \return true if the ball and all players are the same.
+ */
+bool
+same_show( const rcss::rcg::ShowInfoT & lhs,
+           const rcss::rcg::ShowInfoT & rhs )
+{
+    if ( lhs.time_ != rhs.time_
+         || lhs.ball_.x_ != rhs.ball_.x_
+         || lhs.ball_.y_ != rhs.ball_.y_
+         || lhs.ball_.vx_ != rhs.ball_.vx_
+         || lhs.ball_.vy_ != rhs.ball_.vy_ )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+    {
+        const rcss::rcg::PlayerT & l = lhs.player_[i];
+        const rcss::rcg::PlayerT & r = rhs.player_[i];
+        if ( l.state_ != r.state_
+             || l.x_ != r.x_
+             || l.y_ != r.y_
+             || l.vx_ != r.vx_
+             || l.vy_ != r.vy_
+             || l.body_ != r.body_
+             || l.neck_ != r.neck_
+             || l.stamina_ != r.stamina_ )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+  \brief insert the index into the sorted event index.
+ */
+void
+insert_event_index( std::vector< size_t > & index,
+                    const size_t idx )
+{
+    std::vector< size_t >::iterator it = std::lower_bound( index.begin(), index.end(), idx );
+    if ( it == index.end()
+         || *it != idx )
+    {
+        index.insert( it, idx );
+    }
+}
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DispAnalysis::DispAnalysis()
+    : ball_owner_( -1 )
+{
+    for ( int i = 0; i < 2; ++i )
+    {
+        nearest_player_[i] = -1;
+        nearest_dist2_[i] = 0.0f;
+        offside_line_x_[i] = 0.0f;
+        min_x_[i] = min_y_[i] = 0.0f;
+        max_x_[i] = max_y_[i] = -1.0f;
+    }
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-DispHolder::DispHolder()
+DispHolder::DispHolder( const bool buffering )
     : M_rcg_version( 0 ),
-      M_current_index( INVALID_INDEX )
+      M_current_index( INVALID_INDEX ),
+      M_revision( 0 ),
+      M_buffer_revision( 0 ),
+      M_buffering( buffering ),
+      M_live_input( false )
 {
-    M_disp_cont.reserve( 65535 );
+    if ( M_buffering )
+    {
+        M_disp_cont.reserve( 65535 );
+        M_analysis_cont.reserve( 65535 );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -83,7 +182,8 @@ DispHolder::DispHolder()
  */
 DispHolder::~DispHolder()
 {
-
+    saveTeamGraphicCache();
+    printCycleStats();
 }
 
 /*-------------------------------------------------------------------*/
@@ -93,6 +193,11 @@ DispHolder::~DispHolder()
 void
 DispHolder::clear()
 {
+    QWriteLocker lock( &M_lock );
+
+    // keep the assembled team graphics before they are cleared.
+    saveTeamGraphicCache();
+
     M_rcg_version = 0;
 
     M_server_param = rcss::rcg::ServerParamT();
@@ -101,6 +206,8 @@ DispHolder::clear()
 
     M_team_graphic_left.clear();
     M_team_graphic_right.clear();
+    M_team_graphic_cache_name[0].clear();
+    M_team_graphic_cache_name[1].clear();
 
     M_penalty_scores_left.clear();
     M_penalty_scores_right.clear();
@@ -116,7 +223,24 @@ DispHolder::clear()
     M_disp.reset();
     M_disp_cont.clear();
 
+    M_analysis = DispAnalysis();
+    M_analysis_cont.clear();
+
+    M_heat_map.clear();
+
+    for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+    {
+        M_event_index[i].clear();
+    }
+
     M_current_index = INVALID_INDEX;
+    ++M_revision;
+    ++M_buffer_revision;
+    M_shifted_indices.clear();
+
+    printCycleStats();
+    M_live_input = false;
+    M_cycle_stats.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -154,6 +278,22 @@ DispHolder::currentDisp() const
     return M_disp;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const DispAnalysis &
+DispHolder::currentAnalysis() const
+{
+    if ( M_current_index != INVALID_INDEX
+         && M_current_index < M_analysis_cont.size() )
+    {
+        return M_analysis_cont[M_current_index];
+    }
+
+    return M_analysis;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -161,6 +301,10 @@ DispHolder::currentDisp() const
 bool
 DispHolder::addDispInfoV1( const rcss::rcg::dispinfo_t & disp )
 {
+    QWriteLocker lock( &M_lock );
+
+    M_live_input = true;
+
     switch ( ntohs( disp.mode ) ) {
     case rcss::rcg::NO_INFO:
         break;
@@ -197,6 +341,10 @@ DispHolder::addDispInfoV1( const rcss::rcg::dispinfo_t & disp )
 bool
 DispHolder::addDispInfoV2( const rcss::rcg::dispinfo_t2 & disp )
 {
+    QWriteLocker lock( &M_lock );
+
+    M_live_input = true;
+
     switch ( ntohs( disp.mode ) ) {
     case rcss::rcg::NO_INFO:
         break;
@@ -260,11 +408,33 @@ DispHolder::addDispInfoV2( const rcss::rcg::dispinfo_t2 & disp )
 bool
 DispHolder::addDispInfoV3( const char * msg )
 {
+    QWriteLocker lock( &M_lock );
+
+    M_live_input = true;
+
     rcss::rcg::Parser parser( *this );
 
     return parser.parseLine( -1, msg );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+DispHolder::addDispInfo( const rcss::rcg::DispInfoT & disp )
+{
+    QWriteLocker lock( &M_lock );
+
+    M_live_input = true;
+
+    doHandlePlayMode( disp.show_.time_, disp.pmode_ );
+    doHandleTeamInfo( disp.show_.time_, disp.team_[0], disp.team_[1] );
+    doHandleShowInfo( disp.show_ );
+
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -292,6 +462,44 @@ DispHolder::doGetLogVersion() const
 void
 DispHolder::doHandleShowInfo( const rcss::rcg::ShowInfoT & show )
 {
+    loadTeamGraphicCache();
+
+    if ( M_live_input )
+    {
+        const int last_cycle = M_cycle_stats.lastCycle();
+        const CycleStats::Result result
+            = M_cycle_stats.add( show.time_, M_playmode != rcss::rcg::PM_PlayOn );
+
+        if ( result != CycleStats::IN_ORDER
+             && Options::instance().cycleStats() )
+        {
+            std::cerr << "show " << show.time_ << ": " << cycle_result_name( result )
+                      << " (last " << last_cycle << ")" << std::endl;
+        }
+
+        if ( result == CycleStats::DUPLICATED )
+        {
+            // only the repeated content is dropped.
+            if ( hasShow( show ) )
+            {
+                return;
+            }
+
+            if ( static_cast< int >( show.time_ ) != last_cycle )
+            {
+                insertLateShow( show );
+                return;
+            }
+        }
+
+        if ( result == CycleStats::REORDERED )
+        {
+            // the live display never goes back to the late show.
+            insertLateShow( show );
+            return;
+        }
+    }
+
     DispPtr disp( new rcss::rcg::DispInfoT );
 
     disp->pmode_ = M_playmode;
@@ -300,16 +508,247 @@ DispHolder::doHandleShowInfo( const rcss::rcg::ShowInfoT & show )
     disp->show_ = show;
 
     M_disp = disp;
+    analyzeShow( show, M_analysis );
 
-    if ( Options::instance().bufferingMode() )
+    if ( isBuffering() )
     {
         if ( (int)M_disp_cont.size() <= Options::instance().maxDispBuffer() )
         {
+            if ( ! M_disp_cont.empty() )
+            {
+                const int events = detectEvents( *M_disp_cont.back(), *disp );
+                for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+                {
+                    if ( events & ( 1 << i ) )
+                    {
+                        M_event_index[i].push_back( M_disp_cont.size() );
+                    }
+                }
+            }
+
             M_disp_cont.push_back( disp );
+            M_analysis_cont.push_back( M_analysis );
+
+            if ( Options::instance().heatMapType() != Options::HEAT_MAP_NONE )
+            {
+                syncHeatMap();
+            }
         }
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  the heat map costs a snapshot of all players' counts every
+  HeatMap::SNAPSHOT_INTERVAL frames, so it is released while it is not
+  shown, and recorded again from the buffered data when it is enabled.
+ */
+void
+DispHolder::updateHeatMap()
+{
+    QWriteLocker lock( &M_lock );
+
+    if ( Options::instance().heatMapType() == Options::HEAT_MAP_NONE )
+    {
+        if ( M_heat_map.size() > 0 )
+        {
+            M_heat_map = HeatMap();
+            ++M_revision;
+        }
+        return;
+    }
+
+    syncHeatMap();
+    ++M_revision;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+DispHolder::isBuffering() const
+{
+    return ( M_buffering
+             && Options::instance().bufferingMode() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  record the buffered data that have not been recorded yet.
+  the caller must hold the write lock.
+ */
+void
+DispHolder::syncHeatMap()
+{
+    for ( size_t i = M_heat_map.size(); i < M_disp_cont.size(); ++i )
+    {
+        M_heat_map.add( M_disp_cont[i]->show_ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the last data is compared in the non-buffering mode.
+ */
+bool
+DispHolder::hasShow( const rcss::rcg::ShowInfoT & show ) const
+{
+    if ( ! isBuffering() )
+    {
+        return ( M_disp
+                 && same_show( M_disp->show_, show ) );
+    }
+
+    for ( DispCont::const_iterator it = std::lower_bound( M_disp_cont.begin(), M_disp_cont.end(),
+                                                          show.time_, TimeCmp() );
+          it != M_disp_cont.end() && (*it)->show_.time_ == show.time_;
+          ++it )
+    {
+        if ( same_show( (*it)->show_, show ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the late show is slotted into the buffer after the buffered data of
+  the same cycle. the current index is moved with the data it points,
+  and the events around the inserted data are detected again.
+  the insertion moves the following data, the event indices and the heat
+  map cells, so the show is inserted only within the last
+  LATE_SHOW_WINDOW data and the cost does not depend on the buffer size.
+ */
+void
+DispHolder::insertLateShow( const rcss::rcg::ShowInfoT & show )
+{
+    if ( ! isBuffering()
+         || (int)M_disp_cont.size() > Options::instance().maxDispBuffer() )
+    {
+        return;
+    }
+
+    const size_t window_begin = ( M_disp_cont.size() > LATE_SHOW_WINDOW
+                                  ? M_disp_cont.size() - LATE_SHOW_WINDOW
+                                  : 0 );
+    if ( window_begin > 0
+         && M_disp_cont[window_begin - 1]->show_.time_ > show.time_ )
+    {
+        // too old to be inserted
+        return;
+    }
+
+    size_t pos = std::lower_bound( M_disp_cont.begin() + window_begin, M_disp_cont.end(),
+                                   show.time_, TimeCmp() )
+        - M_disp_cont.begin();
+    while ( pos < M_disp_cont.size()
+            && M_disp_cont[pos]->show_.time_ == show.time_ )
+    {
+        ++pos;
+    }
+
+    // the playmode and the teams of the late show are not known.
+    // they are taken from the previous data, or the next one for the first data.
+    DispPtr disp( new rcss::rcg::DispInfoT );
+    if ( pos > 0 || ! M_disp_cont.empty() )
+    {
+        const rcss::rcg::DispInfoT & neighbor = *M_disp_cont[pos > 0 ? pos - 1 : 0];
+        disp->pmode_ = neighbor.pmode_;
+        disp->team_[0] = neighbor.team_[0];
+        disp->team_[1] = neighbor.team_[1];
+    }
+    else
+    {
+        disp->pmode_ = M_playmode;
+        disp->team_[0] = M_teams[0];
+        disp->team_[1] = M_teams[1];
+    }
+    disp->show_ = show;
+
+    DispAnalysis analysis;
+    analyzeShow( show, analysis );
+
+    const bool has_next = ( pos < M_disp_cont.size() );
+
+    for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+    {
+        std::vector< size_t > & index = M_event_index[i];
+        std::vector< size_t >::iterator it = std::lower_bound( index.begin(), index.end(), pos );
+
+        // the events of the next data have been detected against the previous data.
+        if ( has_next
+             && it != index.end()
+             && *it == pos )
+        {
+            it = index.erase( it );
+        }
+
+        for ( ; it != index.end(); ++it )
+        {
+            ++(*it);
+        }
+    }
+
+    M_disp_cont.insert( M_disp_cont.begin() + pos, disp );
+    M_analysis_cont.insert( M_analysis_cont.begin() + pos, analysis );
+    if ( pos <= M_heat_map.size() )
+    {
+        M_heat_map.insert( pos, show );
+    }
+
+    const int prev_events = ( pos > 0
+                              ? detectEvents( *M_disp_cont[pos - 1], *disp )
+                              : 0 );
+    const int next_events = ( has_next
+                              ? detectEvents( *disp, *M_disp_cont[pos + 1] )
+                              : 0 );
+    for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+    {
+        if ( prev_events & ( 1 << i ) )
+        {
+            insert_event_index( M_event_index[i], pos );
+        }
+
+        if ( next_events & ( 1 << i ) )
+        {
+            insert_event_index( M_event_index[i], pos + 1 );
+        }
+    }
+
+    if ( M_current_index != INVALID_INDEX
+         && pos <= M_current_index )
+    {
+        ++M_current_index;
+    }
+
+    ++M_revision;
+    ++M_buffer_revision;
+    M_shifted_indices.push_back( std::make_pair( M_buffer_revision, pos ) );
+    if ( M_shifted_indices.size() > MAX_SHIFT_HISTORY )
+    {
+        M_shifted_indices.pop_front();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DispHolder::printCycleStats() const
+{
+    if ( Options::instance().cycleStats()
+         && M_cycle_stats.received() > 0 )
+    {
+        std::cout << "cycle stats: ";
+        M_cycle_stats.print( std::cout ) << std::endl;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -322,6 +761,7 @@ DispHolder::doHandleMsgInfo( const int,
     if ( ! msg.compare( 0, std::strlen( "(team_graphic_" ), "(team_graphic_" ) )
     {
         analyzeTeamGraphic( msg );
+        ++M_revision;
         return;
     }
 
@@ -348,11 +788,13 @@ DispHolder::doHandlePlayMode( const int time,
              || pmode == rcss::rcg::PM_PenaltyMiss_Left )
         {
             M_penalty_scores_left.push_back( std::make_pair( time, pmode ) );
+            ++M_revision;
         }
         else if ( pmode == rcss::rcg::PM_PenaltyScore_Right
                   || pmode == rcss::rcg::PM_PenaltyMiss_Right )
         {
             M_penalty_scores_right.push_back( std::make_pair( time, pmode ) );
+            ++M_revision;
         }
     }
 
@@ -382,6 +824,7 @@ DispHolder::doHandleDrawClear( const int time )
     M_point_cont.erase( time );
     M_circle_cont.erase( time );
     M_line_cont.erase( time );
+    ++M_revision;
 
 //     {
 //         PointCont::iterator first = M_point_cont.lower_bound( 0 );
@@ -409,6 +852,7 @@ DispHolder::doHandleDrawPointInfo( const int time,
                                    const rcss::rcg::PointInfoT & point )
 {
     M_point_cont.insert( PointCont::value_type( time, point ) );
+    ++M_revision;
 }
 
 /*-------------------------------------------------------------------*/
@@ -419,8 +863,8 @@ DispHolder::doHandleDrawPointInfo( const int time,
  DispHolder::doHandleDrawCircleInfo( const int time,
                                      const rcss::rcg::CircleInfoT & circle )
  {
-     std::cerr << "doHandleDrawCircleInfo " << time << std::endl;
      M_circle_cont.insert( CircleCont::value_type( time, circle ) );
+     ++M_revision;
  }
 
 /*-------------------------------------------------------------------*/
@@ -432,6 +876,7 @@ DispHolder::doHandleDrawLineInfo( const int time,
                                   const rcss::rcg::LineInfoT & line )
 {
     M_line_cont.insert( LineCont::value_type( time, line ) );
+    ++M_revision;
 }
 
 /*-------------------------------------------------------------------*/
@@ -442,6 +887,7 @@ void
 DispHolder::doHandleServerParam( const rcss::rcg::ServerParamT & param )
 {
     M_server_param = param;
+    ++M_revision;
 }
 
 /*-------------------------------------------------------------------*/
@@ -452,6 +898,7 @@ void
 DispHolder::doHandlePlayerParam( const rcss::rcg::PlayerParamT & param )
 {
     M_player_param = param;
+    ++M_revision;
 }
 
 /*-------------------------------------------------------------------*/
@@ -462,6 +909,7 @@ void
 DispHolder::doHandlePlayerType( const rcss::rcg::PlayerTypeT & param )
 {
     M_player_types.insert( std::pair< int, rcss::rcg::PlayerTypeT >( param.id_, param ) );
+    ++M_revision;
 }
 
 /*-------------------------------------------------------------------*/
@@ -517,6 +965,228 @@ DispHolder::analyzeTeamGraphic( const std::string & msg )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  load the cached team graphic when the new team name appears, unless the
+  tiles have already been received.
+ */
+void
+DispHolder::loadTeamGraphicCache()
+{
+    if ( ! Options::instance().teamGraphicCache() )
+    {
+        return;
+    }
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        const std::string & name = M_teams[i].name_;
+
+        if ( name.empty()
+             || name == M_team_graphic_cache_name[i] )
+        {
+            continue;
+        }
+
+        M_team_graphic_cache_name[i] = name;
+
+        TeamGraphic & team_graphic = ( i == 0
+                                       ? M_team_graphic_left
+                                       : M_team_graphic_right );
+        if ( team_graphic.tiles().empty() )
+        {
+            team_graphic.load( Options::TEAM_GRAPHIC_CACHE_DIR, name );
+            ++M_revision;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DispHolder::saveTeamGraphicCache()
+{
+    if ( ! Options::instance().teamGraphicCache() )
+    {
+        return;
+    }
+
+    if ( ! M_teams[0].name_.empty() )
+    {
+        M_team_graphic_left.save( Options::TEAM_GRAPHIC_CACHE_DIR, M_teams[0].name_ );
+    }
+
+    if ( ! M_teams[1].name_.empty() )
+    {
+        M_team_graphic_right.save( Options::TEAM_GRAPHIC_CACHE_DIR, M_teams[1].name_ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DispHolder::analyzeShow( const rcss::rcg::ShowInfoT & show,
+                         DispAnalysis & result ) const
+{
+    const float ball_x = show.ball_.x_;
+    const float ball_y = show.ball_.y_;
+
+    result = DispAnalysis();
+
+    // the first and the second minimum x of the left team, and the first
+    // and the second maximum x of the right team. the second one is the
+    // offside line if it is behind the ball.
+    float min_x = 0.0f;
+    float offside_l = 0.0f;
+    float max_x = 0.0f;
+    float offside_r = 0.0f;
+
+    // the nearest players are searched within 200 meters from the ball.
+    result.nearest_dist2_[0] = result.nearest_dist2_[1] = 40000.0f;
+
+    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+    {
+        const rcss::rcg::PlayerT & p = show.player_[i];
+
+        if ( p.state_ == 0 )
+        {
+            continue;
+        }
+
+        const int t = ( i < rcss::rcg::MAX_PLAYER ? 0 : 1 );
+
+        const float dx = ball_x - p.x_;
+        const float dy = ball_y - p.y_;
+        const float d2 = dx * dx + dy * dy;
+        if ( d2 < result.nearest_dist2_[t] )
+        {
+            result.nearest_dist2_[t] = d2;
+            result.nearest_player_[t] = i;
+        }
+
+        if ( result.min_x_[t] > result.max_x_[t] )
+        {
+            result.min_x_[t] = result.max_x_[t] = p.x_;
+            result.min_y_[t] = result.max_y_[t] = p.y_;
+        }
+        else
+        {
+            result.min_x_[t] = std::min( result.min_x_[t], p.x_ );
+            result.min_y_[t] = std::min( result.min_y_[t], p.y_ );
+            result.max_x_[t] = std::max( result.max_x_[t], p.x_ );
+            result.max_y_[t] = std::max( result.max_y_[t], p.y_ );
+        }
+
+        if ( p.side_ == 'l' )
+        {
+            if ( p.x_ < offside_l )
+            {
+                if ( p.x_ < min_x )
+                {
+                    offside_l = min_x;
+                    min_x = p.x_;
+                }
+                else
+                {
+                    offside_l = p.x_;
+                }
+            }
+        }
+        else if ( p.side_ == 'r' )
+        {
+            if ( offside_r < p.x_ )
+            {
+                if ( max_x < p.x_ )
+                {
+                    offside_r = max_x;
+                    max_x = p.x_;
+                }
+                else
+                {
+                    offside_r = p.x_;
+                }
+            }
+        }
+    }
+
+    offside_l = std::min( offside_l, ball_x );
+    offside_l = std::max( offside_l, - float( Options::PITCH_HALF_LENGTH ) );
+    offside_r = std::max( offside_r, ball_x );
+    offside_r = std::min( offside_r, float( Options::PITCH_HALF_LENGTH ) );
+
+    result.offside_line_x_[0] = offside_l;
+    result.offside_line_x_[1] = offside_r;
+
+    // the ball owner candidate is the ball nearest player that can kick the ball.
+    const int nearest = result.nearestPlayer();
+    if ( nearest >= 0 )
+    {
+        const rcss::rcg::PlayerTypeT & ptype = playerType( show.player_[nearest].type_ );
+        const double kickable_area = ( ptype.player_size_
+                                       + ptype.kickable_margin_
+                                       + M_server_param.ball_size_ );
+        if ( result.nearest_dist2_[nearest < rcss::rcg::MAX_PLAYER ? 0 : 1]
+             <= kickable_area * kickable_area )
+        {
+            result.ball_owner_ = nearest;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  compare the new display data with the previous one.
+  \return bit flags of DispEventType
+ */
+int
+DispHolder::detectEvents( const rcss::rcg::DispInfoT & prev,
+                          const rcss::rcg::DispInfoT & disp ) const
+{
+    int events = 0;
+
+    if ( prev.team_[0].score_ != disp.team_[0].score_
+         || prev.team_[1].score_ != disp.team_[1].score_ )
+    {
+        events |= EVENT_SCORE;
+    }
+
+    if ( prev.pmode_ != disp.pmode_ )
+    {
+        events |= EVENT_PLAYMODE;
+
+        if ( disp.pmode_ == rcss::rcg::PM_PenaltyScore_Left
+             || disp.pmode_ == rcss::rcg::PM_PenaltyScore_Right
+             || disp.pmode_ == rcss::rcg::PM_PenaltyMiss_Left
+             || disp.pmode_ == rcss::rcg::PM_PenaltyMiss_Right )
+        {
+            events |= EVENT_PENALTY;
+        }
+    }
+
+    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+    {
+        // only the newly set flags are the events.
+        const rcss::rcg::Int32 flags
+            = disp.show_.player_[i].state_ & ~prev.show_.player_[i].state_;
+
+        if ( flags & ( rcss::rcg::YELLOW_CARD | rcss::rcg::RED_CARD ) )
+        {
+            events |= EVENT_CARD;
+        }
+
+        if ( flags & ( rcss::rcg::TACKLE_FAULT | rcss::rcg::FOUL_CHARGED ) )
+        {
+            events |= EVENT_FOUL;
+        }
+    }
+
+    return events;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -524,6 +1194,8 @@ DispHolder::analyzeTeamGraphic( const std::string & msg )
 bool
 DispHolder::setIndexFirst()
 {
+    QWriteLocker lock( &M_lock );
+
     if ( M_disp_cont.empty() )
     {
         M_current_index = INVALID_INDEX;
@@ -541,6 +1213,8 @@ DispHolder::setIndexFirst()
 bool
 DispHolder::setIndexLast()
 {
+    QWriteLocker lock( &M_lock );
+
     if ( M_disp_cont.empty() )
     {
         M_current_index = INVALID_INDEX;
@@ -558,6 +1232,8 @@ DispHolder::setIndexLast()
 bool
 DispHolder::setIndexStepBack()
 {
+    QWriteLocker lock( &M_lock );
+
     if ( M_disp_cont.empty() )
     {
         M_current_index = INVALID_INDEX;
@@ -586,6 +1262,8 @@ DispHolder::setIndexStepBack()
 bool
 DispHolder::setIndexStepForward()
 {
+    QWriteLocker lock( &M_lock );
+
     if ( M_disp_cont.empty() )
     {
         M_current_index = INVALID_INDEX;
@@ -615,6 +1293,8 @@ DispHolder::setIndexStepForward()
 bool
 DispHolder::setIndex( const size_t idx )
 {
+    QWriteLocker lock( &M_lock );
+
     if ( M_current_index == idx
          || idx == INVALID_INDEX
          || M_disp_cont.size() <= idx )
@@ -633,6 +1313,8 @@ DispHolder::setIndex( const size_t idx )
 bool
 DispHolder::setCycle( const int cycle )
 {
+    QWriteLocker lock( &M_lock );
+
     std::size_t idx = getIndex( cycle );
 
     if ( idx == M_current_index
@@ -664,3 +1346,122 @@ DispHolder::getIndex( const int cycle ) const
 
     return std::distance( M_disp_cont.begin(), it );
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+size_t
+DispHolder::firstShiftedIndex( const int revision ) const
+{
+    if ( revision == M_buffer_revision )
+    {
+        return M_disp_cont.size();
+    }
+
+    if ( M_shifted_indices.empty()
+         || M_shifted_indices.front().first > revision + 1 )
+    {
+        // cleared, or shifted more times than tracked
+        return 0;
+    }
+
+    size_t first = M_disp_cont.size();
+    for ( std::deque< std::pair< int, size_t > >::const_reverse_iterator it = M_shifted_indices.rbegin();
+          it != M_shifted_indices.rend() && it->first > revision;
+          ++it )
+    {
+        first = std::min( first, it->second );
+    }
+
+    return first;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+DispHolder::isGapAfter( const size_t idx ) const
+{
+    if ( idx == INVALID_INDEX
+         || idx + 1 >= M_disp_cont.size() )
+    {
+        return false;
+    }
+
+    return ( M_disp_cont[idx + 1]->show_.time_
+             > M_disp_cont[idx]->show_.time_ + 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+size_t
+DispHolder::prevEventIndex( const size_t idx,
+                            const int event_mask ) const
+{
+    size_t result = INVALID_INDEX;
+
+    for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+    {
+        if ( ! ( event_mask & ( 1 << i ) ) )
+        {
+            continue;
+        }
+
+        const std::vector< size_t > & index = M_event_index[i];
+        std::vector< size_t >::const_iterator it = std::lower_bound( index.begin(),
+                                                                     index.end(),
+                                                                     idx );
+        if ( it == index.begin() )
+        {
+            continue;
+        }
+
+        --it;
+        if ( result == INVALID_INDEX
+             || result < *it )
+        {
+            result = *it;
+        }
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+size_t
+DispHolder::nextEventIndex( const size_t idx,
+                            const int event_mask ) const
+{
+    size_t result = INVALID_INDEX;
+
+    for ( int i = 0; i < EVENT_TYPE_SIZE; ++i )
+    {
+        if ( ! ( event_mask & ( 1 << i ) ) )
+        {
+            continue;
+        }
+
+        const std::vector< size_t > & index = M_event_index[i];
+        std::vector< size_t >::const_iterator it = std::upper_bound( index.begin(),
+                                                                     index.end(),
+                                                                     idx );
+        if ( it == index.end() )
+        {
+            continue;
+        }
+
+        if ( *it < result )
+        {
+            result = *it;
+        }
+    }
+
+    return result;
+}
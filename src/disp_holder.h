@@ -33,15 +33,21 @@
 #ifndef RCSSMONITOR_DISP_HOLDER_H
 #define RCSSMONITOR_DISP_HOLDER_H
 
+#include "cycle_stats.h"
+#include "heat_map.h"
 #include "team_graphic.h"
 
+#include <QReadWriteLock>
+
 #include <rcsslogplayer/types.h>
 #include <rcsslogplayer/handler.h>
 
 #include <boost/shared_ptr.hpp>
 
 #include <vector>
+#include <deque>
 #include <map>
+#include <string>
 
 typedef boost::shared_ptr< rcss::rcg::DispInfoT > DispPtr;
 typedef boost::shared_ptr< const rcss::rcg::DispInfoT > DispConstPtr;
@@ -50,6 +56,58 @@ typedef std::multimap< int, rcss::rcg::PointInfoT > PointCont;
 typedef std::multimap< int, rcss::rcg::CircleInfoT > CircleCont;
 typedef std::multimap< int, rcss::rcg::LineInfoT > LineCont;
 
+/*!
+  \struct DispAnalysis
+  \brief derived data of one display data.
+  The values are computed only once when the display data is stored, and
+  painters refer them instead of scanning all players on every paint.
+*/
+struct DispAnalysis {
+    //! player index in ShowInfoT::player_ of the ball nearest player of each team. -1 if not found.
+    int nearest_player_[2];
+    //! squared distance from the ball to the nearest player of each team.
+    float nearest_dist2_[2];
+    //! player index of the ball owner candidate, the ball nearest kickable player. -1 if not found.
+    int ball_owner_;
+    //! x coordinate of the offside line of each team.
+    float offside_line_x_[2];
+    //! bounding box of the active players of each team. invalid if min_x_ > max_x_.
+    float min_x_[2];
+    float min_y_[2];
+    float max_x_[2];
+    float max_y_[2];
+
+    DispAnalysis();
+
+    /*!
+      \brief get the ball nearest player of both teams.
+      \return player index, or -1 if not found.
+     */
+    int nearestPlayer() const
+      {
+          if ( nearest_player_[1] < 0 ) return nearest_player_[0];
+          if ( nearest_player_[0] < 0 ) return nearest_player_[1];
+          return ( nearest_dist2_[0] <= nearest_dist2_[1]
+                   ? nearest_player_[0]
+                   : nearest_player_[1] );
+      }
+};
+
+typedef std::vector< DispAnalysis > DispAnalysisCont;
+
+/*!
+  \enum DispEventType
+  \brief kind of the indexed events. the values are used as bit flags.
+*/
+enum DispEventType {
+    EVENT_SCORE = 0x01, //!< score of either team has changed
+    EVENT_PLAYMODE = 0x02, //!< playmode has changed
+    EVENT_CARD = 0x04, //!< yellow or red card has been given
+    EVENT_PENALTY = 0x08, //!< penalty kick has been scored or missed
+    EVENT_FOUL = 0x10, //!< tackle fault or foul charge flag has been set
+    EVENT_ALL = 0x1f
+};
+
 class DispHolder
     : public rcss::rcg::Handler {
 public:
@@ -66,6 +124,8 @@ private:
 
     TeamGraphic M_team_graphic_left;
     TeamGraphic M_team_graphic_right;
+    //! team names already looked up in the team graphic cache
+    std::string M_team_graphic_cache_name[2];
 
     // the record of penalty score/miss, first: time, second: playmode
     std::vector< std::pair< int, rcss::rcg::PlayMode > > M_penalty_scores_left;
@@ -81,19 +141,89 @@ private:
     DispPtr M_disp; //! last handled display data
     DispCont M_disp_cont;
 
+    DispAnalysis M_analysis; //!< derived data of the last handled display data
+    DispAnalysisCont M_analysis_cont; //!< derived data of each buffered display data
+
+    HeatMap M_heat_map; //!< occupancy counts of the buffered display data. recorded only while shown.
+
+    //! the number of event types
+    static const int EVENT_TYPE_SIZE = 5;
+    //! sorted indices of the buffered display data where each type of event occurs
+    std::vector< size_t > M_event_index[EVENT_TYPE_SIZE];
+
     size_t M_current_index;
 
+    //! incremented when the data other than the appended display data are changed.
+    int M_revision;
+
+    //! incremented when the buffered display data are shifted by the late show, or cleared.
+    int M_buffer_revision;
+    //! first shifted index of the latest insertions. first: buffer revision, second: index
+    std::deque< std::pair< int, size_t > > M_shifted_indices;
+
+    //! if false, only the last display data is kept regardless of the buffering mode.
+    const bool M_buffering;
+
+    //! true while the display data is added from the live path. reset by clear().
+    bool M_live_input;
+    //! continuity of the show cycles received from the live path
+    CycleStats M_cycle_stats;
+
+    //! held for writing by the public modifiers, and for reading by the render worker.
+    mutable QReadWriteLock M_lock;
+
     // not used
     DispHolder( const DispHolder & );
     DispHolder operator=( const DispHolder & );
 
 public:
 
-    DispHolder();
+    /*!
+      \brief create the holder.
+      \param buffering if false, the display data are not buffered even in
+      the buffering mode, e.g. for the additional fields of the field wall.
+     */
+    explicit
+    DispHolder( const bool buffering = true );
     ~DispHolder();
 
+    /*!
+      \brief get the lock of the holder.
+      The other threads must hold the read lock while they access the holder.
+      The handler methods called by the parser are not locked by themselves.
+     */
+    QReadWriteLock & lock() const { return M_lock; }
+
     void clear();
 
+    /*!
+      \brief get the revision number of the holder.
+      The number is changed when the parameters, the team graphics, the
+      debug draw data, the penalty records or the buffered history are
+      modified. Appending a new display data does not change it.
+      \return revision number
+     */
+    int revision() const { return M_revision; }
+
+    /*!
+      \brief get the revision number of the buffered indices.
+      The number is changed when a late show is inserted in the middle of
+      the buffer and the following data are shifted, or when the buffer is
+      cleared.
+      \return buffer revision number
+     */
+    int bufferRevision() const { return M_buffer_revision; }
+
+    /*!
+      \brief get the first index shifted after the given buffer revision.
+      The caches keyed by the buffered index must drop their entries from
+      this index.
+      \param revision buffer revision of the caller's cache
+      \return the first shifted index. the size of the buffer if nothing
+      has been shifted, or 0 if the revision is too old to be tracked.
+     */
+    size_t firstShiftedIndex( const int revision ) const;
+
     const rcss::rcg::ServerParamT & serverParam() const { return M_server_param; }
     const rcss::rcg::PlayerParamT & playerParam() const { return M_player_param; }
     const std::map< int, rcss::rcg::PlayerTypeT > & playerTypes() const { return M_player_types; }
@@ -120,10 +250,30 @@ public:
     size_t currentIndex() const { return M_current_index; }
     DispConstPtr currentDisp() const;
     const DispCont & dispCont() const { return M_disp_cont; }
+    const DispAnalysis & currentAnalysis() const;
+    const HeatMap & heatMap() const { return M_heat_map; }
+
+    /*!
+      \brief record or release the heat map for the current heat map type.
+      must be called by the GUI thread when the heat map type is changed.
+     */
+    void updateHeatMap();
+    const CycleStats & cycleStats() const { return M_cycle_stats; }
+
+    /*!
+      \brief check if some cycles are missing between the buffered data and its next.
+      \param idx index of the buffered data
+      \return true if the next buffered data is not the next cycle.
+     */
+    bool isGapAfter( const size_t idx ) const;
 
     bool addDispInfoV1( const rcss::rcg::dispinfo_t & disp );
     bool addDispInfoV2( const rcss::rcg::dispinfo_t2 & disp );
     bool addDispInfoV3( const char * msg );
+    /*!
+      \brief add the already decoded display data, e.g. read from the frame ring.
+     */
+    bool addDispInfo( const rcss::rcg::DispInfoT & disp );
 
 protected:
     virtual
@@ -179,6 +329,17 @@ protected:
 
 private:
     void analyzeTeamGraphic( const std::string & msg );
+    void loadTeamGraphicCache();
+    void saveTeamGraphicCache();
+    void analyzeShow( const rcss::rcg::ShowInfoT & show,
+                      DispAnalysis & result ) const;
+    int detectEvents( const rcss::rcg::DispInfoT & prev,
+                      const rcss::rcg::DispInfoT & disp ) const;
+    bool isBuffering() const;
+    void syncHeatMap();
+    bool hasShow( const rcss::rcg::ShowInfoT & show ) const;
+    void insertLateShow( const rcss::rcg::ShowInfoT & show );
+    void printCycleStats() const;
 
 public:
 
@@ -190,6 +351,24 @@ public:
     bool setCycle( const int cycle );
     size_t getIndex( const int cycle ) const;
 
+    /*!
+      \brief get the last buffered index before the given index where the event occurs.
+      \param idx current index
+      \param event_mask bit flags of DispEventType
+      \return found index, or INVALID_INDEX if not found.
+     */
+    size_t prevEventIndex( const size_t idx,
+                           const int event_mask ) const;
+
+    /*!
+      \brief get the first buffered index after the given index where the event occurs.
+      \param idx current index
+      \param event_mask bit flags of DispEventType
+      \return found index, or INVALID_INDEX if not found.
+     */
+    size_t nextEventIndex( const size_t idx,
+                           const int event_mask ) const;
+
 
 };
 
@@ -38,8 +38,8 @@
 
 #include "draw_info_painter.h"
 
-#include "disp_holder.h"
-#include "options.h"
+#include "render_frame.h"
+#include "render_settings.h"
 
 #include <iostream>
 
@@ -47,8 +47,8 @@
 /*!
 
 */
-DrawInfoPainter::DrawInfoPainter( const DispHolder & disp_holder )
-    : M_disp_holder( disp_holder )
+DrawInfoPainter::DrawInfoPainter( const RenderFrame & frame )
+    : M_frame( frame )
     , M_pen( QColor( 255, 255, 255 ), 0, Qt::SolidLine )
 {
 
@@ -68,16 +68,15 @@ DrawInfoPainter::~DrawInfoPainter()
 
 */
 void
-DrawInfoPainter::draw( QPainter & painter )
+DrawInfoPainter::draw( QPainter & painter,
+                       const RenderSettings & settings )
 {
-    const Options & opt = Options::instance();
-
-    if ( ! opt.showDrawInfo() )
+    if ( ! settings.showDrawInfo() )
     {
         return;
     }
 
-    DispConstPtr disp = M_disp_holder.currentDisp();
+    DispConstPtr disp = M_frame.currentDisp();
 
     if ( ! disp )
     {
@@ -92,10 +91,10 @@ DrawInfoPainter::draw( QPainter & painter )
     // draw point
     //
     {
-        PointCont::const_iterator p = M_disp_holder.pointCont().find( current_time );
-        if ( p != M_disp_holder.pointCont().end() )
+        PointCont::const_iterator p = M_frame.pointCont().find( current_time );
+        if ( p != M_frame.pointCont().end() )
         {
-            const PointCont::const_iterator end = M_disp_holder.pointCont().upper_bound( current_time );
+            const PointCont::const_iterator end = M_frame.pointCont().upper_bound( current_time );
             do
             {
                 QColor col( p->second.color_.c_str() );
@@ -103,8 +102,8 @@ DrawInfoPainter::draw( QPainter & painter )
                 {
                     M_pen.setColor( col );
                     painter.setPen( M_pen );
-                    painter.drawRect( opt.screenX( p->second.x_ ) - 1,
-                                      opt.screenY( p->second.y_ ) - 1,
+                    painter.drawRect( settings.screenX( p->second.x_ ) - 1,
+                                      settings.screenY( p->second.y_ ) - 1,
                                       3, 3 );
                 }
                 ++p;
@@ -117,10 +116,10 @@ DrawInfoPainter::draw( QPainter & painter )
     // draw circle
     //
     {
-        CircleCont::const_iterator c = M_disp_holder.circleCont().find( current_time );
-        if ( c != M_disp_holder.circleCont().end() )
+        CircleCont::const_iterator c = M_frame.circleCont().find( current_time );
+        if ( c != M_frame.circleCont().end() )
         {
-            const CircleCont::const_iterator end = M_disp_holder.circleCont().upper_bound( current_time );
+            const CircleCont::const_iterator end = M_frame.circleCont().upper_bound( current_time );
             do
             {
                 QColor col( c->second.color_.c_str() );
@@ -129,9 +128,9 @@ DrawInfoPainter::draw( QPainter & painter )
                     M_pen.setColor( col );
                     painter.setPen( M_pen );
 
-                    int r = opt.scale( c->second.r_ );
-                    painter.drawEllipse( opt.screenX( c->second.x_ ) - r,
-                                         opt.screenY( c->second.y_ ) - r,
+                    int r = settings.scale( c->second.r_ );
+                    painter.drawEllipse( settings.screenX( c->second.x_ ) - r,
+                                         settings.screenY( c->second.y_ ) - r,
                                          r * 2,
                                          r * 2 );
                 }
@@ -146,10 +145,10 @@ DrawInfoPainter::draw( QPainter & painter )
     // draw line
     //
     {
-        LineCont::const_iterator l = M_disp_holder.lineCont().find( current_time );
-        if ( l != M_disp_holder.lineCont().end() )
+        LineCont::const_iterator l = M_frame.lineCont().find( current_time );
+        if ( l != M_frame.lineCont().end() )
         {
-            const LineCont::const_iterator end = M_disp_holder.lineCont().upper_bound( current_time );
+            const LineCont::const_iterator end = M_frame.lineCont().upper_bound( current_time );
             do
             {
                 QColor col( l->second.color_.c_str() );
@@ -158,10 +157,10 @@ DrawInfoPainter::draw( QPainter & painter )
                     M_pen.setColor( col );
                     painter.setPen( M_pen );
 
-                    painter.drawLine( opt.screenX( l->second.x1_ ),
-                                      opt.screenY( l->second.y1_ ),
-                                      opt.screenX( l->second.x2_ ),
-                                      opt.screenY( l->second.y2_ ) );
+                    painter.drawLine( settings.screenX( l->second.x1_ ),
+                                      settings.screenY( l->second.y1_ ),
+                                      settings.screenX( l->second.x2_ ),
+                                      settings.screenY( l->second.y2_ ) );
                 }
 
                 ++l;
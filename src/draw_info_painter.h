@@ -39,13 +39,13 @@
 #include <QBrush>
 #include <QFont>
 
-class DispHolder;
+class RenderFrame;
 
 class DrawInfoPainter
     : public PainterInterface {
 private:
 
-    const DispHolder & M_disp_holder;
+    const RenderFrame & M_frame;
 
     QPen M_pen;
 
@@ -56,10 +56,11 @@ private:
 public:
 
     explicit
-    DrawInfoPainter( const DispHolder & disp_holder );
+    DrawInfoPainter( const RenderFrame & frame );
     ~DrawInfoPainter();
 
-    void draw( QPainter & painter );
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
 
 };
 
@@ -39,13 +39,8 @@
 #include "field_canvas.h"
 
 #include "disp_holder.h"
-#include "field_painter.h"
-
-#include "ball_painter.h"
-#include "player_painter.h"
-#include "score_board_painter.h"
-#include "team_graphic_painter.h"
-#include "draw_info_painter.h"
+#include "render_settings.h"
+#include "render_worker.h"
 
 #include "options.h"
 
@@ -56,7 +51,8 @@
 /*!
 
 */
-FieldCanvas::FieldCanvas( DispHolder & disp_holder )
+FieldCanvas::FieldCanvas( DispHolder & disp_holder,
+                          const bool parallel_layers )
     :
 #ifdef USE_GLWIDGET
     QGLWidget( QGLFormat( QGL::SampleBuffers ) ),
@@ -64,7 +60,13 @@ FieldCanvas::FieldCanvas( DispHolder & disp_holder )
     QWidget( /* parent, flags */ ),
 #endif
     M_disp_holder( disp_holder ),
-    M_monitor_menu( static_cast< QMenu * >( 0 ) )
+    M_monitor_menu( static_cast< QMenu * >( 0 ) ),
+    M_render_worker( new RenderWorker( disp_holder, parallel_layers, this ) ),
+    M_requested_version( -1 ),
+    M_requested_revision( -1 ),
+    M_frame_dirty( false ),
+    M_render_settings_dirty( true ),
+    M_focus_tracking( true )
 {
     M_focus_move_mouse = &M_mouse_state[0];
     M_measure_mouse = &M_mouse_state[1];
@@ -73,7 +75,13 @@ FieldCanvas::FieldCanvas( DispHolder & disp_holder )
     this->setMouseTracking( true ); // need for the MouseMoveEvent
     this->setFocusPolicy( Qt::WheelFocus );
 
-    createPainters();
+    connect( M_render_worker, SIGNAL( rendered() ),
+             this, SLOT( receiveFrame() ) );
+
+    if ( M_render_worker->isThreaded() )
+    {
+        M_render_worker->start();
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -82,7 +90,7 @@ FieldCanvas::FieldCanvas( DispHolder & disp_holder )
 */
 FieldCanvas::~FieldCanvas()
 {
-
+    M_render_worker->stop();
 }
 
 /*-------------------------------------------------------------------*/
@@ -107,22 +115,6 @@ FieldCanvas::createPopupMenu()
 /*-------------------------------------------------------------------*/
 /*!
 
-*/
-void
-FieldCanvas::createPainters()
-{
-    M_field_painter = boost::shared_ptr< FieldPainter >( new FieldPainter( M_disp_holder ) );
-
-    M_painters.push_back( boost::shared_ptr< PainterInterface >( new ScoreBoardPainter( M_disp_holder ) ) );
-    M_painters.push_back( boost::shared_ptr< PainterInterface >( new TeamGraphicPainter( M_disp_holder ) ) );
-    M_painters.push_back( boost::shared_ptr< PainterInterface >( new PlayerPainter( M_disp_holder ) ) );
-    M_painters.push_back( boost::shared_ptr< PainterInterface >( new BallPainter( M_disp_holder ) ) );
-    M_painters.push_back( boost::shared_ptr< PainterInterface >( new DrawInfoPainter( M_disp_holder ) ) );
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
 */
 void
 FieldCanvas::mouseDoubleClickEvent( QMouseEvent * event )
@@ -277,11 +269,11 @@ FieldCanvas::contextMenuEvent( QContextMenuEvent * event )
 
 */
 void
-FieldCanvas::paintEvent( QPaintEvent * )
+FieldCanvas::paintEvent( QPaintEvent * event )
 {
     QPainter painter( this );
 
-    draw( painter );
+    draw( painter, event->rect() );
 
     if ( M_measure_mouse->isDragged() )
     {
@@ -308,35 +300,23 @@ FieldCanvas::updateFocus()
     // if auto select mode, update the ball nearest player
     if ( Options::instance().playerAutoSelect() )
     {
-        const rcss::rcg::ShowInfoT & show = disp->show_;
+        const DispAnalysis & analysis = M_disp_holder.currentAnalysis();
 
         Options::PlayerSelectType old_type = Options::instance().playerSelectType();
 
-        float min_dist2 = 40000.0f;
+        const int nearest = ( old_type == Options::SELECT_AUTO_LEFT
+                              ? analysis.nearest_player_[0]
+                              : old_type == Options::SELECT_AUTO_RIGHT
+                              ? analysis.nearest_player_[1]
+                              : analysis.nearestPlayer() );
 
         rcss::rcg::Side side = rcss::rcg::NEUTRAL;
         int unum = 0;
 
-        const int first = ( old_type == Options::SELECT_AUTO_RIGHT
-                            ? 11
-                            : 0 );
-        const int last = ( old_type == Options::SELECT_AUTO_LEFT
-                           ? 11
-                           : 22 );
-        for ( int i = first; i < last; ++i )
+        if ( nearest >= 0 )
         {
-            if ( show.player_[i].state_ != 0 )
-            {
-                float d2
-                    = std::pow( show.ball_.x_ - show.player_[i].x_, 2 )
-                    + std::pow( show.ball_.y_ - show.player_[i].y_, 2 );
-                if ( d2 < min_dist2 )
-                {
-                    min_dist2 = d2;
-                    side = show.player_[i].side();
-                    unum = show.player_[i].unum_;
-                }
-            }
+            side = disp->show_.player_[nearest].side();
+            unum = disp->show_.player_[nearest].unum_;
         }
 
         if ( unum != 0 )
@@ -378,29 +358,134 @@ FieldCanvas::updateFocus()
 
 */
 void
-FieldCanvas::draw( QPainter & painter )
+FieldCanvas::invalidateRenderSettings()
 {
-    updateFocus();
-    Options::instance().updateFieldSize( this->width(), this->height() );
+    M_render_settings_dirty = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  take a new snapshot if the options have been changed by the config
+  dialog, or the transform and the selection have been changed by the
+  canvas itself. the canvas without the focus tracking shows the whole
+  field in its own size and selects no player.
+*/
+void
+FieldCanvas::updateRenderSettings()
+{
+    const Options & opt = Options::instance();
+
+    QPoint field_center = opt.fieldCenter();
+    double field_scale = opt.fieldScale();
+    int selected_number = opt.selectedNumber();
+
+    if ( ! M_focus_tracking )
+    {
+        opt.getFittedTransform( this->width(), this->height(),
+                                field_center, field_scale );
+        selected_number = 0;
+    }
+
+    if ( M_render_settings
+         && ! M_render_settings_dirty
+         && M_render_settings->fieldCenter() == field_center
+         && M_render_settings->fieldScale() == field_scale
+         && M_render_settings->selectedNumber() == selected_number )
+    {
+        return;
+    }
+
+    const int version = ( M_render_settings
+                          ? M_render_settings->version() + 1
+                          : 0 );
+    M_render_settings = boost::shared_ptr< const RenderSettings >( new RenderSettings( opt, version,
+                                                                                       field_center,
+                                                                                       field_scale,
+                                                                                       selected_number ) );
+    M_render_settings_dirty = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
 
-    M_field_painter->draw( painter );
+*/
+void
+FieldCanvas::requestRender()
+{
+    const DispConstPtr disp = M_disp_holder.currentDisp();
 
-    if ( ! M_disp_holder.currentDisp() )
+    if ( disp == M_requested_disp
+         && M_render_settings->version() == M_requested_version
+         && M_disp_holder.revision() == M_requested_revision
+         && this->size() == M_requested_size )
     {
+        // the latest request is being rendered or has already been rendered.
         return;
     }
 
-    for ( std::vector< boost::shared_ptr< PainterInterface > >::iterator it = M_painters.begin();
-          it != M_painters.end();
-          ++it )
+    M_requested_disp = disp;
+    M_requested_version = M_render_settings->version();
+    M_requested_revision = M_disp_holder.revision();
+    M_requested_size = this->size();
+
+    M_render_worker->request( M_requested_size, M_render_settings );
+
+    if ( ! M_render_worker->isThreaded() )
     {
-        (*it)->draw( painter );
+        // already painted in this thread
+        M_frame_dirty = true;
     }
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+FieldCanvas::receiveFrame()
+{
+    M_frame_dirty = true;
+    this->update();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the field is painted by the render worker. only the exposed area of
+  the latest completed frame is drawn here, so the overlays on the
+  unchanged frame do not run the painters nor convert the image again.
+*/
+void
+FieldCanvas::draw( QPainter & painter,
+                   const QRect & rect )
+{
+    if ( M_focus_tracking )
+    {
+        updateFocus();
+        Options::instance().updateFieldSize( this->width(), this->height() );
+    }
+
+    updateRenderSettings();
+    requestRender();
+
+    if ( M_frame_dirty
+         && M_render_worker->copyFrontBuffer( M_frame ) )
+    {
+        M_frame_dirty = false;
+    }
+
+    if ( M_frame.isNull() )
+    {
+        painter.fillRect( rect, M_render_settings->fieldBrush() );
+        return;
+    }
+
+    const QRect area = rect & M_frame.rect();
+    painter.drawPixmap( area.topLeft(), M_frame, area );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 FieldCanvas::drawMouseMeasure( QPainter & painter )
@@ -41,16 +41,17 @@
 
 #include <QPen>
 #include <QFont>
+#include <QPixmap>
 
+#include "disp_holder.h"
 #include "mouse_state.h"
 
 #include <boost/shared_ptr.hpp>
 
 class QMenu;
 
-class DispHolder;
-class FieldPainter;
-class PainterInterface;
+class RenderSettings;
+class RenderWorker;
 
 class FieldCanvas
 		:
@@ -69,8 +70,31 @@ private:
 
     QMenu * M_monitor_menu;
 
-    boost::shared_ptr< FieldPainter > M_field_painter;
-    std::vector< boost::shared_ptr< PainterInterface > > M_painters;
+    //! paints the field in the background.
+    RenderWorker * M_render_worker;
+
+    //! display data of the last render request
+    DispConstPtr M_requested_disp;
+    //! settings version of the last render request
+    int M_requested_version;
+    //! holder revision of the last render request
+    int M_requested_revision;
+    //! image size of the last render request
+    QSize M_requested_size;
+
+    //! the last composited frame. the exposes and the overlays are drawn from this.
+    QPixmap M_frame;
+    //! true if the worker has completed a new frame after M_frame was copied.
+    bool M_frame_dirty;
+
+    //! view options passed to the painters. rebuilt only when the options are changed.
+    boost::shared_ptr< const RenderSettings > M_render_settings;
+    //! true if the options have been changed by the config dialog.
+    bool M_render_settings_dirty;
+
+    //! if false, the view options are not updated by this canvas, and the
+    //! whole field is shown in its own transform without the player selection.
+    bool M_focus_tracking;
 
     //! 0: left, 1: middle, 2: right
     MouseState M_mouse_state[3];
@@ -86,17 +110,27 @@ private:
 
 public:
 
-    explicit
-    FieldCanvas( DispHolder & disp_holder );
+    FieldCanvas( DispHolder & disp_holder,
+                 const bool parallel_layers );
     ~FieldCanvas();
 
     QMenu * createPopupMenu();
 
-private:
+    /*!
+      \brief set the focus tracking mode. the secondary canvases that
+      share the view options must not update them, and do not follow the
+      focus point, the zoom and the selection of the main canvas.
+     */
+    void setFocusTracking( const bool on )
+      {
+          M_focus_tracking = on;
+      }
 
-    void createPainters();
+private:
 
     void updateFocus();
+    void updateRenderSettings();
+    void requestRender();
 
 protected:
 
@@ -112,12 +146,19 @@ protected:
 
 private:
 
-    void draw( QPainter & painter );
+    void draw( QPainter & painter,
+               const QRect & rect );
     void drawMouseMeasure( QPainter & painter );
     void drawRecoveringState( QPainter & painter );
 
+private slots:
+
+    void receiveFrame();
+
 public slots:
 
+    void invalidateRenderSettings();
+
     void dropBall();
     void freeKickLeft();
     void freeKickRight();
@@ -37,13 +37,13 @@
 #include <QPen>
 #include <QBrush>
 
-class DispHolder;
+class RenderFrame;
 
 class FieldPainter
     : public PainterInterface {
 private:
 
-    DispHolder & M_disp_holder;
+    const RenderFrame & M_frame;
 
     // not used
     FieldPainter();
@@ -51,20 +51,28 @@ private:
     const FieldPainter & operator=( const FieldPainter & );
 public:
 
-    FieldPainter( DispHolder & disp_holder );
+    FieldPainter( const RenderFrame & frame );
     ~FieldPainter();
 
-    void draw( QPainter & painter );
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
 
 private:
 
-    void drawBackGround( QPainter & painter ) const;
-    void drawLines( QPainter & painter ) const;
-    void drawPenaltyAreaLines( QPainter & painter ) const;
-    void drawGoalAreaLines( QPainter & painter ) const;
-    void drawGoals( QPainter & painter ) const;
-    void drawFlags( QPainter & painter ) const;
-    void drawGrid( QPainter & painter ) const;
+    void drawBackGround( QPainter & painter,
+                         const RenderSettings & settings ) const;
+    void drawLines( QPainter & painter,
+                    const RenderSettings & settings ) const;
+    void drawPenaltyAreaLines( QPainter & painter,
+                               const RenderSettings & settings ) const;
+    void drawGoalAreaLines( QPainter & painter,
+                            const RenderSettings & settings ) const;
+    void drawGoals( QPainter & painter,
+                    const RenderSettings & settings ) const;
+    void drawFlags( QPainter & painter,
+                    const RenderSettings & settings ) const;
+    void drawGrid( QPainter & painter,
+                   const RenderSettings & settings ) const;
 };
 
 #endif
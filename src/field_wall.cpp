@@ -0,0 +1,369 @@
+// -*-c++-*-
+
+/*!
+  \file field_wall.cpp
+  \brief tiled field view class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "field_wall.h"
+
+#include "field_canvas.h"
+#include "frame_presenter.h"
+#include "monitor_client.h"
+#include "options.h"
+
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FieldWall::Field::Field( const std::string & host,
+                         const int port )
+    : host_( host ),
+      port_( port ),
+      disp_holder_( false ),
+      client_( static_cast< MonitorClient * >( 0 ) ),
+      canvas_( static_cast< FieldCanvas * >( 0 ) ),
+      updated_( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FieldWall::FieldWall( FieldCanvas * main_canvas,
+                      const std::string & servers,
+                      QWidget * parent )
+    : QWidget( parent ),
+      M_presenter( new FramePresenter( Options::instance().refreshRate(), this ) )
+{
+    parseServers( servers );
+
+    connect( M_presenter, SIGNAL( presentRequested() ),
+             this, SLOT( presentFields() ) );
+
+    const int count = fieldCount();
+    const int columns = static_cast< int >( std::ceil( std::sqrt( static_cast< double >( count ) ) ) );
+
+    QGridLayout * layout = new QGridLayout();
+    layout->setMargin( 0 );
+    layout->setSpacing( 2 );
+
+    layout->addWidget( main_canvas, 0, 0 );
+
+    for ( std::size_t i = 0; i < M_fields.size(); ++i )
+    {
+        Field & field = *M_fields[i];
+
+        field.canvas_ = new FieldCanvas( field.disp_holder_, false );
+        // the view options are updated only by the main canvas.
+        field.canvas_->setFocusTracking( false );
+
+        const int index = static_cast< int >( i ) + 1;
+        layout->addWidget( field.canvas_, index / columns, index % columns );
+    }
+
+    // all tiles have the same size, so that they can share the field scale.
+    for ( int c = 0; c < columns; ++c )
+    {
+        layout->setColumnStretch( c, 1 );
+    }
+    for ( int r = 0; r <= ( count - 1 ) / columns; ++r )
+    {
+        layout->setRowStretch( r, 1 );
+    }
+
+    this->setLayout( layout );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FieldWall::~FieldWall()
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        disconnectField( **it );
+        // the canvas must be deleted before the holder.
+        delete (*it)->canvas_;
+        (*it)->canvas_ = static_cast< FieldCanvas * >( 0 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::parseServers( const std::string & servers )
+{
+    std::istringstream istr( servers );
+    std::string item;
+
+    while ( std::getline( istr, item, ',' ) )
+    {
+        if ( item.empty() )
+        {
+            continue;
+        }
+
+        std::string host = item;
+        int port = Options::instance().serverPort();
+
+        const std::string::size_type colon = item.rfind( ':' );
+        if ( colon != std::string::npos )
+        {
+            host = item.substr( 0, colon );
+            port = std::atoi( item.substr( colon + 1 ).c_str() );
+        }
+
+        if ( host.empty()
+             || port <= 0 )
+        {
+            std::cerr << "Illegal wall server [" << item << "]" << std::endl;
+            continue;
+        }
+
+        M_fields.push_back( boost::shared_ptr< Field >( new Field( host, port ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::connectField( Field & field )
+{
+    if ( field.client_ )
+    {
+        return;
+    }
+
+    std::cerr << "Connect to [" << field.host_ << ':' << field.port_ << "] ..." << std::endl;
+
+    field.client_ = new MonitorClient( this,
+                                       field.disp_holder_,
+                                       field.host_.c_str(),
+                                       field.port_,
+                                       Options::instance().clientVersion() );
+
+    if ( ! field.client_->isConnected() )
+    {
+        std::cerr << "Connection to [" << field.host_ << ':' << field.port_ << "] failed."
+                  << std::endl;
+        delete field.client_;
+        field.client_ = static_cast< MonitorClient * >( 0 );
+        return;
+    }
+
+    field.disp_holder_.clear();
+
+    connect( field.client_, SIGNAL( received() ),
+             this, SLOT( receive() ) );
+    connect( field.client_, SIGNAL( disconnectRequested() ),
+             this, SLOT( handleDisconnectRequest() ) );
+    connect( field.client_, SIGNAL( reconnectRequested() ),
+             this, SLOT( handleReconnectRequest() ) );
+
+    field.client_->sendDispInit();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::disconnectField( Field & field )
+{
+    if ( ! field.client_ )
+    {
+        return;
+    }
+
+    field.client_->disconnect();
+
+    // the signals may be emitted in the client's own slot.
+    field.client_->deleteLater();
+    field.client_ = static_cast< MonitorClient * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FieldWall::Field *
+FieldWall::findField( const QObject * client )
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        if ( (*it)->client_ == client )
+        {
+            return it->get();
+        }
+    }
+
+    return static_cast< Field * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::connectFields()
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        connectField( **it );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::updateFields()
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        (*it)->canvas_->update();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::invalidateRenderSettings()
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        (*it)->canvas_->invalidateRenderSettings();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the additional fields are always shown live.
+*/
+void
+FieldWall::receive()
+{
+    Field * field = findField( sender() );
+    if ( ! field )
+    {
+        return;
+    }
+
+    field->updated_ = true;
+    M_presenter->post();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::presentFields()
+{
+    for ( std::vector< boost::shared_ptr< Field > >::iterator it = M_fields.begin();
+          it != M_fields.end();
+          ++it )
+    {
+        if ( (*it)->updated_ )
+        {
+            (*it)->updated_ = false;
+            (*it)->disp_holder_.setIndexLast();
+            (*it)->canvas_->update();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::handleDisconnectRequest()
+{
+    Field * field = findField( sender() );
+    if ( ! field )
+    {
+        return;
+    }
+
+    std::cerr << "Disconnect from [" << field->host_ << ':' << field->port_ << "]"
+              << std::endl;
+    disconnectField( *field );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldWall::handleReconnectRequest()
+{
+    Field * field = findField( sender() );
+    if ( ! field )
+    {
+        return;
+    }
+
+    disconnectField( *field );
+
+    std::cerr << "Trying to reconnect ..." << std::endl;
+    QTimer::singleShot( 1 * 1000,
+                        this, SLOT( connectFields() ) );
+}
@@ -0,0 +1,141 @@
+// -*-c++-*-
+
+/*!
+  \file field_wall.h
+  \brief tiled field view class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_FIELD_WALL_H
+#define RCSSMONITOR_FIELD_WALL_H
+
+#include <QWidget>
+
+#include "disp_holder.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+#include <string>
+
+class FieldCanvas;
+class FramePresenter;
+class MonitorClient;
+
+/*!
+  \class FieldWall
+  \brief tiled view of several fields monitored by one process.
+
+  The first tile is the canvas of the main window, which keeps the log
+  player, the menus and the referee commands. Each additional tile has
+  its own display data holder, monitor client and canvas. The holder of
+  a tile keeps only the latest frame, and the tile shows the whole field
+  without the focus, zoom and selection of the main canvas. All sockets
+  are serviced by the event loop of the GUI thread, and the canvases
+  share the view options and the player glyphs. Each canvas paints in its own render worker
+  without the per layer threads, so the render threads are bounded by
+  the number of the fields. The updated tiles are repainted together at
+  most once per display refresh.
+*/
+class FieldWall
+    : public QWidget {
+
+    Q_OBJECT
+
+private:
+
+    /*!
+      \struct Field
+      \brief data set of one additional field.
+     */
+    struct Field {
+        std::string host_;
+        int port_;
+        DispHolder disp_holder_;
+        MonitorClient * client_;
+        FieldCanvas * canvas_;
+        //! true if a new frame has been received since the last repaint
+        bool updated_;
+
+        Field( const std::string & host,
+               const int port );
+    };
+
+    std::vector< boost::shared_ptr< Field > > M_fields;
+
+    FramePresenter * M_presenter;
+
+    // not used
+    FieldWall();
+    FieldWall( const FieldWall & );
+    const FieldWall & operator=( const FieldWall & );
+
+public:
+
+    /*!
+      \brief create the tiles.
+      \param main_canvas the canvas shown in the first tile.
+      \param servers comma separated "host[:port]" list of the additional servers.
+      \param parent parent widget
+     */
+    FieldWall( FieldCanvas * main_canvas,
+               const std::string & servers,
+               QWidget * parent = 0 );
+    ~FieldWall();
+
+    /*!
+      \brief get the number of the tiles including the main canvas.
+     */
+    int fieldCount() const
+      {
+          return static_cast< int >( M_fields.size() ) + 1;
+      }
+
+private:
+
+    void parseServers( const std::string & servers );
+    void connectField( Field & field );
+    void disconnectField( Field & field );
+
+    Field * findField( const QObject * client );
+
+public slots:
+
+    void connectFields();
+    void updateFields();
+    void invalidateRenderSettings();
+
+private slots:
+
+    void receive();
+    void presentFields();
+    void handleDisconnectRequest();
+    void handleReconnectRequest();
+
+};
+
+#endif
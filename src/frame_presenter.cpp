@@ -0,0 +1,133 @@
+// -*-c++-*-
+
+/*!
+  \file frame_presenter.cpp
+  \brief live frame presenter class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QTimer>
+
+#include "frame_presenter.h"
+
+#include <algorithm>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FramePresenter::FramePresenter( const int refresh_rate,
+                                QObject * parent )
+    : QObject( parent ),
+      M_timer( new QTimer( this ) ),
+      M_interval( refresh_rate > 0 ? 1000 / refresh_rate : 0 ),
+      M_pending( false ),
+      M_presented( 0 ),
+      M_coalesced( 0 )
+{
+    M_timer->setSingleShot( true );
+
+    connect( M_timer, SIGNAL( timeout() ),
+             this, SLOT( present() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FramePresenter::~FramePresenter()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FramePresenter::clear()
+{
+    M_timer->stop();
+    M_last_time = QTime();
+    M_pending = false;
+    M_presented = 0;
+    M_coalesced = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FramePresenter::stop()
+{
+    M_timer->stop();
+    M_pending = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the zero timeout is still delivered after the pending datagrams are
+  handled, so the frames received in one batch are merged.
+*/
+void
+FramePresenter::post()
+{
+    if ( M_pending )
+    {
+        ++M_coalesced;
+        return;
+    }
+
+    M_pending = true;
+
+    int wait = 0;
+    if ( ! M_last_time.isNull() )
+    {
+        wait = std::max( 0, M_interval - M_last_time.elapsed() );
+    }
+
+    M_timer->start( wait );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FramePresenter::present()
+{
+    M_pending = false;
+    M_last_time.start();
+    ++M_presented;
+
+    emit presentRequested();
+}
@@ -0,0 +1,112 @@
+// -*-c++-*-
+
+/*!
+  \file frame_presenter.h
+  \brief live frame presenter class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_FRAME_PRESENTER_H
+#define RCSSMONITOR_FRAME_PRESENTER_H
+
+#include <QObject>
+#include <QTime>
+
+class QTimer;
+
+/*!
+  \class FramePresenter
+  \brief paces the live repaints to the display refresh rate.
+
+  The received frames are posted to the presenter, and the presenter
+  requests the repaint at most once per refresh interval. The frames
+  posted while a repaint is pending are coalesced, so the newest frame is
+  always shown and the frames that would never be displayed are not
+  painted.
+*/
+class FramePresenter
+    : public QObject {
+
+    Q_OBJECT
+
+private:
+
+    QTimer * M_timer;
+    //! elapsed time since the last presentation. null before the first one.
+    QTime M_last_time;
+    //! refresh interval [ms]
+    int M_interval;
+    //! true if a presentation has been scheduled
+    bool M_pending;
+
+    long M_presented; //!< the number of the presentations
+    long M_coalesced; //!< the number of the frames merged into the pending presentation
+
+    // not used
+    FramePresenter();
+    FramePresenter( const FramePresenter & );
+    const FramePresenter & operator=( const FramePresenter & );
+
+public:
+
+    /*!
+      \brief create the presenter.
+      \param refresh_rate display refresh rate [Hz]. 0 means no pacing.
+      \param parent parent object
+     */
+    FramePresenter( const int refresh_rate,
+                    QObject * parent );
+    ~FramePresenter();
+
+    void clear();
+
+    /*!
+      \brief cancel the pending presentation. the counters are kept.
+     */
+    void stop();
+
+    long presentedCount() const { return M_presented; }
+    long coalescedCount() const { return M_coalesced; }
+
+public slots:
+
+    /*!
+      \brief notify that a new frame has been received.
+     */
+    void post();
+
+private slots:
+
+    void present();
+
+signals:
+
+    void presentRequested();
+
+};
+
+#endif
@@ -0,0 +1,267 @@
+// -*-c++-*-
+
+/*!
+  \file frame_producer.cpp
+  \brief stand-in producer that feeds the frame ring from a game log.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "frame_ring.h"
+
+#include <rcsslogplayer/gzfstream.h>
+#include <rcsslogplayer/handler.h>
+#include <rcsslogplayer/parser.h>
+#include <rcsslogplayer/types.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+using namespace rcss::rcg;
+
+namespace {
+
+//! set by the signal handler to remove the shared memory before exit.
+volatile std::sig_atomic_t g_stop = 0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+extern "C"
+void
+handle_signal( int )
+{
+    g_stop = 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+sleep_msec( const int msec )
+{
+    if ( msec <= 0 )
+    {
+        return;
+    }
+
+    struct timespec req;
+    req.tv_sec = msec / 1000;
+    req.tv_nsec = ( msec % 1000 ) * 1000 * 1000;
+    ::nanosleep( &req, 0 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief handler that writes each show data into the frame ring.
+ */
+class RingFeeder
+    : public Handler {
+private:
+    FrameRing & M_ring;
+    const int M_interval;
+
+    int M_log_version;
+    PlayMode M_playmode;
+    TeamT M_teams[2];
+    long M_count;
+
+public:
+    RingFeeder( FrameRing & ring,
+                const int interval )
+        : M_ring( ring )
+        , M_interval( interval )
+        , M_log_version( 0 )
+        , M_playmode( PM_Null )
+        , M_count( 0 )
+      { }
+
+    long count() const { return M_count; }
+
+protected:
+    void doHandleLogVersion( int ver ) { M_log_version = ver; }
+    int doGetLogVersion() const { return M_log_version; }
+
+    void doHandleShowInfo( const ShowInfoT & show )
+      {
+          if ( g_stop )
+          {
+              return;
+          }
+
+          DispInfoT disp;
+          disp.pmode_ = M_playmode;
+          disp.team_[0] = M_teams[0];
+          disp.team_[1] = M_teams[1];
+          disp.show_ = show;
+
+          M_ring.write( disp );
+          ++M_count;
+
+          sleep_msec( M_interval );
+      }
+
+    void doHandlePlayMode( const int, const PlayMode pmode ) { M_playmode = pmode; }
+    void doHandleTeamInfo( const int, const TeamT & team_l, const TeamT & team_r )
+      {
+          M_teams[0] = team_l;
+          M_teams[1] = team_r;
+      }
+
+    // the other data is not transported by the ring.
+    void doHandleMsgInfo( const int, const int, const std::string & ) { }
+    void doHandleDrawClear( const int ) { }
+    void doHandleDrawPointInfo( const int, const PointInfoT & ) { }
+    void doHandleDrawCircleInfo( const int, const CircleInfoT & ) { }
+    void doHandleDrawLineInfo( const int, const LineInfoT & ) { }
+    void doHandleServerParam( const ServerParamT & ) { }
+    void doHandlePlayerParam( const PlayerParamT & ) { }
+    void doHandlePlayerType( const PlayerTypeT & ) { }
+    void doHandleEOF() { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char ** argv )
+{
+    std::string name = "/rcssmonitor";
+    int capacity = 64;
+    int interval = 100;
+    bool loop = false;
+    std::string path;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--name" ) && i + 1 < argc )
+        {
+            name = argv[++i];
+        }
+        else if ( ! std::strcmp( argv[i], "--capacity" ) && i + 1 < argc )
+        {
+            capacity = std::atoi( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--interval" ) && i + 1 < argc )
+        {
+            interval = std::atoi( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--loop" ) )
+        {
+            loop = true;
+        }
+        else if ( argv[i][0] != '-'
+                  && path.empty() )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            std::cout << "Usage: " << argv[0] << " [--name NAME] [--capacity N] [--interval MSEC] [--loop] GameLogFile\n"
+                      << "  --name NAME      shared memory object name. (default /rcssmonitor)\n"
+                      << "  --capacity N     the number of frames kept in the ring. (default 64)\n"
+                      << "  --interval MSEC  wait period after each frame. (default 100)\n"
+                      << "  --loop           replay the game log repeatedly."
+                      << std::endl;
+            return ( ! std::strcmp( argv[i], "--help" ) ? 0 : 1 );
+        }
+    }
+
+    if ( path.empty() )
+    {
+        std::cerr << "No game log file." << std::endl;
+        return 1;
+    }
+
+    if ( capacity <= 0 || interval < 0 )
+    {
+        std::cerr << "Illegal capacity or interval." << std::endl;
+        return 1;
+    }
+
+    FrameRing ring;
+    if ( ! ring.create( name, capacity ) )
+    {
+        return 1;
+    }
+
+    std::signal( SIGINT, handle_signal );
+    std::signal( SIGTERM, handle_signal );
+
+    std::cerr << "Writing frames to [" << name << "] ..." << std::endl;
+
+    RingFeeder feeder( ring, interval );
+
+    do
+    {
+        boost::shared_ptr< std::istream > is;
+        if ( path.size() > 3
+             && path.compare( path.size() - 3, 3, ".gz" ) == 0 )
+        {
+            is = boost::shared_ptr< std::istream >( new rcss::gzifstream( path.c_str() ) );
+        }
+        else
+        {
+            is = boost::shared_ptr< std::istream >( new std::ifstream( path.c_str(),
+                                                                       std::ios_base::in
+                                                                       | std::ios_base::binary ) );
+        }
+
+        if ( ! is->good() )
+        {
+            std::cerr << "Failed to open the game log [" << path << "]" << std::endl;
+            return 1;
+        }
+
+        Parser parser( feeder );
+        while ( ! g_stop
+                && parser.parse( *is ) )
+        {
+
+        }
+    }
+    while ( loop && ! g_stop );
+
+    std::cerr << "Wrote " << feeder.count() << " frames." << std::endl;
+
+    return 0;
+}
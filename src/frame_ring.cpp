@@ -0,0 +1,382 @@
+// -*-c++-*-
+
+/*!
+  \file frame_ring.cpp
+  \brief shared memory frame ring class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "frame_ring.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+namespace {
+
+const rcss::rcg::UInt32 FRAME_RING_MAGIC = 0x52435346; // "RCSF"
+const rcss::rcg::UInt32 FRAME_RING_VERSION = 1;
+
+/*-------------------------------------------------------------------*/
+/*!
+  full memory barrier between the slot sequence number and its data.
+*/
+inline
+void
+memory_barrier()
+{
+#if defined(__GNUC__)
+    __sync_synchronize();
+#endif
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FrameRing::FrameRing()
+    : M_owner( false ),
+      M_fd( -1 ),
+      M_memory( static_cast< void * >( 0 ) ),
+      M_size( 0 ),
+      M_header( static_cast< FrameRingHeader * >( 0 ) ),
+      M_slots( static_cast< FrameRingSlot * >( 0 ) ),
+      M_read_seq( 0 ),
+      M_producer_id( 0 ),
+      M_dropped_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FrameRing::~FrameRing()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FrameRing::create( const std::string & name,
+                   const std::size_t capacity )
+{
+    close();
+
+#ifdef HAVE_SYS_MMAN_H
+    if ( capacity == 0 )
+    {
+        std::cerr << "FrameRing. illegal capacity " << capacity << std::endl;
+        return false;
+    }
+
+    // remove the object left by the crashed producer.
+    ::shm_unlink( name.c_str() );
+
+    M_fd = ::shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644 );
+    if ( M_fd == -1 )
+    {
+        std::cerr << "FrameRing. failed to create the shared memory [" << name << "] "
+                  << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    M_name = name;
+    M_owner = true;
+    M_size = sizeof( FrameRingHeader ) + sizeof( FrameRingSlot ) * capacity;
+
+    if ( ::ftruncate( M_fd, static_cast< off_t >( M_size ) ) == -1 )
+    {
+        std::cerr << "FrameRing. failed to resize the shared memory [" << name << "] "
+                  << std::strerror( errno ) << std::endl;
+        close();
+        return false;
+    }
+
+    M_memory = ::mmap( 0, M_size, PROT_READ | PROT_WRITE, MAP_SHARED, M_fd, 0 );
+    if ( M_memory == MAP_FAILED )
+    {
+        std::cerr << "FrameRing. failed to map the shared memory [" << name << "] "
+                  << std::strerror( errno ) << std::endl;
+        M_memory = static_cast< void * >( 0 );
+        close();
+        return false;
+    }
+
+    std::memset( M_memory, 0, M_size );
+
+    M_header = static_cast< FrameRingHeader * >( M_memory );
+    M_slots = reinterpret_cast< FrameRingSlot * >( M_header + 1 );
+
+    M_header->version_ = FRAME_RING_VERSION;
+    M_header->capacity_ = static_cast< rcss::rcg::UInt32 >( capacity );
+    M_header->slot_size_ = sizeof( FrameRingSlot );
+    M_header->producer_id_ = static_cast< rcss::rcg::UInt32 >( ::getpid() );
+    M_header->write_seq_ = 0;
+
+    // the readers accept the header only after the magic number is written.
+    memory_barrier();
+    M_header->magic_ = FRAME_RING_MAGIC;
+
+    return true;
+#else
+    (void)capacity;
+    std::cerr << "FrameRing. shared memory is not supported. [" << name << "]" << std::endl;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FrameRing::open( const std::string & name )
+{
+    close();
+
+#ifdef HAVE_SYS_MMAN_H
+    M_fd = ::shm_open( name.c_str(), O_RDONLY, 0 );
+    if ( M_fd == -1 )
+    {
+        std::cerr << "FrameRing. failed to open the shared memory [" << name << "] "
+                  << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    M_name = name;
+
+    struct stat st;
+    if ( ::fstat( M_fd, &st ) == -1
+         || static_cast< std::size_t >( st.st_size ) < sizeof( FrameRingHeader ) )
+    {
+        std::cerr << "FrameRing. illegal shared memory size [" << name << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    M_size = static_cast< std::size_t >( st.st_size );
+
+    M_memory = ::mmap( 0, M_size, PROT_READ, MAP_SHARED, M_fd, 0 );
+    if ( M_memory == MAP_FAILED )
+    {
+        std::cerr << "FrameRing. failed to map the shared memory [" << name << "] "
+                  << std::strerror( errno ) << std::endl;
+        M_memory = static_cast< void * >( 0 );
+        close();
+        return false;
+    }
+
+    FrameRingHeader * header = static_cast< FrameRingHeader * >( M_memory );
+    memory_barrier();
+
+    if ( header->magic_ != FRAME_RING_MAGIC
+         || header->version_ != FRAME_RING_VERSION
+         || header->slot_size_ != static_cast< rcss::rcg::UInt32 >( sizeof( FrameRingSlot ) )
+         || header->capacity_ <= 0
+         || M_size < sizeof( FrameRingHeader ) + sizeof( FrameRingSlot ) * header->capacity_ )
+    {
+        std::cerr << "FrameRing. unsupported shared memory layout [" << name << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    M_header = header;
+    M_slots = reinterpret_cast< FrameRingSlot * >( M_header + 1 );
+
+    // start from the latest frame.
+    M_producer_id = M_header->producer_id_;
+    M_read_seq = std::max( static_cast< rcss::rcg::UInt32 >( 0 ), M_header->write_seq_ - 1 );
+    M_dropped_count = 0;
+
+    return true;
+#else
+    std::cerr << "FrameRing. shared memory is not supported. [" << name << "]" << std::endl;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FrameRing::close()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if ( M_memory )
+    {
+        ::munmap( M_memory, M_size );
+    }
+
+    if ( M_fd != -1 )
+    {
+        ::close( M_fd );
+    }
+
+    if ( M_owner )
+    {
+        ::shm_unlink( M_name.c_str() );
+    }
+#endif
+
+    M_owner = false;
+    M_fd = -1;
+    M_memory = static_cast< void * >( 0 );
+    M_size = 0;
+    M_header = static_cast< FrameRingHeader * >( 0 );
+    M_slots = static_cast< FrameRingSlot * >( 0 );
+    M_read_seq = 0;
+    M_producer_id = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FrameRing::write( const rcss::rcg::DispInfoT & disp )
+{
+    if ( ! M_owner
+         || ! M_header )
+    {
+        return;
+    }
+
+    const rcss::rcg::UInt32 seq = M_header->write_seq_ + 1;
+    FrameRingSlot & slot = M_slots[seq % M_header->capacity_];
+
+    slot.seq_ = 0;
+    memory_barrier();
+
+    slot.pmode_ = static_cast< rcss::rcg::Int32 >( disp.pmode_ );
+    for ( int i = 0; i < 2; ++i )
+    {
+        FrameRingTeam & team = slot.team_[i];
+        std::memset( team.name_, 0, FrameRingTeam::NAME_SIZE );
+        disp.team_[i].name_.copy( team.name_, FrameRingTeam::NAME_SIZE - 1 );
+        team.score_ = disp.team_[i].score_;
+        team.pen_score_ = disp.team_[i].pen_score_;
+        team.pen_miss_ = disp.team_[i].pen_miss_;
+    }
+    slot.show_ = disp.show_;
+
+    memory_barrier();
+    slot.seq_ = seq;
+    memory_barrier();
+    M_header->write_seq_ = seq;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FrameRing::read( rcss::rcg::DispInfoT & disp )
+{
+    if ( ! M_header )
+    {
+        return false;
+    }
+
+    if ( M_header->producer_id_ != M_producer_id )
+    {
+        // the producer has been restarted.
+        M_producer_id = M_header->producer_id_;
+        M_read_seq = 0;
+    }
+
+    const rcss::rcg::UInt32 write_seq = M_header->write_seq_;
+    const rcss::rcg::UInt32 capacity = M_header->capacity_;
+    memory_barrier();
+
+    while ( M_read_seq < write_seq )
+    {
+        rcss::rcg::UInt32 seq = M_read_seq + 1;
+
+        if ( write_seq - seq >= capacity )
+        {
+            // the older slots have been overwritten.
+            const rcss::rcg::UInt32 oldest = write_seq - capacity + 1;
+            M_dropped_count += oldest - seq;
+            seq = oldest;
+        }
+
+        const FrameRingSlot & slot = M_slots[seq % capacity];
+
+        const rcss::rcg::UInt32 before = slot.seq_;
+        memory_barrier();
+
+        disp.pmode_ = static_cast< rcss::rcg::PlayMode >( slot.pmode_ );
+        for ( int i = 0; i < 2; ++i )
+        {
+            const FrameRingTeam & team = slot.team_[i];
+            disp.team_[i].name_.assign( team.name_,
+                                        std::find( team.name_,
+                                                   team.name_ + FrameRingTeam::NAME_SIZE - 1,
+                                                   '\0' ) );
+            disp.team_[i].score_ = team.score_;
+            disp.team_[i].pen_score_ = team.pen_score_;
+            disp.team_[i].pen_miss_ = team.pen_miss_;
+        }
+        disp.show_ = slot.show_;
+
+        memory_barrier();
+        const rcss::rcg::UInt32 after = slot.seq_;
+
+        M_read_seq = seq;
+
+        if ( before == seq
+             && after == seq )
+        {
+            return true;
+        }
+
+        // the slot has been overwritten while copying.
+        ++M_dropped_count;
+    }
+
+    return false;
+}
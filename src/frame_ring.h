@@ -0,0 +1,177 @@
+// -*-c++-*-
+
+/*!
+  \file frame_ring.h
+  \brief shared memory frame ring class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_FRAME_RING_H
+#define RCSSMONITOR_FRAME_RING_H
+
+#include <rcsslogplayer/types.h>
+
+#include <string>
+#include <cstddef>
+
+/*!
+  \struct FrameRingTeam
+  \brief fixed size team information stored in the shared memory.
+*/
+struct FrameRingTeam {
+    enum {
+        NAME_SIZE = 32
+    };
+
+    char name_[NAME_SIZE]; //!< null terminated team name
+    rcss::rcg::UInt16 score_;
+    rcss::rcg::UInt16 pen_score_;
+    rcss::rcg::UInt16 pen_miss_;
+};
+
+/*!
+  \struct FrameRingSlot
+  \brief one decoded frame stored in the shared memory.
+*/
+struct FrameRingSlot {
+    //! sequence number of the stored frame. 0 while the producer writes the slot.
+    volatile rcss::rcg::UInt32 seq_;
+    rcss::rcg::Int32 pmode_;
+    FrameRingTeam team_[2];
+    rcss::rcg::ShowInfoT show_;
+};
+
+/*!
+  \struct FrameRingHeader
+  \brief header placed at the top of the shared memory.
+*/
+struct FrameRingHeader {
+    rcss::rcg::UInt32 magic_;
+    rcss::rcg::UInt32 version_; //!< layout version
+    rcss::rcg::UInt32 capacity_; //!< the number of slots
+    rcss::rcg::UInt32 slot_size_; //!< sizeof( FrameRingSlot ) of the producer
+    rcss::rcg::UInt32 producer_id_; //!< changed when the producer creates the ring again
+    //! sequence number of the last completed frame. the first frame is 1.
+    volatile rcss::rcg::UInt32 write_seq_;
+};
+
+/*!
+  \class FrameRing
+  \brief single producer ring of the decoded frames in POSIX shared memory.
+
+  The producer copies each frame into the slot of its sequence number,
+  and publishes the sequence number after the copy. The readers map the
+  memory read only, and validate the slot sequence number before and
+  after copying the frame, so the producer never waits for the readers.
+  A reader that falls behind more than the ring capacity skips to the
+  oldest available frame and counts the skipped frames as dropped.
+*/
+class FrameRing {
+private:
+
+    std::string M_name;
+    bool M_owner; //!< true if this object has created the shared memory.
+
+    int M_fd;
+    void * M_memory;
+    std::size_t M_size;
+
+    FrameRingHeader * M_header;
+    FrameRingSlot * M_slots;
+
+    //! sequence number of the last read frame
+    rcss::rcg::UInt32 M_read_seq;
+    //! producer id of the last read frame
+    rcss::rcg::UInt32 M_producer_id;
+    //! the number of the frames overwritten before they were read
+    unsigned long M_dropped_count;
+
+    // not used
+    FrameRing( const FrameRing & );
+    const FrameRing & operator=( const FrameRing & );
+
+public:
+
+    FrameRing();
+    ~FrameRing();
+
+    /*!
+      \brief create the shared memory as the producer.
+      \param name shared memory object name, e.g. "/rcssmonitor"
+      \param capacity the number of slots
+      \return true if successfully created.
+     */
+    bool create( const std::string & name,
+                 const std::size_t capacity );
+
+    /*!
+      \brief open the existing shared memory as a reader.
+      \param name shared memory object name
+      \return true if successfully opened.
+     */
+    bool open( const std::string & name );
+
+    /*!
+      \brief unmap the memory. the producer also removes the object name.
+     */
+    void close();
+
+    bool isOpen() const
+      {
+          return M_header != 0;
+      }
+
+    const std::string & name() const
+      {
+          return M_name;
+      }
+
+    /*!
+      \brief publish one frame. only for the producer.
+     */
+    void write( const rcss::rcg::DispInfoT & disp );
+
+    /*!
+      \brief copy the next unread frame.
+      \param disp the destination
+      \return false if no new frame is available.
+     */
+    bool read( rcss::rcg::DispInfoT & disp );
+
+    rcss::rcg::UInt32 readSequence() const
+      {
+          return M_read_seq;
+      }
+
+    unsigned long droppedCount() const
+      {
+          return M_dropped_count;
+      }
+
+};
+
+#endif
@@ -0,0 +1,276 @@
+// -*-c++-*-
+
+/*!
+  \file heat_map.cpp
+  \brief player position heat map class Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "heat_map.h"
+
+#include <algorithm>
+#include <cmath>
+
+const double HeatMap::CELL_SIZE = 2.0;
+const double HeatMap::MIN_X = -56.0;
+const double HeatMap::MIN_Y = -36.0;
+const int HeatMap::GRID_WIDTH = 56;
+const int HeatMap::GRID_HEIGHT = 36;
+const std::size_t HeatMap::SNAPSHOT_INTERVAL = 100;
+const unsigned short HeatMap::NO_CELL = static_cast< unsigned short >( -1 );
+
+namespace {
+const std::size_t CELL_COUNT = HeatMap::GRID_WIDTH * HeatMap::GRID_HEIGHT;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+HeatMap::HeatMap()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+HeatMap::clear()
+{
+    M_cells.clear();
+    M_counts.assign( PLAYER_SIZE * CELL_COUNT, 0 );
+    M_snapshots.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+unsigned short
+HeatMap::cellIndex( const float x,
+                    const float y )
+{
+    int col = static_cast< int >( std::floor( ( x - MIN_X ) / CELL_SIZE ) );
+    int row = static_cast< int >( std::floor( ( y - MIN_Y ) / CELL_SIZE ) );
+
+    col = std::min( std::max( 0, col ), GRID_WIDTH - 1 );
+    row = std::min( std::max( 0, row ), GRID_HEIGHT - 1 );
+
+    return static_cast< unsigned short >( row * GRID_WIDTH + col );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+HeatMap::add( const rcss::rcg::ShowInfoT & show )
+{
+    if ( size() % SNAPSHOT_INTERVAL == 0 )
+    {
+        M_snapshots.push_back( M_counts );
+    }
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        const rcss::rcg::PlayerT & p = show.player_[i];
+
+        if ( p.state_ == 0 )
+        {
+            M_cells.push_back( NO_CELL );
+            continue;
+        }
+
+        const unsigned short cell = cellIndex( p.x_, p.y_ );
+        M_cells.push_back( cell );
+        ++M_counts[i * CELL_COUNT + cell];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the snapshots after the position lose the frame shifted out of their
+  range and gain the inserted frame.
+ */
+void
+HeatMap::insert( const std::size_t pos,
+                 const rcss::rcg::ShowInfoT & show )
+{
+    const std::size_t n = size();
+    if ( pos >= n )
+    {
+        add( show );
+        return;
+    }
+
+    if ( n % SNAPSHOT_INTERVAL == 0 )
+    {
+        // the snapshot of the old frames [0, n), adjusted below.
+        M_snapshots.push_back( M_counts );
+    }
+
+    unsigned short cells[PLAYER_SIZE];
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        const rcss::rcg::PlayerT & p = show.player_[i];
+
+        if ( p.state_ == 0 )
+        {
+            cells[i] = NO_CELL;
+            continue;
+        }
+
+        cells[i] = cellIndex( p.x_, p.y_ );
+        ++M_counts[i * CELL_COUNT + cells[i]];
+    }
+
+    M_cells.insert( M_cells.begin() + pos * PLAYER_SIZE,
+                    cells, cells + PLAYER_SIZE );
+
+    for ( std::size_t k = pos / SNAPSHOT_INTERVAL + 1; k < M_snapshots.size(); ++k )
+    {
+        Counts & snapshot = M_snapshots[k];
+        const unsigned short * out = &M_cells[k * SNAPSHOT_INTERVAL * PLAYER_SIZE];
+
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            if ( out[i] != NO_CELL ) --snapshot[i * CELL_COUNT + out[i]];
+            if ( cells[i] != NO_CELL ) ++snapshot[i * CELL_COUNT + cells[i]];
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+unsigned int
+HeatMap::getCounts( const std::size_t first,
+                    const std::size_t last,
+                    const unsigned int player_mask,
+                    Counts & result ) const
+{
+    result.assign( CELL_COUNT, 0 );
+
+    if ( size() == 0
+         || last < first
+         || player_mask == 0 )
+    {
+        return 0;
+    }
+
+    const std::size_t end = std::min( last + 1, size() );
+    if ( end <= first )
+    {
+        return 0;
+    }
+
+    // counts of [first, end) = cumulative( end ) - cumulative( first )
+    // the unsigned overflow in the middle of the calculation is canceled.
+    const std::size_t end_base = addSnapshot( end, player_mask, +1, result );
+    addRecordedFrames( end_base, end, player_mask, +1, result );
+
+    const std::size_t first_base = addSnapshot( first, player_mask, -1, result );
+    addRecordedFrames( first_base, first, player_mask, -1, result );
+
+    return *std::max_element( result.begin(), result.end() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  add the counts of the recorded frames [first, last) to the result.
+ */
+void
+HeatMap::addRecordedFrames( const std::size_t first,
+                            const std::size_t last,
+                            const unsigned int player_mask,
+                            const int sign,
+                            Counts & result ) const
+{
+    for ( std::size_t f = first; f < last; ++f )
+    {
+        const unsigned short * cells = &M_cells[f * PLAYER_SIZE];
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            if ( ! ( player_mask & ( 1u << i ) )
+                 || cells[i] == NO_CELL )
+            {
+                continue;
+            }
+
+            if ( sign > 0 ) ++result[cells[i]];
+            else --result[cells[i]];
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  add the counts of the nearest snapshot before the given frame to the
+  result, and return the number of frames included in that snapshot.
+ */
+std::size_t
+HeatMap::addSnapshot( const std::size_t frame,
+                      const unsigned int player_mask,
+                      const int sign,
+                      Counts & result ) const
+{
+    if ( M_snapshots.empty() )
+    {
+        return 0;
+    }
+
+    const std::size_t k = std::min( frame / SNAPSHOT_INTERVAL,
+                                     M_snapshots.size() - 1 );
+    const Counts & snapshot = M_snapshots[k];
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        if ( ! ( player_mask & ( 1u << i ) ) )
+        {
+            continue;
+        }
+
+        const unsigned int * counts = &snapshot[i * CELL_COUNT];
+        if ( sign > 0 )
+        {
+            for ( std::size_t c = 0; c < CELL_COUNT; ++c ) result[c] += counts[c];
+        }
+        else
+        {
+            for ( std::size_t c = 0; c < CELL_COUNT; ++c ) result[c] -= counts[c];
+        }
+    }
+
+    return k * SNAPSHOT_INTERVAL;
+}
@@ -0,0 +1,147 @@
+// -*-c++-*-
+
+/*!
+  \file heat_map.h
+  \brief player position heat map class Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_HEAT_MAP_H
+#define RCSSMONITOR_HEAT_MAP_H
+
+#include <rcsslogplayer/types.h>
+
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class HeatMap
+  \brief occupancy counts of each player on a fixed grid.
+
+  The grid cell of each player is recorded when a display data is
+  stored, and the cumulative counts are saved as a snapshot every
+  SNAPSHOT_INTERVAL frames. The counts over any range of frames are
+  obtained from the difference of two snapshots and at most
+  SNAPSHOT_INTERVAL recorded frames at each end of the range.
+ */
+class HeatMap {
+public:
+
+    //! cell size in meters
+    static const double CELL_SIZE;
+    //! x coordinate of the left edge of the grid
+    static const double MIN_X;
+    //! y coordinate of the top edge of the grid
+    static const double MIN_Y;
+    //! the number of columns
+    static const int GRID_WIDTH;
+    //! the number of rows
+    static const int GRID_HEIGHT;
+    //! the number of frames between the snapshots
+    static const std::size_t SNAPSHOT_INTERVAL;
+
+    typedef std::vector< unsigned int > Counts;
+
+private:
+
+    //! the number of players
+    static const int PLAYER_SIZE = rcss::rcg::MAX_PLAYER * 2;
+    //! the cell index of the inactive player
+    static const unsigned short NO_CELL;
+
+    //! cell index of each player in each frame
+    std::vector< unsigned short > M_cells;
+
+    //! cumulative counts of each player over all recorded frames
+    Counts M_counts;
+
+    //! M_snapshots[k] is the cumulative counts of frames [0, k * SNAPSHOT_INTERVAL)
+    std::vector< Counts > M_snapshots;
+
+public:
+
+    HeatMap();
+
+    void clear();
+
+    /*!
+      \brief get the number of recorded frames
+      \return the number of recorded frames
+     */
+    std::size_t size() const
+      {
+          return M_cells.size() / PLAYER_SIZE;
+      }
+
+    /*!
+      \brief record the players' cells of the new frame. O(players) except snapshots.
+      \param show new show data
+     */
+    void add( const rcss::rcg::ShowInfoT & show );
+
+    /*!
+      \brief record the players' cells of the late frame in the middle of the frames.
+      O(players * (frames after the position / SNAPSHOT_INTERVAL)) except the cell copy.
+      \param pos index of the inserted frame
+      \param show late show data
+     */
+    void insert( const std::size_t pos,
+                 const rcss::rcg::ShowInfoT & show );
+
+    /*!
+      \brief get the counts of the selected players over the range of frames.
+      \param first index of the first frame
+      \param last index of the last frame (inclusive)
+      \param player_mask bit flags of the selected players. bit i corresponds to ShowInfoT::player_[i].
+      \param result reference to the result variable. the size is GRID_WIDTH * GRID_HEIGHT.
+      \return the max count in the result.
+     */
+    unsigned int getCounts( const std::size_t first,
+                            const std::size_t last,
+                            const unsigned int player_mask,
+                            Counts & result ) const;
+
+private:
+
+    static
+    unsigned short cellIndex( const float x,
+                              const float y );
+
+    void addRecordedFrames( const std::size_t first,
+                            const std::size_t last,
+                            const unsigned int player_mask,
+                            const int sign,
+                            Counts & result ) const;
+
+    std::size_t addSnapshot( const std::size_t frame,
+                             const unsigned int player_mask,
+                             const int sign,
+                             Counts & result ) const;
+
+};
+
+#endif
@@ -0,0 +1,231 @@
+// -*-c++-*-
+
+/*!
+  \file heat_map_painter.cpp
+  \brief heat map painter class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C)  The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "heat_map_painter.h"
+
+#include "render_settings.h"
+
+#include <algorithm>
+
+namespace {
+const int PALETTE_SIZE = 256;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+HeatMapPainter::HeatMapPainter( const DispHolder & disp_holder )
+    : M_disp_holder( disp_holder ),
+      M_palette( PALETTE_SIZE ),
+      M_image( HeatMap::GRID_WIDTH, HeatMap::GRID_HEIGHT, QImage::Format_ARGB32 ),
+      M_visible( false ),
+      M_buffer_revision( -1 ),
+      M_first( DispHolder::INVALID_INDEX ),
+      M_last( DispHolder::INVALID_INDEX ),
+      M_player_mask( 0 )
+{
+    // from transparent blue to opaque red
+    M_palette[0] = qRgba( 0, 0, 0, 0 );
+    for ( int i = 1; i < PALETTE_SIZE; ++i )
+    {
+        const double rate = static_cast< double >( i ) / ( PALETTE_SIZE - 1 );
+        M_palette[i] = QColor::fromHsvF( ( 1.0 - rate ) * 0.66, 1.0, 1.0,
+                                         0.2 + 0.6 * rate ).rgba();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+HeatMapPainter::~HeatMapPainter()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+HeatMapPainter::prepare( const RenderSettings & settings )
+{
+    M_visible = false;
+
+    if ( settings.heatMapType() == Options::HEAT_MAP_NONE )
+    {
+        return;
+    }
+
+    const unsigned int player_mask = playerMask( settings );
+    if ( player_mask == 0 )
+    {
+        return;
+    }
+
+    // heat map is available only for the buffered data.
+    const DispCont & cont = M_disp_holder.dispCont();
+    const std::size_t current = M_disp_holder.currentIndex();
+
+    if ( current == DispHolder::INVALID_INDEX
+         || cont.size() <= current
+         || M_disp_holder.heatMap().size() <= current )
+    {
+        // the heat map is recorded when the heat map type is enabled.
+        return;
+    }
+
+    std::size_t first = 0;
+    if ( settings.heatMapCycle() > 0 )
+    {
+        const int time = static_cast< int >( cont[current]->show_.time_ );
+        first = M_disp_holder.getIndex( std::max( 0, time - settings.heatMapCycle() ) );
+        if ( first == DispHolder::INVALID_INDEX )
+        {
+            first = current;
+        }
+    }
+
+    updateImage( first, current, player_mask );
+    M_visible = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+HeatMapPainter::draw( QPainter & painter,
+                      const RenderSettings & settings )
+{
+    if ( ! M_visible )
+    {
+        return;
+    }
+
+    const double scale = settings.fieldScale();
+    const QRectF rect( settings.fieldCenter().x() + HeatMap::MIN_X * scale,
+                       settings.fieldCenter().y() + HeatMap::MIN_Y * scale,
+                       HeatMap::GRID_WIDTH * HeatMap::CELL_SIZE * scale,
+                       HeatMap::GRID_HEIGHT * HeatMap::CELL_SIZE * scale );
+
+    painter.drawImage( rect, M_image );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+unsigned int
+HeatMapPainter::playerMask( const RenderSettings & settings ) const
+{
+    const unsigned int team_mask = ( 1u << rcss::rcg::MAX_PLAYER ) - 1;
+
+    switch ( settings.heatMapType() ) {
+    case Options::HEAT_MAP_LEFT:
+        return team_mask;
+    case Options::HEAT_MAP_RIGHT:
+        return team_mask << rcss::rcg::MAX_PLAYER;
+    case Options::HEAT_MAP_SELECTED:
+        if ( settings.selectedNumber() > 0 )
+        {
+            return 1u << ( settings.selectedNumber() - 1 );
+        }
+        if ( settings.selectedNumber() < 0 )
+        {
+            return 1u << ( -settings.selectedNumber() - 1 + rcss::rcg::MAX_PLAYER );
+        }
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+HeatMapPainter::updateImage( const std::size_t first,
+                             const std::size_t last,
+                             const unsigned int player_mask )
+{
+    const DispCont & cont = M_disp_holder.dispCont();
+
+    if ( M_first_disp == cont.front()
+         && M_buffer_revision == M_disp_holder.bufferRevision()
+         && M_first == first
+         && M_last == last
+         && M_player_mask == player_mask )
+    {
+        return;
+    }
+
+    M_first_disp = cont.front();
+    M_buffer_revision = M_disp_holder.bufferRevision();
+    M_first = first;
+    M_last = last;
+    M_player_mask = player_mask;
+
+    const unsigned int max_count = M_disp_holder.heatMap().getCounts( first, last,
+                                                                       player_mask,
+                                                                       M_counts );
+    if ( max_count == 0 )
+    {
+        M_image.fill( 0 );
+        return;
+    }
+
+    const unsigned int * count = &M_counts[0];
+    for ( int y = 0; y < HeatMap::GRID_HEIGHT; ++y )
+    {
+        QRgb * line = reinterpret_cast< QRgb * >( M_image.scanLine( y ) );
+        for ( int x = 0; x < HeatMap::GRID_WIDTH; ++x, ++count )
+        {
+            int level = 0;
+            if ( *count > 0 )
+            {
+                level = std::max( 1, static_cast< int >( ( PALETTE_SIZE - 1 ) * *count / max_count ) );
+            }
+            line[x] = M_palette[level];
+        }
+    }
+}
@@ -0,0 +1,100 @@
+// -*-c++-*-
+
+/*!
+  \file heat_map_painter.h
+  \brief heat map painter class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C)  The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_HEAT_MAP_PAINTER_H
+#define RCSSMONITOR_HEAT_MAP_PAINTER_H
+
+#include <QImage>
+#include <QVector>
+
+#include "painter_interface.h"
+#include "disp_holder.h"
+
+#include <cstddef>
+
+/*!
+  \class HeatMapPainter
+  \brief draw the occupancy heat map of the selected players.
+
+  The counts are converted to one image whose pixel corresponds to one
+  grid cell, and the image is scaled to the field when it is drawn. The
+  image is regenerated only when the range of frames or the target
+  players are changed.
+*/
+class HeatMapPainter
+    : public PainterInterface {
+private:
+    const DispHolder & M_disp_holder;
+
+    //! color of each count level
+    QVector< QRgb > M_palette;
+
+    //! cached heat map image
+    QImage M_image;
+    //! true if the image has been prepared for the next draw()
+    bool M_visible;
+
+    // the conditions of the cached image
+    DispConstPtr M_first_disp;
+    int M_buffer_revision;
+    std::size_t M_first;
+    std::size_t M_last;
+    unsigned int M_player_mask;
+
+    //! work area for the counts
+    HeatMap::Counts M_counts;
+
+    // not used
+    HeatMapPainter();
+    HeatMapPainter( const HeatMapPainter & );
+    const HeatMapPainter & operator=( const HeatMapPainter & );
+public:
+
+    HeatMapPainter( const DispHolder & disp_holder );
+    ~HeatMapPainter();
+
+    void prepare( const RenderSettings & settings );
+
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
+
+private:
+
+    unsigned int playerMask( const RenderSettings & settings ) const;
+
+    void updateImage( const std::size_t first,
+                      const std::size_t last,
+                      const unsigned int player_mask );
+
+};
+
+#endif
@@ -43,6 +43,13 @@
 
 #include <iostream>
 
+namespace {
+//! the number of frames shown before the goal by the score jump
+const std::size_t SCORE_LEAD_FRAMES = 50;
+//! the live timer is parked when no frame is received for this period [ms]
+const int IDLE_WAIT_MSEC = 1000;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -54,12 +61,15 @@ LogPlayer::LogPlayer( DispHolder & disp_holder,
       M_timer( new QTimer( this ) ),
       M_forward( true ),
       M_live_mode( false ),
-      M_need_recovering( false )
+      M_need_recovering( false ),
+      M_gap_index( DispHolder::INVALID_INDEX ),
+      M_quiet_size( 0 )
 {
     connect( M_timer, SIGNAL( timeout() ),
              this, SLOT( handleTimer() ) );
 
     M_timer->setInterval( Options::instance().timerInterval() );
+    M_quiet_time.start();
 
     Options::instance().setBufferRecoverMode( true );
 }
@@ -88,6 +98,9 @@ LogPlayer::clear()
     M_forward = true;
     M_live_mode = false;
     M_need_recovering = false;
+    M_gap_index = DispHolder::INVALID_INDEX;
+    M_quiet_size = 0;
+    M_quiet_time.start();
     M_timer->setInterval( Options::instance().timerInterval() );
 
     Options::instance().setBufferRecoverMode( true );
@@ -108,7 +121,10 @@ LogPlayer::handleTimer()
     {
         if ( M_forward )
         {
-            stepForwardImpl();
+            if ( ! holdOnGap() )
+            {
+                stepForwardImpl();
+            }
         }
         else
         {
@@ -118,6 +134,12 @@ LogPlayer::handleTimer()
 
     adjustTimer();
 
+    if ( opt.bufferingMode()
+         && opt.monitorClientMode() )
+    {
+        checkIdle();
+    }
+
     if ( opt.bufferingMode()
          && opt.bufferRecoverMode() )
     {
@@ -125,6 +147,67 @@ LogPlayer::handleTimer()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  the live timer keeps waiting for the buffer while the stream is quiet,
+  e.g. in the half time break. it is parked after a while, and restarted
+  by startTimer() when the next frame is received.
+*/
+void
+LogPlayer::checkIdle()
+{
+    const std::size_t size = M_disp_holder.dispCont().size();
+    const std::size_t current = M_disp_holder.currentIndex();
+
+    if ( size != M_quiet_size
+         || current == DispHolder::INVALID_INDEX
+         || current + 1 < size )
+    {
+        // new frames have been received, or the buffered frames are still played.
+        M_quiet_size = size;
+        M_quiet_time.start();
+        return;
+    }
+
+    if ( M_quiet_time.elapsed() >= IDLE_WAIT_MSEC )
+    {
+        M_timer->stop();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the display waits for the late show of the skipped cycles for a while
+  before it jumps over the gap.
+*/
+bool
+LogPlayer::holdOnGap()
+{
+    const Options & opt = Options::instance();
+
+    if ( opt.gapHoldTime() <= 0
+         || ! opt.bufferingMode()
+         || ! opt.monitorClientMode() )
+    {
+        return false;
+    }
+
+    const std::size_t current = M_disp_holder.currentIndex();
+    if ( ! M_disp_holder.isGapAfter( current ) )
+    {
+        return false;
+    }
+
+    if ( M_gap_index != current )
+    {
+        M_gap_index = current;
+        M_gap_time.start();
+        return true;
+    }
+
+    return M_gap_time.elapsed() < opt.gapHoldTime();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -321,55 +404,92 @@ LogPlayer::accelerateForward()
 /*!
 
 */
-// void
-// LogPlayer::goToPrevScore()
-// {
-//     M_live_mode = false;
-
-//     const DispHolder & holder = M_main_data.dispHolder();
-
-//     const std::size_t cur_idx = M_main_data.index();
-//     std::vector< std::size_t >::const_reverse_iterator rend = holder.scoreChangedIndex().rend();
-//     for ( std::vector< std::size_t >::const_reverse_iterator it = holder.scoreChangedIndex().rbegin();
-//           it != rend;
-//           ++it )
-//     {
-//         if ( *it < cur_idx )
-//         {
-//             std::size_t new_idx = *it;
-//             new_idx -= ( new_idx < 50 ? new_idx : 50 );
-//             goToIndex( new_idx );
-//             return;
-//         }
-//     }
-// }
+void
+LogPlayer::goToPrevScore()
+{
+    const std::size_t cur_idx = M_disp_holder.currentIndex();
+    if ( cur_idx == DispHolder::INVALID_INDEX )
+    {
+        return;
+    }
+
+    const std::size_t idx = M_disp_holder.prevEventIndex( cur_idx, EVENT_SCORE );
+    if ( idx != DispHolder::INVALID_INDEX )
+    {
+        M_live_mode = false;
+        M_timer->stop();
+        // show the scene before the goal
+        goToIndex( static_cast< int >( idx - ( idx < SCORE_LEAD_FRAMES ? idx : SCORE_LEAD_FRAMES ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LogPlayer::goToNextScore()
+{
+    const std::size_t cur_idx = M_disp_holder.currentIndex();
+    if ( cur_idx == DispHolder::INVALID_INDEX )
+    {
+        return;
+    }
+
+    // skip the goal whose lead frames include the current index
+    const std::size_t idx = M_disp_holder.nextEventIndex( cur_idx + SCORE_LEAD_FRAMES,
+                                                          EVENT_SCORE );
+    if ( idx != DispHolder::INVALID_INDEX )
+    {
+        M_live_mode = false;
+        M_timer->stop();
+        goToIndex( static_cast< int >( idx - SCORE_LEAD_FRAMES ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LogPlayer::goToPrevEvent()
+{
+    const std::size_t cur_idx = M_disp_holder.currentIndex();
+    if ( cur_idx == DispHolder::INVALID_INDEX )
+    {
+        return;
+    }
+
+    const std::size_t idx = M_disp_holder.prevEventIndex( cur_idx, EVENT_ALL );
+    if ( idx != DispHolder::INVALID_INDEX )
+    {
+        M_live_mode = false;
+        M_timer->stop();
+        goToIndex( static_cast< int >( idx ) );
+    }
+}
 
 /*-------------------------------------------------------------------*/
 /*!
 
 */
-// void
-// LogPlayer::goToNextScore()
-// {
-//     M_live_mode = false;
-
-//     const DispHolder & holder = M_main_data.dispHolder();
-
-//     const std::size_t cur_idx = M_main_data.index();
-//     std::vector< std::size_t >::const_iterator end = holder.scoreChangedIndex().end();
-//     for ( std::vector< std::size_t >::const_iterator it = holder.scoreChangedIndex().begin();
-//           it != end;
-//           ++it )
-//     {
-//         if ( 50 < *it && cur_idx < *it - 50 )
-//         {
-//             std::size_t new_idx = *it;
-//             new_idx -= ( new_idx < 50 ? 0 : 50 );
-//             goToIndex( new_idx );
-//             return;
-//         }
-//     }
-// }
+void
+LogPlayer::goToNextEvent()
+{
+    const std::size_t cur_idx = M_disp_holder.currentIndex();
+    if ( cur_idx == DispHolder::INVALID_INDEX )
+    {
+        return;
+    }
+
+    const std::size_t idx = M_disp_holder.nextEventIndex( cur_idx, EVENT_ALL );
+    if ( idx != DispHolder::INVALID_INDEX )
+    {
+        M_live_mode = false;
+        M_timer->stop();
+        goToIndex( static_cast< int >( idx ) );
+    }
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -528,6 +648,8 @@ LogPlayer::startTimer()
     if ( ! M_disp_holder.dispCont().empty()
          && ! M_timer->isActive() )
     {
+        // also wakes up the parked timer.
+        M_quiet_time.start();
         M_timer->start( Options::instance().timerInterval() );
     }
 }
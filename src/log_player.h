@@ -34,6 +34,9 @@
 #define RCSSMONITOR_LOG_PLAYER_H
 
 #include <QObject>
+#include <QTime>
+
+#include <cstddef>
 
 class QTimer;
 
@@ -54,6 +57,16 @@ private:
     bool M_live_mode;
     bool M_need_recovering;
 
+    //! index of the buffered data where the display is held by the cycle gap
+    std::size_t M_gap_index;
+    //! elapsed time since the display has been held
+    QTime M_gap_time;
+
+    //! buffer size when the live stream became quiet
+    std::size_t M_quiet_size;
+    //! elapsed time since the live stream became quiet
+    QTime M_quiet_time;
+
     // not used
     LogPlayer();
     LogPlayer( const LogPlayer & );
@@ -73,6 +86,8 @@ public:
 private:
 
     void adjustTimer();
+    bool holdOnGap();
+    void checkIdle();
     void stepBackImpl();
     void stepForwardImpl();
 
@@ -95,8 +110,11 @@ public slots:
     void accelerateBack();
     void accelerateForward();
 
-//     void goToPrevScore();
-//     void goToNextScore();
+    void goToPrevScore();
+    void goToNextScore();
+
+    void goToPrevEvent();
+    void goToNextEvent();
 
     void goToFirst();
     void goToLast();
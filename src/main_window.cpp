@@ -40,12 +40,16 @@
 
 #include "config_dialog.h"
 #include "field_canvas.h"
+#include "field_wall.h"
+#include "frame_presenter.h"
 #include "log_player.h"
 #include "monitor_client.h"
 #include "player_type_dialog.h"
+#include "timeline_strip.h"
 #include "options.h"
 
 #include <string>
+#include <sstream>
 #include <iostream>
 #include <cstring>
 #include <cstdio>
@@ -66,8 +70,12 @@ MainWindow::MainWindow()
       M_player_type_dialog( static_cast< PlayerTypeDialog * >( 0 ) ),
       M_config_dialog( static_cast< ConfigDialog * >( 0 ) ),
       M_field_canvas( static_cast< FieldCanvas * >( 0 ) ),
+      M_field_wall( static_cast< FieldWall * >( 0 ) ),
       M_monitor_client( static_cast< MonitorClient * >( 0 ) ),
-      M_log_player( new LogPlayer( M_disp_holder, this ) )
+      M_log_player( new LogPlayer( M_disp_holder, this ) ),
+      M_frame_presenter( new FramePresenter( Options::instance().refreshRate(), this ) ),
+      M_timeline_tool_bar( static_cast< QToolBar * >( 0 ) ),
+      M_timeline_strip( static_cast< TimelineStrip * >( 0 ) )
 {
     this->setWindowIcon( QIcon( QPixmap( rcss_xpm ) ) );
     this->setWindowTitle( tr( PACKAGE_NAME ) + tr( " " ) + tr( VERSION ) );
@@ -88,12 +96,16 @@ MainWindow::MainWindow()
              this, SIGNAL( viewUpdated() ) );
     connect( M_log_player, SIGNAL( updated() ),
              this, SLOT( updateBufferingLabel() ) );
+    connect( M_log_player, SIGNAL( updated() ),
+             this, SLOT( updateCycleStatsLabel() ) );
     connect( M_log_player, SIGNAL( recoverTimerHandled() ),
              this, SLOT( updateBufferingLabel() ) );
     connect( M_log_player, SIGNAL( recoverTimerHandled() ),
              this, SLOT( showRecoveringState() ) );
     connect( M_log_player, SIGNAL( quitRequested() ),
              this, SLOT( setQuitTimer() ) );
+    connect( M_frame_presenter, SIGNAL( presentRequested() ),
+             M_log_player, SLOT( showLive() ) );
 
     this->resize( Options::instance().windowWidth() > 0
                   ? Options::instance().windowWidth()
@@ -150,6 +162,8 @@ MainWindow::init()
     if ( ! Options::instance().bufferingMode() )
     {
         M_buffering_label->hide();
+        // the thumbnails are available only for the buffered data.
+        M_timeline_tool_bar->hide();
     }
 
     toggleMenuBar( Options::instance().showMenuBar() );
@@ -159,6 +173,11 @@ MainWindow::init()
     {
         connectMonitor();
     }
+
+    if ( M_field_wall )
+    {
+        M_field_wall->connectFields();
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -579,7 +598,17 @@ MainWindow::createMenuHelp()
 void
 MainWindow::createToolBars()
 {
+    M_timeline_strip = new TimelineStrip( M_disp_holder );
+
+    M_timeline_tool_bar = new QToolBar( tr( "Timeline" ), this );
+    M_timeline_tool_bar->setMovable( false );
+    M_timeline_tool_bar->addWidget( M_timeline_strip );
+    this->addToolBar( Qt::BottomToolBarArea, M_timeline_tool_bar );
 
+    connect( this, SIGNAL( viewUpdated() ),
+             M_timeline_strip, SLOT( update() ) );
+    connect( M_timeline_strip, SIGNAL( indexSelected( int ) ),
+             M_log_player, SLOT( goToIndex( int ) ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -603,6 +632,18 @@ MainWindow::createStatusBar()
 
     //
 
+    M_cycle_stats_label = new QLabel( tr( "Lost 0.00% Reord 0.00% Dup 0.00%" ) );
+    min_width
+        = M_cycle_stats_label->fontMetrics().width(  tr( "Lost 00.00% Reord 00.00% Dup 00.00%" ) )
+        + 16;
+    M_cycle_stats_label->setMinimumWidth( min_width );
+    M_cycle_stats_label->setAlignment( Qt::AlignLeft );
+    this->statusBar()->addPermanentWidget( M_cycle_stats_label );
+    // shown when the monitor is connected
+    M_cycle_stats_label->hide();
+
+    //
+
     M_position_label = new QLabel( tr( "(0.0, 0.0)" ) );
 
     min_width
@@ -621,7 +662,10 @@ MainWindow::createStatusBar()
 void
 MainWindow::createFieldCanvas()
 {
-    M_field_canvas = new FieldCanvas( M_disp_holder );
+    // the layer threads are not used if several canvases run their own workers.
+    const bool wall = ! Options::instance().wallServers().empty();
+
+    M_field_canvas = new FieldCanvas( M_disp_holder, ! wall );
 
     QMenu * popup_menu = M_field_canvas->createPopupMenu();
     popup_menu->addSeparator();
@@ -629,7 +673,19 @@ MainWindow::createFieldCanvas()
     popup_menu->addAction( M_red_card_act );
 
 
-    this->setCentralWidget( M_field_canvas );
+    if ( wall )
+    {
+        M_field_wall = new FieldWall( M_field_canvas,
+                                      Options::instance().wallServers() );
+        this->setCentralWidget( M_field_wall );
+
+        connect( this, SIGNAL( viewUpdated() ),
+                 M_field_wall, SLOT( updateFields() ) );
+    }
+    else
+    {
+        this->setCentralWidget( M_field_canvas );
+    }
     M_field_canvas->setFocus();
 
     connect( this, SIGNAL( viewUpdated() ),
@@ -707,6 +763,15 @@ MainWindow::createConfigDialog()
 
     M_config_dialog->hide();
 
+    connect( M_config_dialog, SIGNAL( configured() ),
+             this, SLOT( updateHeatMap() ) );
+    connect( M_config_dialog, SIGNAL( configured() ),
+             M_field_canvas, SLOT( invalidateRenderSettings() ) );
+    if ( M_field_wall )
+    {
+        connect( M_config_dialog, SIGNAL( configured() ),
+                 M_field_wall, SLOT( invalidateRenderSettings() ) );
+    }
     connect( M_config_dialog, SIGNAL( configured() ),
              this, SIGNAL( viewUpdated() ) );
 
@@ -903,6 +968,15 @@ MainWindow::createConfigDialog()
         connect( act, SIGNAL( triggered() ),
                  M_config_dialog, SLOT( toggleShowOffsideLine() ) );
     }
+    {
+        // g
+        QAction * act = new QAction( tr( "Change Heat Map" ), this );
+        act->setShortcut( Qt::Key_G );
+        act->setStatusTip( tr( "Change the target players of the heat map." ) );
+        this->addAction( act );
+        connect( act, SIGNAL( triggered() ),
+                 M_config_dialog, SLOT( changeHeatMapType() ) );
+    }
 
     // number 1-10
     for ( int i = 0; i < 10; ++i )
@@ -1005,6 +1079,47 @@ MainWindow::createConfigDialog()
         connect( act, SIGNAL( triggered() ),
                  M_config_dialog, SLOT( setUnselect() ) );
     }
+    // page up/down
+    {
+        QAction * act = new QAction( tr( "Previous Event" ), this );
+        act->setShortcut( Qt::Key_PageUp );
+        act->setStatusTip( tr( "Go to the previous event in the buffered data." ) );
+        this->addAction( act );
+        connect( act, SIGNAL( triggered() ),
+                 M_log_player, SLOT( goToPrevEvent() ) );
+    }
+    {
+        QAction * act = new QAction( tr( "Next Event" ), this );
+        act->setShortcut( Qt::Key_PageDown );
+        act->setStatusTip( tr( "Go to the next event in the buffered data." ) );
+        this->addAction( act );
+        connect( act, SIGNAL( triggered() ),
+                 M_log_player, SLOT( goToNextEvent() ) );
+    }
+    {
+        QAction * act = new QAction( tr( "Previous Score" ), this );
+#ifdef Q_WS_MAC
+        act->setShortcut( Qt::META + Qt::Key_PageUp );
+#else
+        act->setShortcut( Qt::CTRL + Qt::Key_PageUp );
+#endif
+        act->setStatusTip( tr( "Go to the scene before the previous goal." ) );
+        this->addAction( act );
+        connect( act, SIGNAL( triggered() ),
+                 M_log_player, SLOT( goToPrevScore() ) );
+    }
+    {
+        QAction * act = new QAction( tr( "Next Score" ), this );
+#ifdef Q_WS_MAC
+        act->setShortcut( Qt::META + Qt::Key_PageDown );
+#else
+        act->setShortcut( Qt::CTRL + Qt::Key_PageDown );
+#endif
+        act->setStatusTip( tr( "Go to the scene before the next goal." ) );
+        this->addAction( act );
+        connect( act, SIGNAL( triggered() ),
+                 M_log_player, SLOT( goToNextScore() ) );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -1039,11 +1154,20 @@ MainWindow::connectMonitorTo( const char * hostname )
     this->statusBar()->showMessage( tr( "Connect to %1 ..." ).arg( QString::fromAscii( hostname ) ),
                                     5000 );
 
-    M_monitor_client = new MonitorClient( this,
-                                          M_disp_holder,
-                                          hostname,
-                                          Options::instance().serverPort(),
-                                          Options::instance().clientVersion() );
+    if ( ! Options::instance().frameRing().empty() )
+    {
+        M_monitor_client = new MonitorClient( this,
+                                              M_disp_holder,
+                                              Options::instance().frameRing() );
+    }
+    else
+    {
+        M_monitor_client = new MonitorClient( this,
+                                              M_disp_holder,
+                                              hostname,
+                                              Options::instance().serverPort(),
+                                              Options::instance().clientVersion() );
+    }
 
     if ( ! M_monitor_client->isConnected() )
     {
@@ -1057,6 +1181,7 @@ MainWindow::connectMonitorTo( const char * hostname )
     // reset all data
     M_disp_holder.clear();
     M_log_player->clear();
+    M_frame_presenter->clear();
 
     if ( M_player_type_dialog )
     {
@@ -1068,6 +1193,9 @@ MainWindow::connectMonitorTo( const char * hostname )
         M_config_dialog->fitToScreen();
     }
 
+    M_cycle_stats_label->show();
+    updateCycleStatsLabel();
+
     Options::instance().setServerHost( hostname );
     Options::instance().setMonitorClientMode( true );
     Options::instance().setBufferRecoverMode( true );
@@ -1293,6 +1421,16 @@ MainWindow::disconnectMonitor()
         disconnect( M_monitor_client, SIGNAL( reconnectRequested() ),
                     this, SLOT( reconnectMonitor() ) );
 
+        // no repaint is requested for the closed session.
+        M_frame_presenter->stop();
+
+        if ( Options::instance().cycleStats() )
+        {
+            std::cout << "presented " << M_frame_presenter->presentedCount()
+                      << ", coalesced " << M_frame_presenter->coalescedCount()
+                      << std::endl;
+        }
+
         delete M_monitor_client;
         M_monitor_client = static_cast< MonitorClient * >( 0 );
 
@@ -1862,10 +2000,14 @@ MainWindow::receiveMonitorPacket()
     if ( Options::instance().bufferingMode() )
     {
         M_log_player->startTimer();
+        // the team graphics and the debug draw data are shown even while paused.
+        // the canvas renders again only if the holder revision is changed.
+        M_field_canvas->update();
     }
     else
     {
-        M_log_player->showLive();
+        // the frames received faster than the display refresh are coalesced.
+        M_frame_presenter->post();
     }
 }
 
@@ -1973,6 +2115,44 @@ MainWindow::updateBufferingLabel()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::updateCycleStatsLabel()
+{
+    if ( this->statusBar()->isVisible()
+         && M_cycle_stats_label->isVisible() )
+    {
+        const CycleStats & stats = M_disp_holder.cycleStats();
+
+        char buf[64];
+        snprintf( buf, 64,
+                  "Lost %.2f%% Reord %.2f%% Dup %.2f%%",
+                  stats.lostRate() * 100.0,
+                  stats.reorderedRate() * 100.0,
+                  stats.duplicatedRate() * 100.0 );
+        M_cycle_stats_label->setText( QString::fromAscii( buf ) );
+
+        std::ostringstream os;
+        stats.print( os );
+        os << "\npresented " << M_frame_presenter->presentedCount()
+           << ", coalesced " << M_frame_presenter->coalescedCount();
+        M_cycle_stats_label->setToolTip( QString::fromAscii( os.str().c_str() ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::updateHeatMap()
+{
+    M_disp_holder.updateHeatMap();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -40,12 +40,16 @@
 
 class QActionGroup;
 class QLabel;
+class QToolBar;
 
 class ConfigDialog;
 class FieldCanvas;
+class FieldWall;
+class FramePresenter;
 class LogPlayer;
 class MonitorClient;
 class PlayerTypeDialog;
+class TimelineStrip;
 
 class MainWindow
     : public QMainWindow {
@@ -61,11 +65,18 @@ private:
     PlayerTypeDialog * M_player_type_dialog;
     ConfigDialog * M_config_dialog;
     FieldCanvas * M_field_canvas;
+    FieldWall * M_field_wall; //!< tiled view of the additional servers. null if not used.
     MonitorClient * M_monitor_client;
     LogPlayer * M_log_player;
+    //! paces the repaints of the live frames in non buffering mode
+    FramePresenter * M_frame_presenter;
+
+    QToolBar * M_timeline_tool_bar;
+    TimelineStrip * M_timeline_strip;
 
     QLabel * M_position_label;
     QLabel * M_buffering_label;
+    QLabel * M_cycle_stats_label;
 
     // file actions
     QAction * M_exit_act;
@@ -184,6 +195,8 @@ private slots:
     void resizeCanvas( const QSize & size );
     void updatePositionLabel( const QPoint & point );
     void updateBufferingLabel();
+    void updateCycleStatsLabel();
+    void updateHeatMap();
 
     void showRecoveringState();
 
@@ -39,6 +39,7 @@
 #include "monitor_client.h"
 
 #include "disp_holder.h"
+#include "frame_ring.h"
 #include "options.h"
 
 #include <sstream>
@@ -48,6 +49,10 @@
 
 namespace {
 const int POLL_INTERVAL_MS = 1000;
+//! polling interval of the frame ring. shorter than the server cycle.
+const int RING_POLL_INTERVAL_MS = 10;
+//! polling interval of the frame ring while the producer is quiet.
+const int RING_IDLE_POLL_INTERVAL_MS = 250;
 }
 
 /*-------------------------------------------------------------------*/
@@ -67,6 +72,8 @@ MonitorClient::MonitorClient( QObject * parent,
     , M_timer( new QTimer( this ) )
     , M_version( version )
     , M_waited_msec( 0 )
+    , M_frame_ring( static_cast< FrameRing * >( 0 ) )
+    , M_ring_timer( static_cast< QTimer * >( 0 ) )
 {
     assert( parent );
 
@@ -117,6 +124,43 @@ MonitorClient::MonitorClient( QObject * parent,
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  the frames are copied from the shared memory without any parsing.
+  the commands cannot be sent to the producer.
+*/
+MonitorClient::MonitorClient( QObject * parent,
+                              DispHolder & disp_holder,
+                              const std::string & ring_name )
+
+    : QObject( parent )
+    , M_disp_holder( disp_holder )
+    , M_server_port( 0 )
+    , M_socket( new QUdpSocket( this ) )
+    , M_timer( new QTimer( this ) )
+    , M_version( 0 )
+    , M_waited_msec( 0 )
+    , M_frame_ring( new FrameRing() )
+    , M_ring_timer( new QTimer( this ) )
+{
+    assert( parent );
+
+    if ( ! M_frame_ring->open( ring_name ) )
+    {
+        std::cerr << "MonitorClient. failed to open the frame ring."
+                  << std::endl;
+        return;
+    }
+
+    connect( M_ring_timer, SIGNAL( timeout() ),
+             this, SLOT( handleRingTimer() ) );
+
+    connect( M_timer, SIGNAL( timeout() ),
+             this, SLOT( handleTimer() ) );
+
+    M_ring_timer->start( RING_POLL_INTERVAL_MS );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -125,6 +169,7 @@ MonitorClient::~MonitorClient()
 {
     disconnect();
 
+    delete M_frame_ring;
     //std::cerr << "delete MonitorClient" << std::endl;
 }
 
@@ -140,6 +185,13 @@ MonitorClient::disconnect()
         M_timer->stop();
     }
 
+    if ( M_frame_ring )
+    {
+        M_ring_timer->stop();
+        M_frame_ring->close();
+        return;
+    }
+
     if ( isConnected() )
     {
         sendDispBye();
@@ -154,6 +206,11 @@ MonitorClient::disconnect()
 bool
 MonitorClient::isConnected() const
 {
+    if ( M_frame_ring )
+    {
+        return M_frame_ring->isOpen();
+    }
+
     return ( M_socket->socketDescriptor() != -1 );
 }
 
@@ -274,6 +331,42 @@ MonitorClient::handleReceive()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+MonitorClient::handleRingTimer()
+{
+    int receive_count = 0;
+
+    rcss::rcg::DispInfoT disp;
+    while ( M_frame_ring->read( disp ) )
+    {
+        M_disp_holder.addDispInfo( disp );
+        ++receive_count;
+    }
+
+    if ( receive_count > 0 )
+    {
+        M_waited_msec = 0;
+        M_timer->start( POLL_INTERVAL_MS );
+
+        if ( M_ring_timer->interval() != RING_POLL_INTERVAL_MS )
+        {
+            M_ring_timer->start( RING_POLL_INTERVAL_MS );
+        }
+
+        emit received();
+    }
+    else if ( M_waited_msec >= POLL_INTERVAL_MS
+              && M_ring_timer->interval() != RING_IDLE_POLL_INTERVAL_MS )
+    {
+        // the shared memory cannot wake us up. poll it slowly while the producer is quiet.
+        M_ring_timer->start( RING_IDLE_POLL_INTERVAL_MS );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 MonitorClient::handleTimer()
@@ -322,6 +415,12 @@ MonitorClient::handleTimer()
 void
 MonitorClient::sendCommand( const std::string & com )
 {
+    if ( M_frame_ring )
+    {
+        // the frame ring is one-way.
+        return;
+    }
+
     if ( ! isConnected() )
     {
         return;
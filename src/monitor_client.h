@@ -42,6 +42,7 @@ class QHostInfo;
 class QTimer;
 class QUdpSocket;
 class DispHolder;
+class FrameRing;
 
 class MonitorClient
     : public QObject {
@@ -61,6 +62,9 @@ private:
 
     int M_waited_msec;
 
+    //! shared memory ring used instead of the socket. null if not used.
+    FrameRing * M_frame_ring;
+    QTimer * M_ring_timer;
 
     //! not used
     MonitorClient();
@@ -74,6 +78,11 @@ public:
                    const int port,
                    const int version );
 
+    //! constructor for the shared memory frame ring written by a local producer
+    MonitorClient( QObject * parent,
+                   DispHolder & disp_holder,
+                   const std::string & ring_name );
+
     ~MonitorClient();
 
     void disconnect();
@@ -166,6 +175,7 @@ public:
 private slots:
 
     void handleReceive();
+    void handleRingTimer();
     void handleTimer();
 
 signals:
@@ -59,8 +59,11 @@
 
 #ifdef Q_WS_WIN
 const QString Options::CONF_FILE = QDir::currentPath() + QDir::separator() + QString( "rcssmonitor.ini" );
+const QString Options::TEAM_GRAPHIC_CACHE_DIR = QDir::currentPath() + QDir::separator() + QString( "team_graphic" );
 #else
 const QString Options::CONF_FILE = QDir::homePath() + QDir::separator() + QString( ".rcssmonitor.conf" );
+const QString Options::TEAM_GRAPHIC_CACHE_DIR = QDir::homePath() + QDir::separator() + QString( ".rcssmonitor.d" )
+    + QDir::separator() + QString( "team_graphic" );
 #endif
 
 const double Options::PITCH_LENGTH = 105.0;
@@ -168,6 +171,8 @@ Options::Options()
     M_server_host( "127.0.0.1" ),
     M_server_port( 6000 ),
     M_client_version( 4 ),
+    M_wall_servers( "" ),
+    M_frame_ring( "" ),
     M_buffering_mode( false ),
     M_buffer_size( 10 ),
     M_max_disp_buffer( 65535 ),
@@ -176,6 +181,10 @@ Options::Options()
     M_auto_reconnect_mode( false ),
     M_auto_reconnect_wait( 5 ),
     M_timer_interval( DEFAULT_TIMER_INTERVAL ),
+    M_refresh_rate( 60 ),
+    M_gap_hold_time( 0 ),
+    M_cycle_stats( false ),
+    M_team_graphic_cache( true ),
     // window options
     M_window_x( -1 ),
     M_window_y( -1 ),
@@ -217,6 +226,11 @@ Options::Options()
     M_selected_number( 0 ),
     M_player_select_type( UNSELECT ),
     M_ball_vel_cycle( 0 ),
+    M_ball_trace_cycle( 0 ),
+    M_player_trace_cycle( 0 ),
+    M_player_trace_all( false ),
+    M_heat_map_type( HEAT_MAP_NONE ),
+    M_heat_map_cycle( 0 ),
       //
     M_buffer_recover_mode( true ),
       //
@@ -381,6 +395,9 @@ Options::readSettings()
     val = settings.value( "timer_interval" );
     if ( val.isValid() ) M_timer_interval = val.toInt();
 
+    val = settings.value( "team_graphic_cache" );
+    if ( val.isValid() ) M_team_graphic_cache = val.toBool();
+
     settings.endGroup();
 
     //
@@ -449,6 +466,18 @@ Options::readSettings()
     val = settings.value( "show_offside_line", M_show_offside_line );
     if ( val.isValid() ) M_show_offside_line = val.toBool();
 
+    val = settings.value( "ball_trace_cycle", M_ball_trace_cycle );
+    if ( val.isValid() ) M_ball_trace_cycle = val.toInt();
+
+    val = settings.value( "player_trace_cycle", M_player_trace_cycle );
+    if ( val.isValid() ) M_player_trace_cycle = val.toInt();
+
+    val = settings.value( "player_trace_all", M_player_trace_all );
+    if ( val.isValid() ) M_player_trace_all = val.toBool();
+
+    val = settings.value( "heat_map_cycle", M_heat_map_cycle );
+    if ( val.isValid() ) M_heat_map_cycle = val.toInt();
+
     settings.endGroup();
 
     //
@@ -671,6 +700,7 @@ Options::writeSettings( bool all )
         settings.setValue( "auto_quit_wait", M_auto_quit_wait );
         settings.setValue( "auto_reconnect_wait", M_auto_reconnect_wait );
         settings.setValue( "timer_interval", M_timer_interval );
+        settings.setValue( "team_graphic_cache", M_team_graphic_cache );
         settings.endGroup();
     }
 
@@ -698,6 +728,10 @@ Options::writeSettings( bool all )
     settings.setValue( "grid_step", M_grid_step );
     settings.setValue( "show_flag", M_show_flag );
     settings.setValue( "show_offside_line", M_show_offside_line );
+    settings.setValue( "ball_trace_cycle", M_ball_trace_cycle );
+    settings.setValue( "player_trace_cycle", M_player_trace_cycle );
+    settings.setValue( "player_trace_all", M_player_trace_all );
+    settings.setValue( "heat_map_cycle", M_heat_map_cycle );
     settings.endGroup();
 
     //
@@ -795,6 +829,12 @@ Options::parseCmdLine( int argc,
         ( "client-version",
           po::value< int >( &M_client_version )->default_value( M_client_version ),
           "set a monitor client protocol version." )
+        ( "wall-servers",
+          po::value< std::string >( &M_wall_servers )->default_value( M_wall_servers ),
+          "monitor the additional servers in the tiled view. e.g. --wall-servers=host1:6000,host2:6000" )
+        ( "frame-ring",
+          po::value< std::string >( &M_frame_ring )->default_value( M_frame_ring ),
+          "read the frames from the shared memory ring written by a local producer instead of the server. e.g. --frame-ring=/rcssmonitor" )
         ( "buffering-mode",
           po::value< bool >( &M_buffering_mode )->default_value( M_buffering_mode, to_onoff( M_buffering_mode ) ),
           "enable buffering mode." )
@@ -807,6 +847,15 @@ Options::parseCmdLine( int argc,
         ( "timer-interval",
           po::value< int >( &M_timer_interval )->default_value( M_timer_interval ),
           "set the desired timer interval [ms] for buffering mode." )
+        ( "refresh-rate",
+          po::value< int >( &M_refresh_rate )->default_value( M_refresh_rate ),
+          "set the display refresh rate [Hz] that limits the live repaints. 0 repaints for each received frame." )
+        ( "gap-hold-time",
+          po::value< int >( &M_gap_hold_time )->default_value( M_gap_hold_time ),
+          "set the max wait [ms] for the late show when the cycle gap is detected in buffering mode." )
+        ( "cycle-stats",
+          po::bool_switch( &M_cycle_stats )->default_value( M_cycle_stats ),
+          "print the cycle gaps, reordered and duplicated shows received from the server." )
         ( "auto-quit-mode",
           po::value< bool >( &M_auto_quit_mode )->default_value( M_auto_quit_mode, to_onoff( M_auto_quit_mode ) ),
           "enable automatic quit mode." )
@@ -819,6 +868,9 @@ Options::parseCmdLine( int argc,
         ( "auto-reconnect-wait",
           po::value< int >( &M_auto_reconnect_wait )->default_value( M_auto_reconnect_wait ),
           "set an wait period for the automatic reconnect mode." )
+        ( "team-graphic-cache",
+          po::value< bool >( &M_team_graphic_cache )->default_value( M_team_graphic_cache, to_onoff( M_team_graphic_cache ) ),
+          "save the assembled team graphics, and load them when the same team connects again." )
         // window options
         ( "geometry",
           po::value< std::string >( &geometry )->default_value( "" ),
@@ -908,6 +960,18 @@ Options::parseCmdLine( int argc,
         ( "show-offside-line",
           po::value< bool >( &M_show_offside_line )->default_value( M_show_offside_line, to_onoff( M_show_offside_line ) ),
           "show offside lines." )
+        ( "ball-trace-cycle",
+          po::value< int >( &M_ball_trace_cycle )->default_value( M_ball_trace_cycle ),
+          "set the length of the ball trail in cycles. 0 means no trail." )
+        ( "player-trace-cycle",
+          po::value< int >( &M_player_trace_cycle )->default_value( M_player_trace_cycle ),
+          "set the length of the player trails in cycles. 0 means no trail." )
+        ( "player-trace-all",
+          po::value< bool >( &M_player_trace_all )->default_value( M_player_trace_all, to_onoff( M_player_trace_all ) ),
+          "draw trails of all players instead of the selected player." )
+        ( "heat-map-cycle",
+          po::value< int >( &M_heat_map_cycle )->default_value( M_heat_map_cycle ),
+          "set the length of the heat map window in cycles. 0 means from the first cycle." )
         ;
 
     po::options_description invisibles( "Invisibles" );
@@ -992,6 +1056,34 @@ Options::parseCmdLine( int argc,
         M_timer_interval = 5000;
     }
 
+    if ( M_refresh_rate < 0 )
+    {
+        std::cerr << "Illegal refresh rate " << M_refresh_rate
+                  << ".  replaced by 0." << std::endl;
+        M_refresh_rate = 0;
+    }
+
+    if ( M_refresh_rate > 1000 )
+    {
+        std::cerr << "Too huge refresh rate " << M_refresh_rate
+                  << ".  replaced by 1000." << std::endl;
+        M_refresh_rate = 1000;
+    }
+
+    if ( M_gap_hold_time < 0 )
+    {
+        std::cerr << "Illegal gap hold time " << M_gap_hold_time
+                  << ".  replaced by 0." << std::endl;
+        M_gap_hold_time = 0;
+    }
+
+    if ( M_gap_hold_time > 1000 )
+    {
+        std::cerr << "Too huge gap hold time " << M_gap_hold_time
+                  << ".  replaced by 1000." << std::endl;
+        M_gap_hold_time = 1000;
+    }
+
     if ( ! geometry.empty() )
     {
         int w = -1, h = -1;
@@ -1202,39 +1294,8 @@ Options::updateFieldSize( const int canvas_width,
         // adjust field scale to window size.
         if ( ! zoomed() )
         {
-            double total_pitch_l = ( PITCH_LENGTH
-                                     + PITCH_MARGIN * 2.0
-                                     + 1.0 );
-            double total_pitch_w = ( PITCH_WIDTH
-                                     + PITCH_MARGIN * 2.0
-                                     //+ 1.0
-                                     );
-
-            M_field_scale = static_cast< double >( canvas_width ) / total_pitch_l;
-
-            int field_height = canvas_height;
-            if ( showTeamGraphic() )
-            {
-                field_height -= 32; //48; //64;
-            }
-            if ( showScoreBoard() )
-            {
-                field_height -= QFontMetrics( scoreBoardFont() ).ascent();
-            }
-
-            // automatically adjust a field scale
-            if ( total_pitch_w * fieldScale() > field_height )
-            {
-                M_field_scale = static_cast< double >( field_height ) / total_pitch_w;
-            }
-
-            // check the scale threshold
-            if ( fieldScale() < MIN_FIELD_SCALE )
-            {
-                M_field_scale = MIN_FIELD_SCALE;
-            }
-
-            M_field_scale = rint( M_field_scale * 100.0 ) / 100.0;
+            QPoint center;
+            getFittedTransform( canvas_width, canvas_height, center, M_field_scale );
         }
     }
 
@@ -1258,6 +1319,56 @@ Options::updateFieldSize( const int canvas_width,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Options::getFittedTransform( const int canvas_width,
+                             const int canvas_height,
+                             QPoint & field_center,
+                             double & field_scale ) const
+{
+    const double total_pitch_l = ( PITCH_LENGTH
+                                   + PITCH_MARGIN * 2.0
+                                   + 1.0 );
+    const double total_pitch_w = ( PITCH_WIDTH
+                                   + PITCH_MARGIN * 2.0
+                                   //+ 1.0
+                                   );
+
+    int field_height = canvas_height;
+    int team_graphic_height = 0;
+    if ( showTeamGraphic() )
+    {
+        team_graphic_height = 32; //48; //64;
+        field_height -= team_graphic_height;
+    }
+    if ( showScoreBoard() )
+    {
+        field_height -= QFontMetrics( scoreBoardFont() ).ascent();
+    }
+
+    field_scale = static_cast< double >( canvas_width ) / total_pitch_l;
+
+    // automatically adjust a field scale
+    if ( total_pitch_w * field_scale > field_height )
+    {
+        field_scale = static_cast< double >( field_height ) / total_pitch_w;
+    }
+
+    // check the scale threshold
+    if ( field_scale < MIN_FIELD_SCALE )
+    {
+        field_scale = MIN_FIELD_SCALE;
+    }
+
+    field_scale = rint( field_scale * 100.0 ) / 100.0;
+
+    field_center.setX( canvas_width / 2 );
+    field_center.setY( team_graphic_height + field_height / 2 );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
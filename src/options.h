@@ -54,6 +54,7 @@ class Options {
 public:
 
     static const QString CONF_FILE;
+    static const QString TEAM_GRAPHIC_CACHE_DIR;
 
     enum PlayerSelectType {
         SELECT_FIX,
@@ -69,6 +70,14 @@ public:
         FOCUS_POINT, // include center
     };
 
+    enum HeatMapType {
+        HEAT_MAP_NONE,
+        HEAT_MAP_LEFT,
+        HEAT_MAP_RIGHT,
+        HEAT_MAP_SELECTED,
+        HEAT_MAP_TYPE_SIZE,
+    };
+
     static const double PITCH_LENGTH;
     static const double PITCH_WIDTH;
     static const double PITCH_HALF_LENGTH;
@@ -143,6 +152,10 @@ private:
     std::string M_server_host;
     int M_server_port;
     int M_client_version;
+    //! comma separated "host[:port]" list of the additional servers shown in the wall.
+    std::string M_wall_servers;
+    //! shared memory name of the frame ring. if not empty, used instead of the server.
+    std::string M_frame_ring;
 
     //
     // monitor options
@@ -157,6 +170,10 @@ private:
     bool M_auto_reconnect_mode;
     int M_auto_reconnect_wait;
     int M_timer_interval; //!< logplayer timer interval
+    int M_refresh_rate; //!< display refresh rate [Hz] that paces the live repaints. 0 means no pacing.
+    int M_gap_hold_time; //!< max wait [ms] for the late show in buffering mode. 0 means no wait.
+    bool M_cycle_stats; //!< if true, the cycle gaps of the live shows are printed.
+    bool M_team_graphic_cache; //!< if true, assembled team graphics are saved and loaded.
 
     //
     // window options
@@ -225,6 +242,15 @@ private:
     // inertia movement
     int M_ball_vel_cycle; //!< specify the cycle to draw ball future point
 
+    // trace
+    int M_ball_trace_cycle; //!< length of the ball trail. 0 means no trail.
+    int M_player_trace_cycle; //!< length of the player trails. 0 means no trail.
+    bool M_player_trace_all; //!< if false, only the trail of the selected player is drawn.
+
+    // heat map
+    HeatMapType M_heat_map_type; //!< target players of the heat map
+    int M_heat_map_cycle; //!< length of the heat map window. 0 means from the first cycle.
+
     //
     // monitor state
     //
@@ -327,7 +353,11 @@ public:
     int serverPort() const { return M_server_port; }
     int clientVersion() const { return M_client_version; }
 
+    const std::string & wallServers() const { return M_wall_servers; }
+    const std::string & frameRing() const { return M_frame_ring; }
+
     bool bufferingMode() const { return M_buffering_mode; }
+    void setBufferingMode( const bool on ) { M_buffering_mode = on; }
     int bufferSize() const { return M_buffer_size; }
     int maxDispBuffer() const { return M_max_disp_buffer; }
 
@@ -338,6 +368,12 @@ public:
     int autoReconnectWait() const { return M_auto_reconnect_wait; }
 
     int timerInterval() const { return M_timer_interval; }
+    int refreshRate() const { return M_refresh_rate; }
+    int gapHoldTime() const { return M_gap_hold_time; }
+    bool cycleStats() const { return M_cycle_stats; }
+
+    bool teamGraphicCache() const { return M_team_graphic_cache; }
+    void setTeamGraphicCache( const bool on ) { M_team_graphic_cache = on; }
 
     //
     // window option
@@ -444,6 +480,19 @@ public:
     void updateFieldSize( const int canvas_width,
                           const int canvas_height );
 
+    /*!
+      \brief get the unzoomed transform that shows the whole field centered in the canvas.
+      the options are not changed.
+      \param canvas_width canvas width
+      \param canvas_height canvas height
+      \param field_center reference to the result variable
+      \param field_scale reference to the result variable
+     */
+    void getFittedTransform( const int canvas_width,
+                             const int canvas_height,
+                             QPoint & field_center,
+                             double & field_scale ) const;
+
     const double & fieldScale() const { return M_field_scale; }
     void setFieldScale( const double & value );
 
@@ -523,6 +572,41 @@ public:
           if ( 0 <= cycle && cycle <= 100 ) M_ball_vel_cycle = cycle;
       }
 
+    // trace
+
+    int ballTraceCycle() const { return M_ball_trace_cycle; }
+    void setBallTraceCycle( const int cycle )
+      {
+          if ( 0 <= cycle && cycle <= 6000 ) M_ball_trace_cycle = cycle;
+      }
+
+    int playerTraceCycle() const { return M_player_trace_cycle; }
+    void setPlayerTraceCycle( const int cycle )
+      {
+          if ( 0 <= cycle && cycle <= 6000 ) M_player_trace_cycle = cycle;
+      }
+
+    bool playerTraceAll() const { return M_player_trace_all; }
+    void togglePlayerTraceAll() { M_player_trace_all = ! M_player_trace_all; }
+
+    // heat map
+
+    HeatMapType heatMapType() const { return M_heat_map_type; }
+    void setHeatMapType( const HeatMapType type )
+      {
+          if ( HEAT_MAP_NONE <= type && type < HEAT_MAP_TYPE_SIZE ) M_heat_map_type = type;
+      }
+    void changeHeatMapType()
+      {
+          M_heat_map_type = static_cast< HeatMapType >( ( M_heat_map_type + 1 ) % HEAT_MAP_TYPE_SIZE );
+      }
+
+    int heatMapCycle() const { return M_heat_map_cycle; }
+    void setHeatMapCycle( const int cycle )
+      {
+          if ( 0 <= cycle && cycle <= 65535 ) M_heat_map_cycle = cycle;
+      }
+
     //
     //
     //
@@ -34,6 +34,7 @@
 #define RCSSMONITOR_PAINTER_INTERFADE_H
 
 class QPainter;
+class RenderSettings;
 
 class PainterInterface {
 protected:
@@ -47,8 +48,18 @@ protected:
 
 public:
 
+    /*!
+      \brief update the painter's own copy of the holder data, e.g. the history.
+      called by the render thread while it holds the read lock of DispHolder.
+      draw() is called after the lock is released, and must not access the holder.
+     */
     virtual
-    void draw( QPainter & painter ) = 0;
+    void prepare( const RenderSettings & )
+      { }
+
+    virtual
+    void draw( QPainter & painter,
+               const RenderSettings & settings ) = 0;
 
 };
 
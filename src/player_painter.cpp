@@ -38,8 +38,8 @@
 
 #include "player_painter.h"
 
-#include "disp_holder.h"
-#include "options.h"
+#include "render_frame.h"
+#include "render_settings.h"
 #include "circle_2d.h"
 #include "vector_2d.h"
 
@@ -51,6 +51,27 @@
 
 namespace {
 const double DEG2RAD = M_PI / 180.0;
+#if QT_VERSION >= 0x040700
+const size_t MAX_LABEL_CACHE = 256;
+#endif
+//! the glyphs of the old scales are discarded when the atlas becomes larger than this.
+const size_t MAX_SPRITE_CACHE = 4096;
+
+//! bit positions of the compacted body state. see PlayerPainter::bodyStyleIndex().
+const int STYLE_STAND = 0x0001;
+const int STYLE_KICK = 0x0002;
+const int STYLE_KICK_FAULT = 0x0004;
+const int STYLE_GOALIE = 0x0008;
+const int STYLE_CATCH = 0x0010;
+const int STYLE_CATCH_FAULT = 0x0020;
+const int STYLE_BALL_COLLIDE = 0x0040;
+const int STYLE_PLAYER_COLLIDE = 0x0080;
+const int STYLE_TACKLE = 0x0100;
+const int STYLE_TACKLE_FAULT = 0x0200;
+const int STYLE_FOUL_CHARGED = 0x0400;
+const int STYLE_SELECTED = 0x0800;
+const int STYLE_SIDE_SHIFT = 12;
+const int STYLE_TABLE_SIZE = 3 << STYLE_SIDE_SHIFT;
 }
 
 /*-------------------------------------------------------------------*/
@@ -61,11 +82,12 @@ inline
 PlayerPainter::Param::Param(  const rcss::rcg::PlayerT & player,
                               const rcss::rcg::BallT & ball,
                               const rcss::rcg::ServerParamT & sparam,
-                              const rcss::rcg::PlayerTypeT & ptype )
-    : x_( Options::instance().screenX( player.x_ ) )
-    , y_( Options::instance().screenY( player.y_ ) )
-    , body_radius_( Options::instance().scale( ptype.player_size_ ) )
-    , kick_radius_( Options::instance().scale( ptype.player_size_ + ptype.kickable_margin_ + sparam.ball_size_ ) )
+                              const rcss::rcg::PlayerTypeT & ptype,
+                              const RenderSettings & settings )
+    : x_( settings.screenX( player.x_ ) )
+    , y_( settings.screenY( player.y_ ) )
+    , body_radius_( settings.scale( ptype.player_size_ ) )
+    , kick_radius_( settings.scale( ptype.player_size_ + ptype.kickable_margin_ + sparam.ball_size_ ) )
       //, have_full_effort_( std::fabs( player.effort_ - ptype.effort_max_ ) < 1.0e-3 )
     , player_( player )
     , ball_( ball )
@@ -74,19 +96,24 @@ PlayerPainter::Param::Param(  const rcss::rcg::PlayerT & player,
     if ( body_radius_ < 1 ) body_radius_ = 1;
     if ( kick_radius_ < 5 ) kick_radius_ = 5;
 
-    draw_radius_ =  ( Options::instance().playerSize() >= 0.01
-                      ? Options::instance().scale( Options::instance().playerSize() )
+    draw_radius_ =  ( settings.playerSize() >= 0.01
+                      ? settings.scale( settings.playerSize() )
                       : kick_radius_ );
 }
 
+PlayerPainter::SpriteAtlas PlayerPainter::s_sprite_atlas;
+
 /*-------------------------------------------------------------------*/
 /*
 
  */
-PlayerPainter::PlayerPainter( const DispHolder & disp_holder )
-    : M_disp_holder( disp_holder )
+PlayerPainter::PlayerPainter( const RenderFrame & frame )
+    : M_frame( frame )
+    , M_sprite_settings_version( -1 )
+    , M_draw_players( &PlayerPainter::drawPlayers< 0 > )
+    , M_draw_players_settings_version( -1 )
 {
-
+    createBodyStyles();
 }
 
 /*-------------------------------------------------------------------*/
@@ -103,181 +130,344 @@ PlayerPainter::~PlayerPainter()
 
  */
 void
-PlayerPainter::draw( QPainter & painter )
+PlayerPainter::draw( QPainter & painter,
+                     const RenderSettings & settings )
 {
-    if ( ! Options::instance().showPlayer() )
+    if ( ! settings.showPlayer() )
     {
         return;
     }
 
-    DispConstPtr disp = M_disp_holder.currentDisp();
+    DispConstPtr disp = M_frame.currentDisp();
 
     if ( ! disp )
     {
         return;
     }
 
-    const rcss::rcg::BallT & ball = disp->show_.ball_;
+    updateDrawPlayers( settings );
+    updateBodySprites( settings );
+#if QT_VERSION >= 0x040700
+    updateLabels( settings );
+#endif
 
-    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
-    {
-        drawAll( painter, disp->show_.player_[i], ball );
-    }
+    ( this->*M_draw_players )( painter, disp->show_, settings );
 
-    if ( Options::instance().showOffsideLine() )
+    if ( settings.showOffsideLine() )
     {
-        drawOffsideLine( painter, disp->show_ );
+        drawOffsideLine( painter, M_frame.currentAnalysis(), settings );
     }
 }
 
 /*-------------------------------------------------------------------*/
-/*
-
+/*!
+  the player loop for one combination of the overlays.
+  the disabled overlays are removed at compile time, so only the player
+  state is tested in the loop.
  */
+template < int OVERLAYS >
 void
-PlayerPainter::drawAll( QPainter & painter,
-                        const rcss::rcg::PlayerT & player,
-                        const rcss::rcg::BallT & ball ) const
+PlayerPainter::drawPlayers( QPainter & painter,
+                            const rcss::rcg::ShowInfoT & show,
+                            const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-    const Param param( player,
-                       ball,
-                       M_disp_holder.serverParam(),
-                       M_disp_holder.playerType( player.type_ ) );
-
-    drawBody( painter, param );
-    drawDir( painter, param );
-
-    if ( player.hasNeck()
-         && player.hasView()
-         && opt.showViewArea() )
-    {
-        drawViewArea( painter, param );
-    }
+    const rcss::rcg::ServerParamT & sparam = M_frame.serverParam();
 
-    if ( player.isGoalie()
-         && opt.showCatchArea() )
+    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
     {
-        drawCatchArea( painter, param );
-    }
+        const rcss::rcg::PlayerT & player = show.player_[i];
+        const Param param( player,
+                           show.ball_,
+                           sparam,
+                           M_frame.playerType( player.type_ ),
+                           settings );
+
+        drawBody( painter, param, settings );
+        drawDir( painter, param, ! ( OVERLAYS & VIEW_AREA ), settings );
+
+        if ( ( OVERLAYS & VIEW_AREA )
+             && player.hasNeck()
+             && player.hasView() )
+        {
+            drawViewArea( painter, param, settings );
+        }
 
-    if ( opt.showTackleArea() )
-    {
-        drawTackleArea( painter, param );
+        if ( ( OVERLAYS & CATCH_AREA )
+             && player.isGoalie() )
+        {
+            drawCatchArea( painter, param, settings );
+        }
+
+        if ( OVERLAYS & TACKLE_AREA )
+        {
+            drawTackleArea( painter, param, settings );
+        }
+
+        if ( ( OVERLAYS & KICK_ACCEL_AREA )
+             && settings.selectedPlayer( player.side(), player.unum_ ) )
+        {
+            drawKickAccelArea( painter, param, settings );
+        }
+
+        if ( ( OVERLAYS & POINTTO )
+             && player.isPointing() )
+        {
+            drawPointto( painter, param, settings );
+        }
+
+        if ( OVERLAYS & PLAYER_TEXT )
+        {
+            drawText( painter, param, settings );
+        }
     }
+}
 
-    if ( opt.showKickAccelArea()
-         && opt.selectedPlayer( player.side(), player.unum_ ) )
+/*-------------------------------------------------------------------*/
+/*!
+  select the player loop instance for the enabled overlays.
+  the instance is selected only when a new settings snapshot is given.
+ */
+void
+PlayerPainter::updateDrawPlayers( const RenderSettings & settings )
+{
+#define RCSSMONITOR_DRAW_PLAYERS_4( n )                 \
+    &PlayerPainter::drawPlayers< (n) >,                 \
+        &PlayerPainter::drawPlayers< (n) + 1 >,         \
+        &PlayerPainter::drawPlayers< (n) + 2 >,         \
+        &PlayerPainter::drawPlayers< (n) + 3 >
+#define RCSSMONITOR_DRAW_PLAYERS_16( n )                \
+    RCSSMONITOR_DRAW_PLAYERS_4( (n) ),                  \
+        RCSSMONITOR_DRAW_PLAYERS_4( (n) + 4 ),          \
+        RCSSMONITOR_DRAW_PLAYERS_4( (n) + 8 ),          \
+        RCSSMONITOR_DRAW_PLAYERS_4( (n) + 12 )
+
+    static const DrawPlayersFunc s_draw_players[OVERLAY_COMBINATIONS] = {
+        RCSSMONITOR_DRAW_PLAYERS_16( 0 ),
+        RCSSMONITOR_DRAW_PLAYERS_16( 16 ),
+        RCSSMONITOR_DRAW_PLAYERS_16( 32 ),
+        RCSSMONITOR_DRAW_PLAYERS_16( 48 ),
+    };
+
+#undef RCSSMONITOR_DRAW_PLAYERS_16
+#undef RCSSMONITOR_DRAW_PLAYERS_4
+
+    if ( settings.version() == M_draw_players_settings_version )
     {
-        drawKickAccelArea( painter, param );
+        return;
     }
-
-    if ( player.isPointing()
-         && opt.showPointto() )
+    M_draw_players_settings_version = settings.version();
+
+    int overlays = 0;
+    if ( settings.showViewArea() ) overlays |= VIEW_AREA;
+    if ( settings.showCatchArea() ) overlays |= CATCH_AREA;
+    if ( settings.showTackleArea() ) overlays |= TACKLE_AREA;
+    if ( settings.showKickAccelArea() ) overlays |= KICK_ACCEL_AREA;
+    if ( settings.showPointto() ) overlays |= POINTTO;
+    if ( settings.showPlayerNumber()
+         || settings.showStamina()
+         || settings.showStaminaCapacity()
+         || settings.showPlayerType()
+         || settings.showCard() )
     {
-        drawPointto( painter, param );
+        overlays |= PLAYER_TEXT;
     }
 
-    drawText( painter, param );
+    M_draw_players = s_draw_players[overlays];
 }
 
 /*-------------------------------------------------------------------*/
-/*
+/*!
+  compact the status bits used by the body glyph into the index of
+  M_body_styles. no branch is needed except the side.
+ */
+int
+PlayerPainter::bodyStyleIndex( const rcss::rcg::PlayerT & player,
+                               const bool selected )
+{
+    const int side = ( player.side_ == 'l' ? 1
+                       : player.side_ == 'r' ? 2
+                       : 0 );
+
+    // STAND, KICK, KICK_FAULT, GOALIE, CATCH and CATCH_FAULT keep their positions.
+    // BALL_COLLIDE, PLAYER_COLLIDE, TACKLE and TACKLE_FAULT are adjacent bits.
+    return ( ( player.state_ & 0x0000003f )
+             | ( ( player.state_ >> 4 ) & 0x000003c0 )
+             | ( ( player.state_ >> 7 ) & STYLE_FOUL_CHARGED )
+             | ( selected ? STYLE_SELECTED : 0 )
+             | ( side << STYLE_SIDE_SHIFT ) );
+}
 
+/*-------------------------------------------------------------------*/
+/*!
+  resolve the final pen and brush for all combinations of the state bits.
+  the later status overrides the former one, in the same order as the
+  colors have been applied to the painter one by one.
  */
 void
-PlayerPainter::drawBody( QPainter & painter,
-                         const PlayerPainter::Param & param ) const
+PlayerPainter::createBodyStyles()
 {
-    const Options & opt = Options::instance();
+    M_body_styles.resize( STYLE_TABLE_SIZE );
 
-    // decide base color
-    if ( opt.selectedPlayer( param.player_.side(), param.player_.unum_ ) )
+    for ( int i = 0; i < STYLE_TABLE_SIZE; ++i )
     {
-        painter.setPen( opt.selectedPlayerPen() );
-    }
-    else
-    {
-        painter.setPen( opt.playerPen() );
-    }
-
-    switch ( param.player_.side_ ) {
-    case 'l':
-        if ( param.player_.isGoalie() )
-        {
-            painter.setBrush( opt.leftGoalieBrush() );
+        BodyStyle & style = M_body_styles[i];
+
+        // decide base color
+        style.pen_ = ( i & STYLE_SELECTED ) ? PEN_SELECTED : PEN_PLAYER;
+
+        switch ( i >> STYLE_SIDE_SHIFT ) {
+        case 1:
+            style.brush_ = ( i & STYLE_GOALIE ) ? BRUSH_LEFT_GOALIE : BRUSH_LEFT_TEAM;
+            break;
+        case 2:
+            style.brush_ = ( i & STYLE_GOALIE ) ? BRUSH_RIGHT_GOALIE : BRUSH_RIGHT_TEAM;
+            break;
+        default:
+            style.brush_ = BRUSH_BLACK;
+            break;
         }
-        else
-        {
-            painter.setBrush( opt.leftTeamBrush() );
-        }
-        break;
-    case 'r':
-        if ( param.player_.isGoalie() )
+
+        // decide status color
+        if ( ! ( i & STYLE_STAND ) ) style.brush_ = BRUSH_BLACK;
+        if ( i & STYLE_KICK ) style.pen_ = PEN_KICK;
+        if ( i & STYLE_KICK_FAULT ) style.brush_ = BRUSH_KICK_FAULT;
+        if ( i & STYLE_CATCH ) style.brush_ = BRUSH_CATCH;
+        if ( i & STYLE_CATCH_FAULT ) style.brush_ = BRUSH_CATCH_FAULT;
+        if ( i & STYLE_TACKLE )
         {
-            painter.setBrush( opt.rightGoalieBrush() );
+            style.pen_ = PEN_TACKLE;
+            style.brush_ = BRUSH_TACKLE;
         }
-        else
+        if ( i & STYLE_TACKLE_FAULT )
         {
-            painter.setBrush( opt.rightTeamBrush() );
+            style.pen_ = PEN_TACKLE;
+            style.brush_ = BRUSH_TACKLE_FAULT;
         }
-        break;
-    case 'n':
-        //std::cerr << "drawBody neutral unum=" << param.player_.unum_ << std::endl;
-        painter.setBrush( Qt::black );
-        break;
-    default:
-        painter.setBrush( Qt::black );
-        break;
+        if ( i & STYLE_FOUL_CHARGED ) style.brush_ = BRUSH_FOUL_CHARGED;
+        if ( i & STYLE_BALL_COLLIDE ) style.brush_ = BRUSH_BALL_COLLIDE;
+        if ( i & STYLE_PLAYER_COLLIDE ) style.brush_ = BRUSH_PLAYER_COLLIDE;
     }
+}
 
-
-    // decide status color
-    if ( ! param.player_.isAlive() )
-    {
-        painter.setBrush( Qt::black );
-    }
-    if ( param.player_.isKicking() )
-    {
-        painter.setPen( opt.kickPen() );
-    }
-    if ( param.player_.isKickingFault() )
-    {
-        painter.setBrush( opt.kickFaultBrush() );
-    }
-    if ( param.player_.isCatching() )
-    {
-        painter.setBrush( opt.catchBrush() );
-    }
-    if ( param.player_.isCatchingFault() )
-    {
-        painter.setBrush( opt.catchFaultBrush() );
-    }
-    if ( param.player_.isTackling() )
+/*-------------------------------------------------------------------*/
+/*!
+  check the colors used by the body glyphs of the shared atlas.
+  if any of them has been changed, all glyphs are discarded.
+  nothing is compared while the same settings snapshot is used.
+ */
+void
+PlayerPainter::updateBodySprites( const RenderSettings & settings )
+{
+    if ( settings.version() == M_sprite_settings_version )
     {
-        painter.setPen( opt.tacklePen() );
-        painter.setBrush( opt.tackleBrush() );
+        return;
     }
-    if ( param.player_.isTacklingFault() )
+    M_sprite_settings_version = settings.version();
+
+    M_body_pens[PEN_PLAYER] = settings.playerPen();
+    M_body_pens[PEN_SELECTED] = settings.selectedPlayerPen();
+    M_body_pens[PEN_KICK] = settings.kickPen();
+    M_body_pens[PEN_TACKLE] = settings.tacklePen();
+
+    M_body_brushes[BRUSH_BLACK] = QBrush( Qt::black );
+    M_body_brushes[BRUSH_LEFT_TEAM] = settings.leftTeamBrush();
+    M_body_brushes[BRUSH_LEFT_GOALIE] = settings.leftGoalieBrush();
+    M_body_brushes[BRUSH_RIGHT_TEAM] = settings.rightTeamBrush();
+    M_body_brushes[BRUSH_RIGHT_GOALIE] = settings.rightGoalieBrush();
+    M_body_brushes[BRUSH_KICK_FAULT] = settings.kickFaultBrush();
+    M_body_brushes[BRUSH_CATCH] = settings.catchBrush();
+    M_body_brushes[BRUSH_CATCH_FAULT] = settings.catchFaultBrush();
+    M_body_brushes[BRUSH_TACKLE] = settings.tackleBrush();
+    M_body_brushes[BRUSH_TACKLE_FAULT] = settings.tackleFaultBrush();
+    M_body_brushes[BRUSH_FOUL_CHARGED] = settings.foulChargedBrush();
+    M_body_brushes[BRUSH_BALL_COLLIDE] = settings.ballCollideBrush();
+    M_body_brushes[BRUSH_PLAYER_COLLIDE] = settings.playerCollideBrush();
+
+    const QPen * pens[] = {
+        &settings.playerPen(),
+        &settings.selectedPlayerPen(),
+        &settings.kickPen(),
+        &settings.tacklePen(),
+        &settings.effortDecayedPen(),
+        &settings.recoveryDecayedPen(),
+    };
+    const QBrush * brushes[] = {
+        &settings.leftTeamBrush(),
+        &settings.leftGoalieBrush(),
+        &settings.rightTeamBrush(),
+        &settings.rightGoalieBrush(),
+        &settings.kickFaultBrush(),
+        &settings.catchBrush(),
+        &settings.catchFaultBrush(),
+        &settings.tackleBrush(),
+        &settings.tackleFaultBrush(),
+        &settings.foulChargedBrush(),
+        &settings.ballCollideBrush(),
+        &settings.playerCollideBrush(),
+    };
+
+    std::vector< double > signature;
+    signature.reserve( 32 );
+
+    // the scale is a part of the glyph key, so that the canvases of
+    // the different scales can share the atlas.
+    signature.push_back( settings.antiAliasing() ? 1.0 : 0.0 );
+    for ( size_t i = 0; i < sizeof( pens ) / sizeof( pens[0] ); ++i )
     {
-        painter.setPen( opt.tacklePen() );
-        painter.setBrush( opt.tackleFaultBrush() );
+        signature.push_back( pens[i]->color().rgba() );
+        signature.push_back( pens[i]->width() );
     }
-    if ( param.player_.isFoulCharged() )
+    for ( size_t i = 0; i < sizeof( brushes ) / sizeof( brushes[0] ); ++i )
     {
-        painter.setBrush( opt.foulChargedBrush() );
+        signature.push_back( brushes[i]->color().rgba() );
     }
-    if ( param.player_.isCollidedBall() )
+
+    QMutexLocker lock( &s_sprite_atlas.mutex_ );
+    if ( signature != s_sprite_atlas.signature_ )
     {
-        painter.setBrush( opt.ballCollideBrush() );
+        s_sprite_atlas.signature_.swap( signature );
+        s_sprite_atlas.sprites_.clear();
     }
-    if ( param.player_.isCollidedPlayer() )
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  render the body glyph centered in a transparent image.
+  QImage is used instead of QPixmap, because the painter may be driven
+  by the render worker thread.
+ */
+QImage
+PlayerPainter::createBodySprite( const PlayerPainter::Param & param,
+                                 const BodyStyle & style,
+                                 const int stamina_level,
+                                 const int decay_ring,
+                                 const RenderSettings & settings ) const
+{
+    const int pen_width = std::max( std::max( std::max( settings.playerPen().width(),
+                                                        settings.selectedPlayerPen().width() ),
+                                              std::max( settings.kickPen().width(),
+                                                        settings.tacklePen().width() ) ),
+                                    std::max( settings.effortDecayedPen().width(),
+                                              settings.recoveryDecayedPen().width() ) );
+    const int half = std::max( param.draw_radius_ + 2, param.body_radius_ ) + pen_width + 2;
+
+    QImage image( half * 2 + 1, half * 2 + 1, QImage::Format_ARGB32_Premultiplied );
+    image.fill( 0 );
+
+    QPainter painter( &image );
+    if ( settings.antiAliasing() )
     {
-        painter.setBrush( opt.playerCollideBrush() );
+        painter.setRenderHint( QPainter::Antialiasing );
     }
 
-    painter.drawEllipse( param.x_ - param.draw_radius_ ,
-                         param.y_ - param.draw_radius_ ,
+    const int x = half;
+    const int y = half;
+
+    painter.setPen( M_body_pens[style.pen_] );
+    painter.setBrush( M_body_brushes[style.brush_] );
+
+    painter.drawEllipse( x - param.draw_radius_ ,
+                         y - param.draw_radius_ ,
                          param.draw_radius_ * 2 ,
                          param.draw_radius_ * 2 );
 
@@ -285,59 +475,129 @@ PlayerPainter::drawBody( QPainter & painter,
     if ( param.player_.hasStamina() )
     {
 #if QT_VERSION >= 0x040300
-        double stamina_rate = param.player_.stamina_ / M_disp_holder.serverParam().stamina_max_;
-        int dark_rate = 200 - static_cast< int >( rint( 200 * rint( stamina_rate / 0.125 ) * 0.125 ) );
-        dark_rate = std::max( 0, dark_rate - 50 );
-
         painter.setPen( Qt::NoPen );
-        if ( dark_rate == 0 )
+        if ( stamina_level == 0 )
         {
             painter.setBrush( painter.brush() );
         }
         else
         {
-            painter.setBrush( painter.brush().color().darker( 100 + dark_rate ) );
+            painter.setBrush( painter.brush().color().darker( 100 + stamina_level ) );
         }
-        painter.drawEllipse( param.x_ - param.body_radius_,
-                             param.y_ - param.body_radius_,
+        painter.drawEllipse( x - param.body_radius_,
+                             y - param.body_radius_,
                              param.body_radius_ * 2 ,
                              param.body_radius_ * 2  );
 #else
-        if ( param.player_.stamina_ < 1500.0f )
+        if ( stamina_level != 0 )
         {
             painter.setPen( Qt::NoPen );
             painter.setBrush( Qt::black );
-            painter.drawEllipse( param.x_ - param.body_radius_,
-                                 param.y_ - param.body_radius_,
+            painter.drawEllipse( x - param.body_radius_,
+                                 y - param.body_radius_,
                                  param.body_radius_ * 2 ,
                                  param.body_radius_ * 2  );
         }
 #endif
 
-        if ( std::fabs( param.player_.effort_ - param.player_type_.effort_max_ ) > 1.0e-4 )
+        if ( decay_ring == 1 )
         {
             int r = param.draw_radius_ + 2;
-            painter.setPen( opt.effortDecayedPen() );
+            painter.setPen( settings.effortDecayedPen() );
             painter.setBrush( Qt::NoBrush );
-            painter.drawEllipse( param.x_ - r, param.y_ - r, r * 2, r * 2 );
+            painter.drawEllipse( x - r, y - r, r * 2, r * 2 );
         }
-        else if ( std::fabs( param.player_.recovery_ - M_disp_holder.serverParam().recover_init_ ) > 1.0e-4 )
+        else if ( decay_ring == 2 )
         {
             int r = param.draw_radius_ + 2;
-            painter.setPen( opt.recoveryDecayedPen() );
+            painter.setPen( settings.recoveryDecayedPen() );
             painter.setBrush( Qt::NoBrush );
-            painter.drawEllipse( param.x_ - r, param.y_ - r, r * 2, r * 2 );
+            painter.drawEllipse( x - r, y - r, r * 2, r * 2 );
         }
     }
 
     // draw real body edge
-    painter.setPen( opt.playerPen() );
+    painter.setPen( settings.playerPen() );
     painter.setBrush( Qt::NoBrush );
-    painter.drawEllipse( param.x_ - param.body_radius_,
-                         param.y_ - param.body_radius_,
+    painter.drawEllipse( x - param.body_radius_,
+                         y - param.body_radius_,
                          param.body_radius_ * 2 ,
                          param.body_radius_ * 2  );
 
+    painter.end();
+    return image;
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  draw the body glyph taken from the sprite atlas.
+  a new glyph is rendered only when the combination of
+  resolved pen and brush, stamina level and radius is seen for the first time.
+ */
+void
+PlayerPainter::drawBody( QPainter & painter,
+                         const PlayerPainter::Param & param,
+                         const RenderSettings & settings ) const
+{
+    const bool selected = settings.selectedPlayer( param.player_.side(), param.player_.unum_ );
+
+    int stamina_level = 0;
+    int decay_ring = 0;
+    if ( param.player_.hasStamina() )
+    {
+#if QT_VERSION >= 0x040300
+        double stamina_rate = param.player_.stamina_ / M_frame.serverParam().stamina_max_;
+        int dark_rate = 200 - static_cast< int >( rint( 200 * rint( stamina_rate / 0.125 ) * 0.125 ) );
+        stamina_level = std::max( 0, dark_rate - 50 );
+#else
+        stamina_level = ( param.player_.stamina_ < 1500.0f ? 1 : 0 );
+#endif
+
+        if ( std::fabs( param.player_.effort_ - param.player_type_.effort_max_ ) > 1.0e-4 )
+        {
+            decay_ring = 1;
+        }
+        else if ( std::fabs( param.player_.recovery_ - M_frame.serverParam().recover_init_ ) > 1.0e-4 )
+        {
+            decay_ring = 2;
+        }
+    }
+
+    // the glyphs are shared by the states resolved to the same pen and brush.
+    const BodyStyle & style = M_body_styles[bodyStyleIndex( param.player_, selected )];
+    const SpriteKey key( style.pen_
+                         | ( style.brush_ << 4 )
+                         | ( ( param.player_.hasStamina() ? 1 : 0 ) << 8 )
+                         | ( decay_ring << 9 ),
+                         stamina_level,
+                         param.body_radius_,
+                         param.draw_radius_ );
+
+    QImage sprite;
+    {
+        QMutexLocker lock( &s_sprite_atlas.mutex_ );
+        SpriteMap::const_iterator it = s_sprite_atlas.sprites_.find( key );
+        if ( it != s_sprite_atlas.sprites_.end() )
+        {
+            sprite = it->second;
+        }
+    }
+
+    if ( sprite.isNull() )
+    {
+        // the glyph is rendered without the lock. the other canvas may add the same one.
+        sprite = createBodySprite( param, style, stamina_level, decay_ring, settings );
+
+        QMutexLocker lock( &s_sprite_atlas.mutex_ );
+        if ( s_sprite_atlas.sprites_.size() >= MAX_SPRITE_CACHE )
+        {
+            s_sprite_atlas.sprites_.clear();
+        }
+        s_sprite_atlas.sprites_.insert( SpriteMap::value_type( key, sprite ) );
+    }
+
+    const int half = sprite.width() / 2;
+    painter.drawImage( param.x_ - half, param.y_ - half, sprite );
 }
 
 /*-------------------------------------------------------------------*/
@@ -346,34 +606,34 @@ PlayerPainter::drawBody( QPainter & painter,
  */
 void
 PlayerPainter::drawDir( QPainter & painter,
-                        const PlayerPainter::Param & param ) const
+                        const PlayerPainter::Param & param,
+                        const bool draw_neck,
+                        const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-
     // body direction line
     double real_r
         = param.player_type_.player_size_
         + param.player_type_.kickable_margin_
-        + M_disp_holder.serverParam().ball_size_;
+        + M_frame.serverParam().ball_size_;
     double body = param.player_.body_ * DEG2RAD;
 
-    int bx = opt.screenX( param.player_.x_ + real_r * std::cos( body ) );
-    int by = opt.screenY( param.player_.y_ + real_r * std::sin( body ) );
+    int bx = settings.screenX( param.player_.x_ + real_r * std::cos( body ) );
+    int by = settings.screenY( param.player_.y_ + real_r * std::sin( body ) );
 
-    painter.setPen( opt.playerPen() );
+    painter.setPen( settings.playerPen() );
     painter.setBrush( Qt::NoBrush );
     painter.drawLine( param.x_, param.y_, bx, by );
 
-    if ( param.player_.hasNeck()
-         && ! opt.showViewArea() )
+    if ( draw_neck
+         && param.player_.hasNeck() )
     {
         double head = param.player_.body_ + param.player_.neck_;
         head *= DEG2RAD;
 
-        int nx = opt.screenX( param.player_.x_ + real_r * std::cos( head ) );
-        int ny = opt.screenY( param.player_.y_ + real_r * std::sin( head ) );
+        int nx = settings.screenX( param.player_.x_ + real_r * std::cos( head ) );
+        int ny = settings.screenY( param.player_.y_ + real_r * std::sin( head ) );
 
-        painter.setPen( opt.neckPen() );
+        painter.setPen( settings.neckPen() );
         painter.setBrush( Qt::NoBrush );
         painter.drawLine( param.x_, param.y_, nx, ny );
     }
@@ -386,25 +646,24 @@ PlayerPainter::drawDir( QPainter & painter,
  */
 void
 PlayerPainter::drawViewArea( QPainter & painter,
-                             const PlayerPainter::Param & param ) const
+                             const PlayerPainter::Param & param,
+                             const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-
-    const int visible_radius = opt.scale( M_disp_holder.serverParam().visible_distance_ );
+    const int visible_radius = settings.scale( M_frame.serverParam().visible_distance_ );
     const double head = param.player_.body_ + param.player_.neck_;
     const int view_start_angle = static_cast< int >( rint( ( -head - param.player_.view_width_ * 0.5 ) * 16 ) );
     const int span_angle = static_cast< int >( rint( param.player_.view_width_ * 16 ) );
 
 
-    if ( opt.selectedPlayer( param.player_.side(),
-                             param.player_.unum_ ) )
+    if ( settings.selectedPlayer( param.player_.side(),
+                                  param.player_.unum_ ) )
     {
         // draw large view area
-        const int UNUM_FAR = opt.scale( 20.0 );
-        const int TEAM_FAR = opt.scale( 40.0 );
-        const int TEAM_TOOFAR = opt.scale( 60.0 );
+        const int UNUM_FAR = settings.scale( 20.0 );
+        const int TEAM_FAR = settings.scale( 40.0 );
+        const int TEAM_TOOFAR = settings.scale( 60.0 );
 
-        painter.setPen( opt.largeViewAreaPen() );
+        painter.setPen( settings.largeViewAreaPen() );
         painter.setBrush( Qt::NoBrush );
 
         painter.drawArc( param.x_ - UNUM_FAR, // left x
@@ -439,16 +698,16 @@ PlayerPainter::drawViewArea( QPainter & painter,
         const double view_end_angle_real = ( head + param.player_.view_width_ * 0.5 ) * DEG2RAD;;
         // left side view cone end point x
         int lx = param.x_
-            + opt.scale( 60.0 * std::cos( view_start_angle_real ) );
+            + settings.scale( 60.0 * std::cos( view_start_angle_real ) );
         // left side view cone end point y
         int ly = param.y_
-            + opt.scale( 60.0  * std::sin( view_start_angle_real ) );
+            + settings.scale( 60.0  * std::sin( view_start_angle_real ) );
         // right side view cone end point x
         int rx = param.x_
-            + opt.scale( 60.0 * std::cos( view_end_angle_real ) );
+            + settings.scale( 60.0 * std::cos( view_end_angle_real ) );
         // right side view cone end point y
         int ry = param.y_
-            + opt.scale( 60.0 * std::sin( view_end_angle_real ) );
+            + settings.scale( 60.0 * std::sin( view_end_angle_real ) );
         painter.drawLine( lx, ly, param.x_, param.y_ );
         painter.drawLine( rx, ry, param.x_, param.y_ );
 
@@ -456,7 +715,7 @@ PlayerPainter::drawViewArea( QPainter & painter,
     else
     {
         // draw small view area
-        painter.setPen( opt.viewAreaPen() );
+        painter.setPen( settings.viewAreaPen() );
         painter.setBrush( Qt::NoBrush );
 
         painter.drawPie( param.x_ - visible_radius,
@@ -474,13 +733,13 @@ PlayerPainter::drawViewArea( QPainter & painter,
  */
 void
 PlayerPainter::drawCatchArea( QPainter & painter,
-                              const PlayerPainter::Param & param ) const
+                              const PlayerPainter::Param & param,
+                              const RenderSettings & settings ) const
 {
     //
     // goalie's catchable area
     //
-    const Options & opt = Options::instance();
-    const rcss::rcg::ServerParamT & SP = M_disp_holder.serverParam();
+    const rcss::rcg::ServerParamT & SP = M_frame.serverParam();
 
     //
     // catchable area
@@ -489,10 +748,10 @@ PlayerPainter::drawCatchArea( QPainter & painter,
     const double catchable_area
         = std::sqrt( std::pow( SP.catchable_area_w_ * 0.5, 2.0 )
                      + std::pow( SP.catchable_area_l_, 2.0 ) );
-    const int catchable = opt.scale( catchable_area );
+    const int catchable = settings.scale( catchable_area );
     painter.setPen( ( param.player_.side_ == 'l' )
-                    ? opt.leftGoaliePen()
-                    : opt.rightGoaliePen() );
+                    ? settings.leftGoaliePen()
+                    : settings.rightGoaliePen() );
     painter.setBrush( Qt::NoBrush );
     painter.drawEllipse( param.x_ - catchable,
                          param.y_ - catchable,
@@ -505,12 +764,12 @@ PlayerPainter::drawCatchArea( QPainter & painter,
     const double max_area
         = std::sqrt( std::pow( SP.catchable_area_w_ * 0.5, 2.0 )
                      + std::pow( max_catchable_area_l, 2.0 ) );
-    const int max_r = opt.scale( max_area );
+    const int max_r = settings.scale( max_area );
     if ( max_r > catchable )
     {
         painter.setPen( ( param.player_.side_ == 'l' )
-                        ? opt.leftGoalieStretchPen()
-                        : opt.rightGoalieStretchPen() );
+                        ? settings.leftGoalieStretchPen()
+                        : settings.rightGoalieStretchPen() );
         painter.drawEllipse( param.x_ - max_r,
                              param.y_ - max_r,
                              max_r * 2,
@@ -522,7 +781,7 @@ PlayerPainter::drawCatchArea( QPainter & painter,
         const double min_area
             = std::sqrt( std::pow( SP.catchable_area_w_ * 0.5, 2.0 )
                          + std::pow( min_catchable_area_l, 2.0 ) );
-        const int min_r = opt.scale( min_area );
+        const int min_r = settings.scale( min_area );
         painter.drawEllipse( param.x_ - min_r,
                              param.y_ - min_r,
                              min_r * 2,
@@ -555,9 +814,9 @@ PlayerPainter::drawCatchArea( QPainter & painter,
     int text_radius = std::min( 40, param.draw_radius_ );
 
     painter.setPen( ( param.player_.side_ == 'l' )
-                    ? opt.rightGoaliePen()
-                    : opt.leftGoaliePen() );
-    painter.setFont( opt.playerFont() );
+                    ? settings.rightGoaliePen()
+                    : settings.leftGoaliePen() );
+    painter.setFont( settings.playerFont() );
     painter.drawText( param.x_ + text_radius,
                       param.y_ + ( 2 + painter.fontMetrics().ascent() ) * 2,
                       QString( "Catch=%1" ).arg( catch_prob, 0, 'g', 3 ) );
@@ -570,14 +829,14 @@ PlayerPainter::drawCatchArea( QPainter & painter,
  */
 void
 PlayerPainter::drawTackleArea( QPainter & painter,
-                               const PlayerPainter::Param & param ) const
+                               const PlayerPainter::Param & param,
+                               const RenderSettings & settings ) const
 {
     //
     // draw tackle area & probability
     //
 
-    const Options & opt = Options::instance();
-    const rcss::rcg::ServerParamT & SP = M_disp_holder.serverParam();
+    const rcss::rcg::ServerParamT & SP = M_frame.serverParam();
 
     Vector2D ppos( param.player_.x_,
                    param.player_.y_ );
@@ -611,19 +870,19 @@ PlayerPainter::drawTackleArea( QPainter & painter,
         painter.translate( param.x_, param.y_ );
         painter.rotate( param.player_.body_ );
 
-        painter.setPen( opt.tacklePen() );
+        painter.setPen( settings.tacklePen() );
         painter.setBrush( Qt::NoBrush );
 
-        painter.drawRect( opt.scale( - SP.tackle_back_dist_ ),
-                          opt.scale( - SP.tackle_width_ ),
-                          opt.scale( SP.tackle_dist_ + SP.tackle_back_dist_ ),
-                          opt.scale( SP.tackle_width_ * 2.0 ) );
+        painter.drawRect( settings.scale( - SP.tackle_back_dist_ ),
+                          settings.scale( - SP.tackle_width_ ),
+                          settings.scale( SP.tackle_dist_ + SP.tackle_back_dist_ ),
+                          settings.scale( SP.tackle_width_ * 2.0 ) );
         painter.restore();
 
         int text_radius = std::min( 40, param.draw_radius_ );
 
-        painter.setFont( opt.playerFont() );
-        painter.setPen( opt.tacklePen() );
+        painter.setFont( settings.playerFont() );
+        painter.setPen( settings.tacklePen() );
 
         if ( tackle_fail_prob < 1.0
              && foul_fail_prob < 1.0 )
@@ -657,7 +916,8 @@ PlayerPainter::drawTackleArea( QPainter & painter,
  */
 void
 PlayerPainter::drawKickAccelArea( QPainter & painter,
-                                  const PlayerPainter::Param & param ) const
+                                  const PlayerPainter::Param & param,
+                                  const RenderSettings & settings ) const
 {
     //
     // draw kick accel area
@@ -668,8 +928,7 @@ PlayerPainter::drawKickAccelArea( QPainter & painter,
         return;
     }
 
-    const Options & opt = Options::instance();
-    const rcss::rcg::ServerParamT & SP = M_disp_holder.serverParam();
+    const rcss::rcg::ServerParamT & SP = M_frame.serverParam();
 
     Vector2D ppos( param.player_.x_,
                    param.player_.y_ );
@@ -705,14 +964,14 @@ PlayerPainter::drawKickAccelArea( QPainter & painter,
     Vector2D bnext( bpos.x + param.ball_.vx_,
                     bpos.y + param.ball_.vy_ );
 
-    QPoint bpos_screen( opt.screenX( bpos.x ),
-                        opt.screenY( bpos.y ) );
-    QPoint bnext_screen( opt.screenX( bnext.x ),
-                         opt.screenY( bnext.y ) );
-    int max_speed_screen = opt.scale( SP.ball_speed_max_ );
-    int max_kick_accel_screen = opt.scale( max_kick_accel );
+    QPoint bpos_screen( settings.screenX( bpos.x ),
+                        settings.screenY( bpos.y ) );
+    QPoint bnext_screen( settings.screenX( bnext.x ),
+                         settings.screenY( bnext.y ) );
+    int max_speed_screen = settings.scale( SP.ball_speed_max_ );
+    int max_kick_accel_screen = settings.scale( max_kick_accel );
 
-    painter.setPen( opt.kickAccelPen() );
+    painter.setPen( settings.kickAccelPen() );
     painter.setBrush( Qt::NoBrush );
 
     // draw no noise ball move line
@@ -814,8 +1073,8 @@ PlayerPainter::drawKickAccelArea( QPainter & painter,
     }
 
     // draw kick info text
-    painter.setFont( opt.playerFont() );
-    painter.setPen( opt.kickAccelPen() );
+    painter.setFont( settings.playerFont() );
+    painter.setPen( settings.kickAccelPen() );
 
     char buf[32];
     snprintf( buf, 32, "MaxAccel=%.3f", max_kick_accel );
@@ -830,14 +1089,13 @@ PlayerPainter::drawKickAccelArea( QPainter & painter,
  */
 void
 PlayerPainter::drawPointto( QPainter & painter,
-                            const PlayerPainter::Param & param ) const
+                            const PlayerPainter::Param & param,
+                            const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-
-    int ix = opt.screenX( param.player_.point_x_ );
-    int iy = opt.screenY( param.player_.point_y_ );
+    int ix = settings.screenX( param.player_.point_x_ );
+    int iy = settings.screenY( param.player_.point_y_ );
 
-    painter.setPen( opt.pointtoPen() );
+    painter.setPen( settings.pointtoPen() );
     painter.setBrush( Qt::NoBrush );
     painter.drawLine( param.x_, param.y_, ix, iy );
     painter.drawLine( ix - 2, iy - 2, ix + 2, iy + 2 );
@@ -850,14 +1108,16 @@ PlayerPainter::drawPointto( QPainter & painter,
  */
 void
 PlayerPainter::drawText( QPainter & painter,
-                         const PlayerPainter::Param & param ) const
+                         const PlayerPainter::Param & param,
+                         const RenderSettings & settings ) const
 {
-    const Options & opt = Options::instance();
-
     char main_buf[64];
     std::memset( main_buf, 0, 64 );
 
-    if ( opt.showPlayerNumber() )
+    // the stamina values change almost every cycle.
+    bool stable_text = true;
+
+    if ( settings.showPlayerNumber() )
     {
         char buf[8];
         snprintf( buf, 8, "%d", param.player_.unum_ );
@@ -865,22 +1125,24 @@ PlayerPainter::drawText( QPainter & painter,
     }
 
     if ( param.player_.hasStamina()
-         && opt.showStamina() )
+         && settings.showStamina() )
     {
         char buf[16];
         snprintf( buf, 16, "%4.0f", param.player_.stamina_ );
         if ( main_buf[0] != '\0' ) std::strcat( main_buf, "," );
         std::strcat( main_buf, buf );
+        stable_text = false;
     }
 
     if ( param.player_.hasStaminaCapacity()
-         && opt.showStaminaCapacity() )
+         && settings.showStaminaCapacity() )
     {
         char buf[16];
         snprintf( buf, 16, "%.0f", param.player_.stamina_capacity_ );
+        stable_text = false;
         if ( main_buf[0] != '\0' )
         {
-            if ( opt.showStamina() )
+            if ( settings.showStamina() )
             {
                 std::strcat( main_buf, "/" );
             }
@@ -892,7 +1154,7 @@ PlayerPainter::drawText( QPainter & painter,
         std::strcat( main_buf, buf );
     }
 
-    if ( opt.showPlayerType() )
+    if ( settings.showPlayerType() )
     {
         char buf[8];
         snprintf( buf, 8, "t%d", param.player_.type_ );
@@ -900,12 +1162,12 @@ PlayerPainter::drawText( QPainter & painter,
         strcat( main_buf, buf );
     }
 
-    painter.setFont( opt.playerFont() );
+    painter.setFont( settings.playerFont() );
 
     const int text_radius = std::min( 40, param.draw_radius_ );
     int card_offset = 0;
 
-    if ( opt.showCard()
+    if ( settings.showCard()
          && ( param.player_.hasRedCard()
               || param.player_.hasYellowCard() ) )
     {
@@ -915,7 +1177,7 @@ PlayerPainter::drawText( QPainter & painter,
 
         card_offset = x_size + 2;
 
-        if ( opt.antiAliasing() )
+        if ( settings.antiAliasing() )
         {
             painter.setRenderHint( QPainter::Antialiasing, false );
         }
@@ -926,7 +1188,7 @@ PlayerPainter::drawText( QPainter & painter,
         painter.drawRect( param.x_ + text_radius,
                           param.y_ - y_size,
                           x_size, y_size );
-        if ( opt.antiAliasing() )
+        if ( settings.antiAliasing() )
         {
             painter.setRenderHint( QPainter::Antialiasing, true );
         }
@@ -940,100 +1202,115 @@ PlayerPainter::drawText( QPainter & painter,
 
         if ( text_radius < param.draw_radius_ - 10 )
         {
-            painter.setPen( opt.playerNumberInnerPen() );
+            painter.setPen( settings.playerNumberInnerPen() );
         }
         else
         {
-            painter.setPen( opt.playerNumberPen() );
+            painter.setPen( settings.playerNumberPen() );
         }
 
         painter.setBrush( Qt::NoBrush );
+#if QT_VERSION >= 0x040700
+        if ( stable_text )
+        {
+            // QStaticText is placed by its top left corner, not by its baseline.
+            painter.drawStaticText( param.x_ + text_radius + card_offset,
+                                    param.y_ - painter.fontMetrics().ascent(),
+                                    label( QString::fromAscii( main_buf ) ) );
+        }
+        else
+        {
+            // laying out the label costs more than drawing it only once.
+            painter.drawText( param.x_ + text_radius + card_offset,
+                              param.y_,
+                              QString::fromAscii( main_buf ) );
+        }
+#else
         painter.drawText( param.x_ + text_radius + card_offset,
                           param.y_,
                           QString::fromAscii( main_buf ) );
+#endif
         painter.setBackgroundMode( Qt::TransparentMode );
     }
 }
 
+#if QT_VERSION >= 0x040700
 /*-------------------------------------------------------------------*/
 /*!
-
+  discard the laid out labels if the player font has been changed.
  */
 void
-PlayerPainter::drawOffsideLine( QPainter & painter,
-                                const rcss::rcg::ShowInfoT & show ) const
+PlayerPainter::updateLabels( const RenderSettings & settings )
 {
-    const Options & opt = Options::instance();
+    const QFont & font = settings.playerFont();
 
-    const float ball_x = show.ball_.x_;
+    if ( M_label_font != font )
+    {
+        M_label_font = font;
+        M_labels.clear();
+        M_label_lru.clear();
+    }
+}
 
-    float offside_l = 0.0;
+/*-------------------------------------------------------------------*/
+/*!
+  get the laid out label. the text is laid out only when it is
+  seen for the first time, and the least recently used label is
+  discarded when the cache is full.
+ */
+const QStaticText &
+PlayerPainter::label( const QString & text ) const
+{
+    LabelMap::iterator it = M_labels.find( text );
+    if ( it != M_labels.end() )
     {
-        float min_x = 0.0f;
-        for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
-        {
-            if ( show.player_[i].state_ != 0
-                 && show.player_[i].side_ == 'l' )
-            {
-                float x = show.player_[i].x_;
-                if ( x < offside_l )
-                {
-                    if ( x < min_x )
-                    {
-                        offside_l = min_x;
-                        min_x = x;
-                    }
-                    else
-                    {
-                        offside_l = x;
-                    }
-                }
-            }
-        }
-        offside_l = std::min( offside_l, ball_x );
-        offside_l = std::max( offside_l, - float( Options::PITCH_HALF_LENGTH ) );
+        M_label_lru.splice( M_label_lru.begin(), M_label_lru, it->second.lru_pos_ );
+        return it->second.text_;
     }
 
-    float offside_r = 0.0;
+    if ( M_labels.size() >= MAX_LABEL_CACHE )
     {
-        float max_x = 0.0;
-        for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
-        {
-            if ( show.player_[i].state_ != 0
-                 && show.player_[i].side_ == 'r' )
-            {
-                float x = show.player_[i].x_;
-                if ( offside_r < x )
-                {
-                    if ( max_x < x )
-                    {
-                        offside_r = max_x;
-                        max_x = x;
-                    }
-                    else
-                    {
-                        offside_r = x;
-                    }
-                }
-            }
-        }
-        offside_r = std::max( offside_r, ball_x );
-        offside_r = std::min( offside_r, float( Options::PITCH_HALF_LENGTH ) );
+        M_labels.erase( M_label_lru.back() );
+        M_label_lru.pop_back();
     }
 
-    const int offside_line_l = opt.screenX( offside_l );
-    const int offside_line_r = opt.screenX( offside_r );
+    M_label_lru.push_front( text );
+
+    LabelEntry & entry = M_labels[text];
+    entry.text_ = QStaticText( text );
+    entry.text_.setPerformanceHint( QStaticText::AggressiveCaching );
+    entry.text_.prepare( QTransform(), M_label_font );
+    entry.lru_pos_ = M_label_lru.begin();
+
+    return entry.text_;
+}
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerPainter::drawOffsideLine( QPainter & painter,
+                                const DispAnalysis & analysis,
+                                const RenderSettings & settings ) const
+{
+    const float offside_l = analysis.offside_line_x_[0];
+    const float offside_r = analysis.offside_line_x_[1];
+
+    const int offside_line_l = settings.screenX( offside_l );
+    const int offside_line_r = settings.screenX( offside_r );
 
-    const int top_y = opt.screenY( Options::PITCH_HALF_WIDTH );
-    const int bottom_y = opt.screenY( - Options::PITCH_HALF_WIDTH );
+    const int top_y = settings.screenY( Options::PITCH_HALF_WIDTH );
+    const int bottom_y = settings.screenY( - Options::PITCH_HALF_WIDTH );
 
     painter.setBrush( Qt::NoBrush );
 
-    painter.setPen( opt.leftTeamPen() );
+    painter.setPen( settings.leftTeamPen() );
     painter.drawLine( offside_line_l, top_y,
                       offside_line_l, bottom_y );
 
-    painter.setPen( opt.rightTeamPen() );
+    painter.setPen( settings.rightTeamPen() );
     painter.drawLine( offside_line_r, top_y,
                       offside_line_r, bottom_y );
 }
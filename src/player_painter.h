@@ -36,15 +36,25 @@
 #include <QPen>
 #include <QBrush>
 #include <QFont>
+#include <QImage>
+#include <QMutex>
+#if QT_VERSION >= 0x040700
+#include <QStaticText>
+#endif
 
 #include "painter_interface.h"
 
 #include <rcsslogplayer/types.h>
 
+#include <list>
+#include <map>
+#include <vector>
+
 class QPainter;
-class QPixmap;
 
-class DispHolder;
+class RenderFrame;
+class RenderSettings;
+struct DispAnalysis;
 
 class PlayerPainter
     : public PainterInterface {
@@ -64,14 +74,143 @@ private:
         Param( const rcss::rcg::PlayerT & player,
                const rcss::rcg::BallT & ball,
                const rcss::rcg::ServerParamT & sparam,
-               const rcss::rcg::PlayerTypeT & ptype );
+               const rcss::rcg::PlayerTypeT & ptype,
+               const RenderSettings & settings );
     private:
         //! not used
         Param();
     };
 
 
-    const DispHolder & M_disp_holder;
+    //! overlays switched by the settings. used as the template argument of drawPlayers().
+    enum Overlay {
+        VIEW_AREA = 0x01,
+        CATCH_AREA = 0x02,
+        TACKLE_AREA = 0x04,
+        KICK_ACCEL_AREA = 0x08,
+        POINTTO = 0x10,
+        PLAYER_TEXT = 0x20,
+        OVERLAY_COMBINATIONS = 0x40,
+    };
+
+    //! final pens of the body glyph
+    enum BodyPen {
+        PEN_PLAYER,
+        PEN_SELECTED,
+        PEN_KICK,
+        PEN_TACKLE,
+        BODY_PEN_SIZE,
+    };
+
+    //! final brushes of the body glyph
+    enum BodyBrush {
+        BRUSH_BLACK,
+        BRUSH_LEFT_TEAM,
+        BRUSH_LEFT_GOALIE,
+        BRUSH_RIGHT_TEAM,
+        BRUSH_RIGHT_GOALIE,
+        BRUSH_KICK_FAULT,
+        BRUSH_CATCH,
+        BRUSH_CATCH_FAULT,
+        BRUSH_TACKLE,
+        BRUSH_TACKLE_FAULT,
+        BRUSH_FOUL_CHARGED,
+        BRUSH_BALL_COLLIDE,
+        BRUSH_PLAYER_COLLIDE,
+        BODY_BRUSH_SIZE,
+    };
+
+    /*!
+      \brief pen and brush pair resolved from the player state.
+     */
+    struct BodyStyle {
+        unsigned char pen_; //!< BodyPen
+        unsigned char brush_; //!< BodyBrush
+
+        BodyStyle()
+            : pen_( PEN_PLAYER )
+            , brush_( BRUSH_BLACK )
+          { }
+    };
+
+    /*!
+      \brief key of the pre-rendered body glyph.
+     */
+    struct SpriteKey {
+        int state_; //!< body style, stamina flag and decay ring
+        int stamina_level_; //!< darkness level of the stamina shading
+        int body_radius_; //!< pixel body radius
+        int draw_radius_; //!< pixel main draw radius
+
+        SpriteKey( const int state,
+                   const int stamina_level,
+                   const int body_radius,
+                   const int draw_radius )
+            : state_( state )
+            , stamina_level_( stamina_level )
+            , body_radius_( body_radius )
+            , draw_radius_( draw_radius )
+          { }
+
+        bool operator<( const SpriteKey & rhs ) const
+          {
+              if ( state_ != rhs.state_ ) return state_ < rhs.state_;
+              if ( stamina_level_ != rhs.stamina_level_ ) return stamina_level_ < rhs.stamina_level_;
+              if ( body_radius_ != rhs.body_radius_ ) return body_radius_ < rhs.body_radius_;
+              return draw_radius_ < rhs.draw_radius_;
+          }
+    };
+    typedef std::map< SpriteKey, QImage > SpriteMap;
+
+    /*!
+      \brief body glyphs shared by all painters, e.g. by the canvases of the field wall.
+      the painters run in the render threads of the canvases.
+     */
+    struct SpriteAtlas {
+        QMutex mutex_; //!< protects all members
+        SpriteMap sprites_; //!< pre-rendered glyphs. cleared when colors are changed.
+        std::vector< double > signature_; //!< colors and pen widths used to render the glyphs
+    };
+
+    typedef void ( PlayerPainter::*DrawPlayersFunc )( QPainter &,
+                                                      const rcss::rcg::ShowInfoT &,
+                                                      const RenderSettings & ) const;
+#if QT_VERSION >= 0x040700
+    struct LabelEntry {
+        QStaticText text_;
+        std::list< QString >::iterator lru_pos_;
+    };
+    typedef std::map< QString, LabelEntry > LabelMap;
+#endif
+
+    const RenderFrame & M_frame;
+
+    static SpriteAtlas s_sprite_atlas;
+
+    //! version of the settings snapshot checked by updateBodySprites().
+    int M_sprite_settings_version;
+
+    //! body styles indexed by the compacted state bits, side and selection.
+    //! see bodyStyleIndex().
+    std::vector< BodyStyle > M_body_styles;
+    //! pens of the current settings indexed by BodyPen
+    QPen M_body_pens[BODY_PEN_SIZE];
+    //! brushes of the current settings indexed by BodyBrush
+    QBrush M_body_brushes[BODY_BRUSH_SIZE];
+
+    //! player loop specialized for the enabled overlays
+    DrawPlayersFunc M_draw_players;
+    //! version of the settings snapshot checked by updateDrawPlayers().
+    int M_draw_players_settings_version;
+
+#if QT_VERSION >= 0x040700
+    //! laid out player labels. cleared when the player font is changed.
+    mutable LabelMap M_labels;
+    //! label texts in the recently used order
+    mutable std::list< QString > M_label_lru;
+    //! font used to lay out the cached labels.
+    QFont M_label_font;
+#endif
 
     // not used
     PlayerPainter();
@@ -80,36 +219,65 @@ private:
 public:
 
     explicit
-    PlayerPainter( const DispHolder & disp_holder );
+    PlayerPainter( const RenderFrame & frame );
 
     ~PlayerPainter();
 
-    void draw( QPainter & dc );
+    void draw( QPainter & dc,
+               const RenderSettings & settings );
 
 private:
 
-    void drawAll( QPainter & painter,
-                  const rcss::rcg::PlayerT & player,
-                  const rcss::rcg::BallT & ball ) const;
+    template < int OVERLAYS >
+    void drawPlayers( QPainter & painter,
+                      const rcss::rcg::ShowInfoT & show,
+                      const RenderSettings & settings ) const;
+    void updateDrawPlayers( const RenderSettings & settings );
+
+    static
+    int bodyStyleIndex( const rcss::rcg::PlayerT & player,
+                        const bool selected );
+    void createBodyStyles();
+    void updateBodySprites( const RenderSettings & settings );
+    QImage createBodySprite( const PlayerPainter::Param & param,
+                             const BodyStyle & style,
+                             const int stamina_level,
+                             const int decay_ring,
+                             const RenderSettings & settings ) const;
+
     void drawBody( QPainter & painter,
-                   const PlayerPainter::Param & param ) const;
+                   const PlayerPainter::Param & param,
+                   const RenderSettings & settings ) const;
     void drawDir( QPainter & painter,
-                  const PlayerPainter::Param & param ) const;
+                  const PlayerPainter::Param & param,
+                  const bool draw_neck,
+                  const RenderSettings & settings ) const;
     void drawViewArea( QPainter & painter,
-                       const PlayerPainter::Param & param ) const;
+                       const PlayerPainter::Param & param,
+                       const RenderSettings & settings ) const;
     void drawCatchArea( QPainter & painter,
-                        const PlayerPainter::Param & param ) const;
+                        const PlayerPainter::Param & param,
+                        const RenderSettings & settings ) const;
     void drawTackleArea( QPainter & painter,
-                         const PlayerPainter::Param & param ) const;
+                         const PlayerPainter::Param & param,
+                         const RenderSettings & settings ) const;
     void drawPointto( QPainter & painter,
-                      const PlayerPainter::Param & param ) const;
+                      const PlayerPainter::Param & param,
+                      const RenderSettings & settings ) const;
     void drawKickAccelArea( QPainter & painter,
-                            const PlayerPainter::Param & param ) const;
+                            const PlayerPainter::Param & param,
+                            const RenderSettings & settings ) const;
     void drawText( QPainter & painter,
-                   const PlayerPainter::Param & param ) const;
+                   const PlayerPainter::Param & param,
+                   const RenderSettings & settings ) const;
+#if QT_VERSION >= 0x040700
+    void updateLabels( const RenderSettings & settings );
+    const QStaticText & label( const QString & text ) const;
+#endif
 
     void drawOffsideLine( QPainter & painter,
-                          const rcss::rcg::ShowInfoT & show ) const;
+                          const DispAnalysis & analysis,
+                          const RenderSettings & settings ) const;
 
 };
 
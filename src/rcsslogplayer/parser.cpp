@@ -37,12 +37,17 @@
 #include "parser.h"
 
 #include "handler.h"
+#include "scanner.h"
 #include "util.h"
 
 #include <iostream>
 #include <string>
-#include <map>
+#include <vector>
 #include <cmath>
+#include <cctype>
+#include <cerrno>
+#include <cfloat>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
@@ -54,76 +59,330 @@
 #include <windows.h>
 #endif
 
-#include <boost/lexical_cast.hpp>
-
-
-typedef std::map< std::string, int * > IntMap;
-typedef std::map< std::string, double * > DoubleMap;
-typedef std::map< std::string, bool * > BoolMap;
-typedef std::map< std::string, std::string * > StringMap;
 
 namespace {
 
-std::string
-clean_string( std::string str )
-{
-    if( str.empty() )
-    {
-        return str;
-    }
-
-    if ( *str.begin() == '\'' )
-    {
-        if( *str.rbegin() == '\''  )
-        {
-            str = str.substr( 1, str.length() - 2 );
-        }
-        else
-        {
-            return str;
-        }
-
-        // replace escape character
-        for ( std::string::size_type escape_pos = str.find( "\\'" );
-              escape_pos != std::string::npos;
-              escape_pos = str.find( "\\'" ) )
-        {
-            // replace "\'" with "'"
-            str.replace( escape_pos, 2, "'" );
-        }
-    }
-    else if ( *str.begin() == '"' )
-    {
-        if ( *str.rbegin() == '"'  )
-        {
-            str = str.substr( 1, str.length() - 2 );
-        }
-        else
-        {
-            return str;
-        }
-
-        // replace escape character
-        for( std::string::size_type escape_pos = str.find( "\\\"" );
-             escape_pos != std::string::npos;
-             escape_pos = str.find( "\\\"" ) )
-        {
-            // replace "\"" with """
-            str.replace( escape_pos, 2, "\"" );
-        }
-    }
-
-    return str;
-}
-
-
+/*!
+  \brief parameter table for the parameter message.
+  The table is generated only once and maps each parameter name to the
+  member variable by using the collision free hash table.
+ */
+template < typename Param >
+class ParamMap {
+private:
+
+    enum Type {
+        INT,
+        DOUBLE,
+        BOOL,
+        STRING
+    };
+
+    struct Entry {
+        const char * name_;
+        std::size_t length_;
+        Type type_;
+        int Param::* int_;
+        double Param::* double_;
+        bool Param::* bool_;
+        std::string Param::* string_;
+
+        Entry( const char * name,
+               const Type type )
+            : name_( name ),
+              length_( std::strlen( name ) ),
+              type_( type ),
+              int_( 0 ),
+              double_( 0 ),
+              bool_( 0 ),
+              string_( 0 )
+          { }
+    };
+
+    std::vector< Entry > M_entries;
+
+    //! hash table. each bucket has the entry index + 1 or 0 if empty.
+    std::vector< std::size_t > M_table;
+    std::size_t M_mask;
+    unsigned int M_seed;
+
+    // not used
+    ParamMap( const ParamMap & );
+    ParamMap & operator=( const ParamMap & );
+
+public:
+
+    ParamMap()
+        : M_mask( 0 ),
+          M_seed( 0 )
+      { }
+
+    void add( const char * name,
+              int Param::* member )
+      {
+          M_entries.push_back( Entry( name, INT ) );
+          M_entries.back().int_ = member;
+      }
+
+    void add( const char * name,
+              double Param::* member )
+      {
+          M_entries.push_back( Entry( name, DOUBLE ) );
+          M_entries.back().double_ = member;
+      }
+
+    void add( const char * name,
+              bool Param::* member )
+      {
+          M_entries.push_back( Entry( name, BOOL ) );
+          M_entries.back().bool_ = member;
+      }
+
+    void add( const char * name,
+              std::string Param::* member )
+      {
+          M_entries.push_back( Entry( name, STRING ) );
+          M_entries.back().string_ = member;
+      }
+
+    bool built() const
+      {
+          return ! M_table.empty();
+      }
+
+    /*!
+      \brief search the hash seed and the table size without collision.
+      This method must be called after all parameters are registered.
+     */
+    void build()
+      {
+          std::size_t size = 1;
+          while ( size < M_entries.size() * 2 )
+          {
+              size *= 2;
+          }
+
+          while ( true )
+          {
+              for ( unsigned int seed = 0; seed < 256; ++seed )
+              {
+                  if ( tryBuild( size, seed ) )
+                  {
+                      return;
+                  }
+              }
+              size *= 2;
+          }
+      }
+
+    /*!
+      \brief parse the value string and set it to the parameter variable.
+      \param param parameter instance
+      \param name parameter name (not null terminated)
+      \param name_len length of the parameter name
+      \param value value string (not null terminated)
+      \param value_len length of the value string
+      \return false if the parameter name is not found or the value is illegal.
+     */
+    bool set( Param & param,
+              const char * name,
+              const std::size_t name_len,
+              const char * value,
+              const std::size_t value_len ) const
+      {
+          const Entry * e = find( name, name_len );
+          if ( ! e )
+          {
+              return false;
+          }
+
+          switch ( e->type_ ) {
+          case INT:
+              return parse_int( value, value_len, param.*(e->int_) );
+          case DOUBLE:
+              return parse_double( value, value_len, param.*(e->double_) );
+          case BOOL:
+              param.*(e->bool_) = ! ( equals( value, value_len, "0" )
+                                      || equals( value, value_len, "false" )
+                                      || equals( value, value_len, "off" ) );
+              return true;
+          case STRING:
+              clean_string( value, value_len, param.*(e->string_) );
+              return true;
+          default:
+              break;
+          }
+
+          return false;
+      }
+
+private:
+
+    static
+    std::size_t hash( const unsigned int seed,
+                      const char * str,
+                      const std::size_t len )
+      {
+          // FNV-1a
+          std::size_t h = 2166136261u ^ seed;
+          for ( std::size_t i = 0; i < len; ++i )
+          {
+              h ^= static_cast< unsigned char >( str[i] );
+              h *= 16777619u;
+          }
+          return h;
+      }
+
+    bool tryBuild( const std::size_t size,
+                   const unsigned int seed )
+      {
+          M_table.assign( size, 0 );
+          for ( std::size_t i = 0; i < M_entries.size(); ++i )
+          {
+              std::size_t & bucket = M_table[hash( seed, M_entries[i].name_, M_entries[i].length_ ) & ( size - 1 )];
+              if ( bucket != 0 )
+              {
+                  return false;
+              }
+              bucket = i + 1;
+          }
+
+          M_mask = size - 1;
+          M_seed = seed;
+          return true;
+      }
+
+    const Entry * find( const char * name,
+                        const std::size_t len ) const
+      {
+          if ( M_table.empty() )
+          {
+              return static_cast< const Entry * >( 0 );
+          }
+
+          const std::size_t index = M_table[hash( M_seed, name, len ) & M_mask];
+          if ( index == 0 )
+          {
+              return static_cast< const Entry * >( 0 );
+          }
+
+          const Entry & e = M_entries[index - 1];
+          if ( e.length_ != len
+               || std::memcmp( e.name_, name, len ) != 0 )
+          {
+              return static_cast< const Entry * >( 0 );
+          }
+
+          return &e;
+      }
+
+    static
+    bool equals( const char * value,
+                 const std::size_t len,
+                 const char * str )
+      {
+          return ( std::strlen( str ) == len
+                   && std::memcmp( value, str, len ) == 0 );
+      }
+
+    static
+    bool parse_int( const char * value,
+                    const std::size_t len,
+                    int & result )
+      {
+          if ( len == 0
+               || std::isspace( static_cast< unsigned char >( *value ) ) )
+          {
+              return false;
+          }
+
+          char * end = 0;
+          errno = 0;
+          long val = std::strtol( value, &end, 10 );
+          if ( end != value + len
+               || errno == ERANGE
+               || val < INT_MIN
+               || INT_MAX < val )
+          {
+              return false;
+          }
+
+          result = static_cast< int >( val );
+          return true;
+      }
+
+    static
+    bool parse_double( const char * value,
+                       const std::size_t len,
+                       double & result )
+      {
+          if ( len == 0
+               || std::isspace( static_cast< unsigned char >( *value ) ) )
+          {
+              return false;
+          }
+
+          // the hexadecimal, inf and nan forms were not accepted by the old parser.
+          for ( std::size_t i = 0; i < len; ++i )
+          {
+              if ( ! std::isdigit( static_cast< unsigned char >( value[i] ) )
+                   && std::strchr( "+-.eE", value[i] ) == 0 )
+              {
+                  return false;
+              }
+          }
+
+          char * end = 0;
+          double val = rcss::rcg::scan_double( value, &end );
+          if ( end != value + len
+               || ! ( -DBL_MAX <= val && val <= DBL_MAX ) )
+          {
+              // out of range values are not accepted.
+              return false;
+          }
+
+          result = val;
+          return true;
+      }
+
+    /*!
+      \brief remove the quotation characters and unescape the quoted string.
+     */
+    static
+    void clean_string( const char * value,
+                       const std::size_t len,
+                       std::string & result )
+      {
+          if ( len == 0
+               || ( value[0] != '\'' && value[0] != '"' )
+               || value[len - 1] != value[0] )
+          {
+              result.assign( value, len );
+              return;
+          }
+
+          const char * escape = ( value[0] == '\'' ? "\\'" : "\\\"" );
+
+          result.assign( value + 1, len >= 2 ? len - 2 : 0 );
+
+          // replace escape character
+          for ( std::string::size_type escape_pos = result.find( escape );
+                escape_pos != std::string::npos;
+                escape_pos = result.find( escape ) )
+          {
+              result.replace( escape_pos, 2, escape + 1 );
+          }
+      }
+
+};
+
+
+template < typename Param >
 bool
 parse_param_line( const int n_line,
                   const std::string & line,
-                  IntMap & int_map,
-                  DoubleMap & double_map,
-                  BoolMap & bool_map,
-                  StringMap & string_map )
+                  Param & param,
+                  const ParamMap< Param > & param_map )
 {
     int n_read = 0;
 
@@ -135,6 +394,8 @@ parse_param_line( const int n_line,
         return false;
     }
 
+    const char * const buf = line.c_str();
+
     for ( std::string::size_type pos = line.find_first_of( '(', n_read );
           pos != std::string::npos;
           pos = line.find_first_of( '(', pos ) )
@@ -148,7 +409,8 @@ parse_param_line( const int n_line,
         }
         pos += 1;
 
-        const std::string name_str( line, pos, end_pos - pos );
+        const char * const name = buf + pos;
+        const std::size_t name_len = end_pos - pos;
 
         pos = end_pos;
 
@@ -157,7 +419,7 @@ parse_param_line( const int n_line,
         if ( end_pos == std::string::npos )
         {
             std::cerr << n_line << ":error: failed to parse parameter value for ["
-                      << name_str << "] "
+                      << std::string( name, name_len ) << "] "
                       << std::endl;
             return false;
         }
@@ -170,7 +432,7 @@ parse_param_line( const int n_line,
             if ( end_pos == std::string::npos )
             {
                 std::cerr << n_line << ":error: ailed to parse the quated value for ["
-                          << name_str << "] "
+                          << std::string( name, name_len ) << "] "
                           << std::endl;
                 return false;
             }
@@ -181,61 +443,51 @@ parse_param_line( const int n_line,
             pos += 1; // skip white space
         }
 
-        std::string value_str( line, pos, end_pos - pos );
+        const char * const value = buf + pos;
+        const std::size_t value_len = end_pos - pos;
         pos = end_pos;
 
-
-        //
-        // check parameter maps
-        //
-        try
+        if ( ! param_map.set( param, name, name_len, value, value_len ) )
         {
-            IntMap::iterator int_it = int_map.find( name_str );
-            if ( int_it != int_map.end() )
-            {
-                *(int_it->second) = boost::lexical_cast< int >( value_str );
-                continue;
-            }
+            std::cerr << n_line << ": warning: " << message_name
+                      << " unsupported parameter or illegal value=("
+                      << std::string( name, name_len )
+                      << ' ' << std::string( value, value_len ) << ")"
+                      << std::endl;
+        }
+    }
 
-            DoubleMap::iterator double_it = double_map.find( name_str );
-            if ( double_it != double_map.end() )
-            {
-                *(double_it->second) = boost::lexical_cast< double >( value_str );
-                continue;
-            }
+    return true;
+}
 
-            BoolMap::iterator bool_it = bool_map.find( name_str );
-            if ( bool_it != bool_map.end() )
-            {
-                *(bool_it->second) = !( value_str == "0"
-                                        || value_str == "false"
-                                        || value_str == "off" );
-                continue;
-            }
+/*!
+  \brief scan the team names and scores in the same way as
+  "%31s %31s %d %d %d %d %d %d" of scanf.
+  \return the number of scanned values.
+ */
+int
+scan_team( const char * buf,
+           char * name_l,
+           char * name_r,
+           int * values )
+{
+    if ( ! buf ) return 0;
 
-            StringMap::iterator string_it = string_map.find( name_str );
-            if ( string_it != string_map.end() )
-            {
-                *(string_it->second) = clean_string( value_str );
-                continue;
-            }
+    buf = rcss::rcg::scan_token( buf, name_l, 31 );
+    if ( ! buf ) return 0;
 
+    buf = rcss::rcg::scan_token( buf, name_r, 31 );
+    if ( ! buf ) return 1;
 
-            std::cerr << n_line << ": warning: " << message_name
-                      << " unsupported parameter=(" << name_str
-                      << ' ' << value_str << ")"
-                      << std::endl;
-        }
-        catch ( boost::bad_lexical_cast & e )
-        {
-            std::cerr << e.what() << '\n'
-                      << " param_name=" << name_str
-                      << " value=" << value_str
-                      << std::endl;
-        }
+    int n = 2;
+    for ( int i = 0; i < 6; ++i )
+    {
+        buf = rcss::rcg::scan_int( buf, values[i] );
+        if ( ! buf ) break;
+        ++n;
     }
 
-    return true;
+    return n;
 }
 
 }
@@ -771,15 +1023,16 @@ Parser::parseShowLine( const int n_line,
     // time
     int time = 0;
     {
-        if ( std::sscanf( buf, "(show %d %n",
-                          &time, &n_read ) != 1 )
+        const char * next = scan_literal( buf, "(show " );
+        if ( next ) next = scan_int( next, time );
+        if ( ! next )
         {
             std::cerr << n_line << ": error: "
                       << "Illegal time info \"" << line << "\""
                       << std::endl;
             return false;
         }
-        buf += n_read;
+        buf = skip_space( next );
 
         M_time = time;
         show.time_ = static_cast< UInt32 >( time );
@@ -789,16 +1042,17 @@ Parser::parseShowLine( const int n_line,
     if ( *(buf + 1) == 'p' )
     {
         int pm = 0;
-        if ( std::sscanf( buf,
-                          "(pm %d) %n ",
-                          &pm, &n_read ) != 1 )
+        const char * next = scan_literal( buf, "(pm" );
+        if ( next ) next = scan_int( next, pm );
+        if ( ! next )
         {
             std::cerr << n_line << ": error: "
                       << "Illegal playmode info \"" << line << "\""
                       << std::endl;
             return false;
         }
-        buf += n_read;
+        buf = scan_literal( next, ") " );
+        if ( ! buf ) buf = next;
 
         M_handler.handlePlayMode( time, static_cast< PlayMode >( pm ) );
     }
@@ -807,15 +1061,10 @@ Parser::parseShowLine( const int n_line,
     if ( *(buf + 1) == 't' )
     {
         char name_l[32], name_r[32];
-        int score_l = 0, score_r = 0;
-        int pen_score_l = 0, pen_miss_l = 0, pen_score_r = 0, pen_miss_r = 0;
+        // score_l, score_r, pen_score_l, pen_miss_l, pen_score_r, pen_miss_r
+        int values[6] = { 0, 0, 0, 0, 0, 0 };
 
-        int n = std::sscanf( buf,
-                             "(tm %31s %31s %d %d %d %d %d %d ",
-                             name_l, name_r,
-                             &score_l, &score_r,
-                             &pen_score_l, &pen_miss_l,
-                             &pen_score_r, &pen_miss_r );
+        int n = scan_team( scan_literal( buf, "(tm" ), name_l, name_r, values );
 
         if ( n != 4 && n != 8 )
         {
@@ -830,8 +1079,8 @@ Parser::parseShowLine( const int n_line,
         if ( ! std::strcmp( name_l, "null" ) ) std::memset( name_l, 0, 4 );
         if ( ! std::strcmp( name_r, "null" ) ) std::memset( name_r, 0, 4 );
 
-        TeamT team_l( name_l, score_l, pen_score_l, pen_miss_l );
-        TeamT team_r( name_r, score_r, pen_score_r, pen_miss_r );
+        TeamT team_l( name_l, values[0], values[2], values[3] );
+        TeamT team_r( name_r, values[1], values[4], values[5] );
 
         M_handler.handleTeamInfo( time, team_l, team_r );
     }
@@ -976,10 +1225,10 @@ Parser::parseShowLine( const int n_line,
             while ( *buf != '\0' && *buf != ')' ) ++buf;
             while ( *buf == ')' ) ++buf;
             BallT & ball = show.ball_;
-            ball.x_ = strtof( buf, &next ); buf = next;
-            ball.y_ = strtof( buf, &next ); buf = next;
-            ball.vx_ = strtof( buf, &next ); buf = next;
-            ball.vy_ = strtof( buf, &next ); buf = next;
+            ball.x_ = scan_float( buf, &next ); buf = next;
+            ball.y_ = scan_float( buf, &next ); buf = next;
+            ball.vx_ = scan_float( buf, &next ); buf = next;
+            ball.vy_ = scan_float( buf, &next ); buf = next;
             while ( *buf == ')' ) ++buf;
             while ( *buf == ' ' ) ++buf;
 
@@ -1014,7 +1263,7 @@ Parser::parseShowLine( const int n_line,
             }
 
             ++buf;
-            long unum = std::strtol( buf, &next, 10 ); buf = next;
+            long unum = scan_long( buf, &next, 10 ); buf = next;
             if ( unum < 0 || MAX_PLAYER < unum )
             {
                 std::cerr << n_line << ": error: "
@@ -1033,21 +1282,21 @@ Parser::parseShowLine( const int n_line,
             p.unum_ = static_cast< Int16 >( unum );
 
             // x y vx vy body neck
-            p.type_ = static_cast< Int16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.state_ = static_cast< Int32 >( std::strtol( buf, &next, 16 ) ); buf = next;
-            p.x_ = strtof( buf, &next ); buf = next;
-            p.y_ = strtof( buf, &next ); buf = next;
-            p.vx_ = strtof( buf, &next ); buf = next;
-            p.vy_ = strtof( buf, &next ); buf = next;
-            p.body_ = strtof( buf, &next ); buf = next;
-            p.neck_ = strtof( buf, &next ); buf = next;
+            p.type_ = static_cast< Int16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.state_ = static_cast< Int32 >( scan_long( buf, &next, 16 ) ); buf = next;
+            p.x_ = scan_float( buf, &next ); buf = next;
+            p.y_ = scan_float( buf, &next ); buf = next;
+            p.vx_ = scan_float( buf, &next ); buf = next;
+            p.vy_ = scan_float( buf, &next ); buf = next;
+            p.body_ = scan_float( buf, &next ); buf = next;
+            p.neck_ = scan_float( buf, &next ); buf = next;
             while ( *buf == ' ' ) ++buf;
 
             // x y vx vy body neck
             if ( *buf != '\0' && *buf != '(' )
             {
-                p.point_x_ = strtof( buf, &next ); buf = next;
-                p.point_y_ = strtof( buf, &next ); buf = next;
+                p.point_x_ = scan_float( buf, &next ); buf = next;
+                p.point_y_ = scan_float( buf, &next ); buf = next;
             }
 
             // (v quality width)
@@ -1055,18 +1304,18 @@ Parser::parseShowLine( const int n_line,
             ++buf; // skip 'v'
             while ( *buf == ' ' ) ++buf;
             p.view_quality_ = *buf; ++buf;
-            p.view_width_ = strtof( buf, &next ); buf = next;
+            p.view_width_ = scan_float( buf, &next ); buf = next;
 
             // (s stamina effort recovery[ capacity])
             while ( *buf != '\0' && *buf != 's' ) ++buf;
             ++buf; // skip 's' //while ( *buf != '\0' && *buf != ' ' ) ++buf;
-            p.stamina_ = strtof( buf, &next ); buf = next;
-            p.effort_ = strtof( buf, &next ); buf = next;
-            p.recovery_ = strtof( buf, &next ); buf = next;
+            p.stamina_ = scan_float( buf, &next ); buf = next;
+            p.effort_ = scan_float( buf, &next ); buf = next;
+            p.recovery_ = scan_float( buf, &next ); buf = next;
             while ( *buf == ' ' ) ++buf;
             if ( *buf != ')' )
             {
-                p.stamina_capacity_ = strtof( buf, &next ); buf = next;
+                p.stamina_capacity_ = scan_float( buf, &next ); buf = next;
             }
             while ( *buf != '\0' && *buf != ')' ) ++buf;
             while ( *buf == ')' ) ++buf;
@@ -1079,7 +1328,7 @@ Parser::parseShowLine( const int n_line,
                 while ( *buf != '\0' && *buf != ' ' ) ++buf;
                 while ( *buf == ' ' ) ++buf;
                 p.focus_side_ = *buf; ++buf;
-                p.focus_unum_ = static_cast< Int16 >( std::strtol( buf, &next, 10 ) ); buf = next;
+                p.focus_unum_ = static_cast< Int16 >( scan_long( buf, &next, 10 ) ); buf = next;
                 while ( *buf == ' ' ) ++buf;
                 while ( *buf == ')' ) ++buf;
                 while ( *buf == ' ' ) ++buf;
@@ -1088,17 +1337,17 @@ Parser::parseShowLine( const int n_line,
             // (c kick dash turn catch move tneck cview say tackle pointto atttention)
             while ( *buf == '(' ) ++buf;
             ++buf; // skip 'c' //while ( *buf != '\0' && *buf != ' ' ) ++buf;
-            p.kick_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.dash_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.turn_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.catch_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.move_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.turn_neck_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.change_view_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.say_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.tackle_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.pointto_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.attentionto_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
+            p.kick_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.dash_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.turn_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.catch_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.move_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.turn_neck_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.change_view_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.say_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.tackle_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.pointto_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
+            p.attentionto_count_ = static_cast< UInt16 >( scan_long( buf, &next, 10 ) ); buf = next;
             while ( *buf == ')' ) ++buf;
             while ( *buf == ' ' ) ++buf;
 
@@ -1131,20 +1380,19 @@ Parser::parseDrawLine( const int n_line,
 
     const char * buf = line.c_str();
 
-    int n_read = 0;
-
     // parse time
 
     int time = 0;
-    if ( std::sscanf( buf, " ( draw %d %n ",
-                      &time, &n_read ) != 1 )
+    buf = scan_literal( buf, " ( draw" );
+    if ( buf ) buf = scan_int( buf, time );
+    if ( ! buf )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal time info \"" << line << "\""
                   << std::endl;
         return false;
     }
-    buf += n_read;
+    buf = skip_space( buf );
 
     M_time = time;
 
@@ -1154,9 +1402,12 @@ Parser::parseDrawLine( const int n_line,
     {
         float x, y;
         char col[64];
-        if ( std::sscanf( buf,
-                          " (point %f %f \"%63[^\"]\" ) ",
-                          &x, &y, col ) != 3 )
+        const char * p = scan_literal( buf, " (point" );
+        if ( p ) p = scan_float( p, x );
+        if ( p ) p = scan_float( p, y );
+        if ( p ) p = scan_literal( p, " \"" );
+        if ( p ) p = scan_until( p, '"', col, 63 );
+        if ( ! p )
         {
             std::cerr << n_line << ": error: "
                       << "Illegal draw point info \"" << line << "\""
@@ -1170,9 +1421,13 @@ Parser::parseDrawLine( const int n_line,
     {
         float x, y, r;
         char col[64];
-        if ( std::sscanf( buf,
-                          " (circle %f %f %f \"%63[^\"]\" ) ",
-                          &x, &y, &r, col ) != 4 )
+        const char * p = scan_literal( buf, " (circle" );
+        if ( p ) p = scan_float( p, x );
+        if ( p ) p = scan_float( p, y );
+        if ( p ) p = scan_float( p, r );
+        if ( p ) p = scan_literal( p, " \"" );
+        if ( p ) p = scan_until( p, '"', col, 63 );
+        if ( ! p )
         {
             std::cerr << n_line << ": error: "
                       << "Illegal draw circle info \"" << line << "\""
@@ -1186,10 +1441,14 @@ Parser::parseDrawLine( const int n_line,
     {
         float x1, y1, x2, y2;
         char col[64];
-
-        if ( std::sscanf( buf,
-                          " (line %f %f %f %f \"%63[^\"]\" ) ",
-                          &x1, &y1, &x2, &y2, col ) != 5 )
+        const char * p = scan_literal( buf, " (line" );
+        if ( p ) p = scan_float( p, x1 );
+        if ( p ) p = scan_float( p, y1 );
+        if ( p ) p = scan_float( p, x2 );
+        if ( p ) p = scan_float( p, y2 );
+        if ( p ) p = scan_literal( p, " \"" );
+        if ( p ) p = scan_until( p, '"', col, 63 );
+        if ( ! p )
         {
             std::cerr << n_line << ": error: "
                       << "Illegal draw line info \"" << line << "\""
@@ -1270,9 +1529,10 @@ Parser::parsePlayModeLine( const int n_line,
     int time = 0;
     char pm_string[32];
 
-    if ( std::sscanf( line.c_str(),
-                      " ( playmode %d %31[^)] ) ",
-                      &time, pm_string ) != 2 )
+    const char * buf = scan_literal( line.c_str(), " ( playmode" );
+    if ( buf ) buf = scan_int( buf, time );
+    if ( buf ) buf = scan_until( skip_space( buf ), ')', pm_string, 31 );
+    if ( ! buf )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal playmode line. \"" << line << "\"" << std::endl;;
@@ -1303,17 +1563,13 @@ Parser::parseTeamLine( const int n_line,
 {
     int time = 0;
     char name_l[32], name_r[32];
-    int score_l = 0, score_r = 0;
-    int pen_score_l = 0, pen_miss_l = 0, pen_score_r = 0, pen_miss_r = 0;
+    // score_l, score_r, pen_score_l, pen_miss_l, pen_score_r, pen_miss_r
+    int values[6] = { 0, 0, 0, 0, 0, 0 };
 
+    const char * buf = scan_literal( line.c_str(), " ( team" );
+    if ( buf ) buf = scan_int( buf, time );
 
-    int n = std::sscanf( line.c_str(),
-                         " ( team %d %31s %31s %d %d %d %d %d %d ",
-                         &time,
-                         name_l, name_r,
-                         &score_l, &score_r,
-                         &pen_score_l, &pen_miss_l,
-                         &pen_score_r, &pen_miss_r );
+    int n = ( buf ? 1 + scan_team( buf, name_l, name_r, values ) : 0 );
     if ( n != 5 && n != 9 )
     {
         std::cerr << n_line << ": error: "
@@ -1323,8 +1579,8 @@ Parser::parseTeamLine( const int n_line,
 
     M_time = time;
 
-    TeamT team_l( name_l, score_l, pen_score_l, pen_miss_l );
-    TeamT team_r( name_r, score_r, pen_score_r, pen_miss_r );
+    TeamT team_l( name_l, values[0], values[2], values[3] );
+    TeamT team_r( name_r, values[1], values[4], values[5] );
 
     M_handler.handleTeamInfo( M_time, team_l, team_r );
 
@@ -1339,37 +1595,36 @@ Parser::parsePlayerTypeLine( const int n_line,
     PlayerTypeT param;
 
     //
-    // prepare param map
+    // prepare param map. the table is built only once.
     //
-    IntMap int_map;
-    DoubleMap double_map;
-    BoolMap bool_map;
-    StringMap string_map;
-
-    int_map.insert( IntMap::value_type( "id", &param.id_ ) );
-
-    double_map.insert( DoubleMap::value_type( "player_speed_max", &param.player_speed_max_ ) );
-    double_map.insert( DoubleMap::value_type( "stamina_inc_max", &param.stamina_inc_max_ ) );
-    double_map.insert( DoubleMap::value_type( "player_decay", &param.player_decay_ ) );
-    double_map.insert( DoubleMap::value_type( "inertia_moment", &param.inertia_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "dash_power_rate", &param.dash_power_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "player_size", &param.player_size_ ) );
-    double_map.insert( DoubleMap::value_type( "kickable_margin", &param.kickable_margin_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_rand", &param.kick_rand_ ) );
-    double_map.insert( DoubleMap::value_type( "extra_stamina", &param.extra_stamina_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_max", &param.effort_max_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_min", &param.effort_min_ ) );
-    // 14.0.0
-    double_map.insert( DoubleMap::value_type( "kick_power_rate", &param.kick_power_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "foul_detect_probability", &param.foul_detect_probability_ ) );
-    double_map.insert( DoubleMap::value_type( "catchable_area_l_stretch", &param.catchable_area_l_stretch_ ) );
+    static ParamMap< PlayerTypeT > s_param_map;
+    if ( ! s_param_map.built() )
+    {
+        s_param_map.add( "id", &PlayerTypeT::id_ );
+
+        s_param_map.add( "player_speed_max", &PlayerTypeT::player_speed_max_ );
+        s_param_map.add( "stamina_inc_max", &PlayerTypeT::stamina_inc_max_ );
+        s_param_map.add( "player_decay", &PlayerTypeT::player_decay_ );
+        s_param_map.add( "inertia_moment", &PlayerTypeT::inertia_moment_ );
+        s_param_map.add( "dash_power_rate", &PlayerTypeT::dash_power_rate_ );
+        s_param_map.add( "player_size", &PlayerTypeT::player_size_ );
+        s_param_map.add( "kickable_margin", &PlayerTypeT::kickable_margin_ );
+        s_param_map.add( "kick_rand", &PlayerTypeT::kick_rand_ );
+        s_param_map.add( "extra_stamina", &PlayerTypeT::extra_stamina_ );
+        s_param_map.add( "effort_max", &PlayerTypeT::effort_max_ );
+        s_param_map.add( "effort_min", &PlayerTypeT::effort_min_ );
+        // 14.0.0
+        s_param_map.add( "kick_power_rate", &PlayerTypeT::kick_power_rate_ );
+        s_param_map.add( "foul_detect_probability", &PlayerTypeT::foul_detect_probability_ );
+        s_param_map.add( "catchable_area_l_stretch", &PlayerTypeT::catchable_area_l_stretch_ );
+        s_param_map.build();
+    }
 
     //
     // parse
     //
 
-    if ( ! parse_param_line( n_line, line,
-                             int_map, double_map, bool_map, string_map ) )
+    if ( ! parse_param_line( n_line, line, param, s_param_map ) )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal player_type line. \"" << line << "\"" << std::endl;;
@@ -1389,50 +1644,49 @@ Parser::parsePlayerParamLine( const int n_line,
     PlayerParamT param;
 
     //
-    // prepare param map
+    // prepare param map. the table is built only once.
     //
-    IntMap int_map;
-    DoubleMap double_map;
-    BoolMap bool_map;
-    StringMap string_map;
-
-    int_map.insert( IntMap::value_type( "player_types", &param.player_types_ ) );
-    int_map.insert( IntMap::value_type( "subs_max", &param.subs_max_ ) );
-    int_map.insert( IntMap::value_type( "pt_max", &param.pt_max_ ) );
-    bool_map.insert( BoolMap::value_type( "allow_mult_default_type", &param.allow_mult_default_type_ ) );
-    double_map.insert( DoubleMap::value_type( "player_speed_max_delta_min", &param.player_speed_max_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "player_speed_max_delta_max", &param.player_speed_max_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "stamina_inc_max_delta_factor", &param.stamina_inc_max_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "player_decay_delta_min", &param.player_decay_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "player_decay_delta_max", &param.player_decay_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "inertia_moment_delta_factor", &param.inertia_moment_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "dash_power_rate_delta_min", &param.dash_power_rate_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "dash_power_rate_delta_max", &param.dash_power_rate_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "player_size_delta_factor", &param.player_size_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "kickable_margin_delta_min", &param.kickable_margin_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "kickable_margin_delta_max", &param.kickable_margin_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_rand_delta_factor", &param.kick_rand_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "extra_stamina_delta_min", &param.extra_stamina_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "extra_stamina_delta_max", &param.extra_stamina_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_max_delta_factor", &param.effort_max_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_min_delta_factor", &param.effort_min_delta_factor_ ) );
-    int_map.insert( IntMap::value_type( "random_seed", &param.random_seed_ ) );
-    double_map.insert( DoubleMap::value_type( "new_dash_power_rate_delta_min", &param.new_dash_power_rate_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "new_dash_power_rate_delta_max", &param.new_dash_power_rate_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "new_stamina_inc_max_delta_factor", &param.new_stamina_inc_max_delta_factor_ ) );
-    // 14.0.0
-    double_map.insert( DoubleMap::value_type( "kick_power_rate_delta_min", &param.kick_power_rate_delta_min_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_power_rate_delta_max", &param.kick_power_rate_delta_max_ ) );
-    double_map.insert( DoubleMap::value_type( "foul_detect_probability_delta_factor", &param.foul_detect_probability_delta_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "catchable_area_l_stretch_min", &param.catchable_area_l_stretch_min_ ) );
-    double_map.insert( DoubleMap::value_type( "catchable_area_l_stretch_max", &param.catchable_area_l_stretch_max_ ) );
+    static ParamMap< PlayerParamT > s_param_map;
+    if ( ! s_param_map.built() )
+    {
+        s_param_map.add( "player_types", &PlayerParamT::player_types_ );
+        s_param_map.add( "subs_max", &PlayerParamT::subs_max_ );
+        s_param_map.add( "pt_max", &PlayerParamT::pt_max_ );
+        s_param_map.add( "allow_mult_default_type", &PlayerParamT::allow_mult_default_type_ );
+        s_param_map.add( "player_speed_max_delta_min", &PlayerParamT::player_speed_max_delta_min_ );
+        s_param_map.add( "player_speed_max_delta_max", &PlayerParamT::player_speed_max_delta_max_ );
+        s_param_map.add( "stamina_inc_max_delta_factor", &PlayerParamT::stamina_inc_max_delta_factor_ );
+        s_param_map.add( "player_decay_delta_min", &PlayerParamT::player_decay_delta_min_ );
+        s_param_map.add( "player_decay_delta_max", &PlayerParamT::player_decay_delta_max_ );
+        s_param_map.add( "inertia_moment_delta_factor", &PlayerParamT::inertia_moment_delta_factor_ );
+        s_param_map.add( "dash_power_rate_delta_min", &PlayerParamT::dash_power_rate_delta_min_ );
+        s_param_map.add( "dash_power_rate_delta_max", &PlayerParamT::dash_power_rate_delta_max_ );
+        s_param_map.add( "player_size_delta_factor", &PlayerParamT::player_size_delta_factor_ );
+        s_param_map.add( "kickable_margin_delta_min", &PlayerParamT::kickable_margin_delta_min_ );
+        s_param_map.add( "kickable_margin_delta_max", &PlayerParamT::kickable_margin_delta_max_ );
+        s_param_map.add( "kick_rand_delta_factor", &PlayerParamT::kick_rand_delta_factor_ );
+        s_param_map.add( "extra_stamina_delta_min", &PlayerParamT::extra_stamina_delta_min_ );
+        s_param_map.add( "extra_stamina_delta_max", &PlayerParamT::extra_stamina_delta_max_ );
+        s_param_map.add( "effort_max_delta_factor", &PlayerParamT::effort_max_delta_factor_ );
+        s_param_map.add( "effort_min_delta_factor", &PlayerParamT::effort_min_delta_factor_ );
+        s_param_map.add( "random_seed", &PlayerParamT::random_seed_ );
+        s_param_map.add( "new_dash_power_rate_delta_min", &PlayerParamT::new_dash_power_rate_delta_min_ );
+        s_param_map.add( "new_dash_power_rate_delta_max", &PlayerParamT::new_dash_power_rate_delta_max_ );
+        s_param_map.add( "new_stamina_inc_max_delta_factor", &PlayerParamT::new_stamina_inc_max_delta_factor_ );
+        // 14.0.0
+        s_param_map.add( "kick_power_rate_delta_min", &PlayerParamT::kick_power_rate_delta_min_ );
+        s_param_map.add( "kick_power_rate_delta_max", &PlayerParamT::kick_power_rate_delta_max_ );
+        s_param_map.add( "foul_detect_probability_delta_factor", &PlayerParamT::foul_detect_probability_delta_factor_ );
+        s_param_map.add( "catchable_area_l_stretch_min", &PlayerParamT::catchable_area_l_stretch_min_ );
+        s_param_map.add( "catchable_area_l_stretch_max", &PlayerParamT::catchable_area_l_stretch_max_ );
+        s_param_map.build();
+    }
 
     //
     // parse
     //
 
-    if ( ! parse_param_line( n_line, line,
-                             int_map, double_map, bool_map, string_map ) )
+    if ( ! parse_param_line( n_line, line, param, s_param_map ) )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal player_param line. \"" << line << "\"" << std::endl;;
@@ -1452,226 +1706,225 @@ Parser::parseServerParamLine( const int n_line,
     ServerParamT param;
 
     //
-    // prepare param map
+    // prepare param map. the table is built only once.
     //
-    IntMap int_map;
-    DoubleMap double_map;
-    BoolMap bool_map;
-    StringMap string_map;
-
-    double_map.insert( DoubleMap::value_type( "goal_width", &param.goal_width_ ) );
-    double_map.insert( DoubleMap::value_type( "inertia_moment", &param.inertia_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "player_size", &param.player_size_ ) );
-    double_map.insert( DoubleMap::value_type( "player_decay", &param.player_decay_ ) );
-    double_map.insert( DoubleMap::value_type( "player_rand", &param.player_rand_ ) );
-    double_map.insert( DoubleMap::value_type( "player_weight", &param.player_weight_ ) );
-    double_map.insert( DoubleMap::value_type( "player_speed_max", &param.player_speed_max_ ) );
-    double_map.insert( DoubleMap::value_type( "player_accel_max", &param.player_accel_max_ ) );
-    double_map.insert( DoubleMap::value_type( "stamina_max", &param.stamina_max_ ) );
-    double_map.insert( DoubleMap::value_type( "stamina_inc_max", &param.stamina_inc_max_ ) );
-    double_map.insert( DoubleMap::value_type( "recover_init", &param.recover_init_ ) ); // not necessary
-    double_map.insert( DoubleMap::value_type( "recover_dec_thr", &param.recover_dec_thr_ ) );
-    double_map.insert( DoubleMap::value_type( "recover_min", &param.recover_min_ ) );
-    double_map.insert( DoubleMap::value_type( "recover_dec", &param.recover_dec_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_init", &param.effort_init_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_dec_thr", &param.effort_dec_thr_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_min", &param.effort_min_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_dec", &param.effort_dec_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_inc_thr", &param.effort_inc_thr_ ) );
-    double_map.insert( DoubleMap::value_type( "effort_inc",  &param.effort_inc_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_rand", &param.kick_rand_ ) );
-    bool_map.insert( BoolMap::value_type( "team_actuator_noise", &param.team_actuator_noise_ ) );
-    double_map.insert( DoubleMap::value_type( "prand_factor_l", &param.player_rand_factor_l_ ) );
-    double_map.insert( DoubleMap::value_type( "prand_factor_r", &param.player_rand_factor_r_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_rand_factor_l", &param.kick_rand_factor_l_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_rand_factor_r", &param.kick_rand_factor_r_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_size", &param.ball_size_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_decay", &param.ball_decay_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_rand", &param.ball_rand_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_weight", &param.ball_weight_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_speed_max", &param.ball_speed_max_ ) );
-    double_map.insert( DoubleMap::value_type( "ball_accel_max", &param.ball_accel_max_ ) );
-    double_map.insert( DoubleMap::value_type( "dash_power_rate", &param.dash_power_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "kick_power_rate", &param.kick_power_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "kickable_margin", &param.kickable_margin_ ) );
-    double_map.insert( DoubleMap::value_type( "control_radius", &param.control_radius_ ) );
-    //( "control_radius_width", &param.control_radius_width_ ) );
-    //( "kickable_area", &param.kickable_area_ ) ); // not needed
-    double_map.insert( DoubleMap::value_type( "catch_probability", &param.catch_probability_ ) );
-    double_map.insert( DoubleMap::value_type( "catchable_area_l", &param.catchable_area_l_ ) );
-    double_map.insert( DoubleMap::value_type( "catchable_area_w", &param.catchable_area_w_ ) );
-    int_map.insert( IntMap::value_type( "goalie_max_moves", &param.goalie_max_moves_ ) );
-    double_map.insert( DoubleMap::value_type( "maxpower", &param.max_power_ ) );
-    double_map.insert( DoubleMap::value_type( "minpower", &param.min_power_ ) );
-    double_map.insert( DoubleMap::value_type( "maxmoment", &param.max_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "minmoment", &param.min_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "maxneckmoment", &param.max_neck_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "minneckmoment", &param.min_neck_moment_ ) );
-    double_map.insert( DoubleMap::value_type( "maxneckang", &param.max_neck_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "minneckang", &param.min_neck_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "visible_angle", &param.visible_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "visible_distance", &param.visible_distance_ ) );
-    double_map.insert( DoubleMap::value_type( "audio_cut_dist", &param.audio_cut_dist_ ) );
-    double_map.insert( DoubleMap::value_type( "quantize_step", &param.quantize_step_ ) );
-    double_map.insert( DoubleMap::value_type( "quantize_step_l", &param.landmark_quantize_step_ ) );
-    //( "quantize_step_dir", &param.dir_quantize_step_ ) );
-    //( "quantize_step_dist_team_l", &param.dist_quantize_step_l_ ) );
-    //( "quantize_step_dist_team_r", &param.dist_quantize_step_r_ ) );
-    //( "quantize_step_dist_l_team_l", &param.landmark_dist_quantize_step_l_ ) );
-    //( "quantize_step_dist_l_team_r", &param.landmark_dist_quantize_step_r_ ) );
-    //( "quantize_step_dir_team_l", &param.dir_quantize_step_l_ ) );
-    //( "quantize_step_dir_team_r", &param.dir_quantize_step_r_ ) );
-    double_map.insert( DoubleMap::value_type( "ckick_margin", &param.corner_kick_margin_ ) );
-    double_map.insert( DoubleMap::value_type( "wind_dir", &param.wind_dir_ ) );
-    double_map.insert( DoubleMap::value_type( "wind_force", &param.wind_force_ ) );
-    double_map.insert( DoubleMap::value_type( "wind_ang", &param.wind_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "wind_rand", &param.wind_rand_ ) );
-    bool_map.insert( BoolMap::value_type( "wind_none", &param.wind_none_ ) );
-    bool_map.insert( BoolMap::value_type( "wind_random", &param.wind_random_ ) );
-    int_map.insert( IntMap::value_type( "half_time", &param.half_time_ ) );
-    int_map.insert( IntMap::value_type( "drop_ball_time", &param.drop_ball_time_ ) );
-    int_map.insert( IntMap::value_type( "port", &param.port_ ) );
-    int_map.insert( IntMap::value_type( "coach_port", &param.coach_port_ ) );
-    int_map.insert( IntMap::value_type( "olcoach_port", &param.online_coach_port_ ) );
-    int_map.insert( IntMap::value_type( "say_coach_cnt_max", &param.say_coach_count_max_ ) );
-    int_map.insert( IntMap::value_type( "say_coach_msg_size", &param.say_coach_msg_size_ ) );
-    int_map.insert( IntMap::value_type( "simulator_step", &param.simulator_step_ ) );
-    int_map.insert( IntMap::value_type( "send_step", &param.send_step_ ) );
-    int_map.insert( IntMap::value_type( "recv_step", &param.recv_step_ ) );
-    int_map.insert( IntMap::value_type( "sense_body_step", &param.sense_body_step_ ) );
-    //( "lcm_step", &param.lcm_step_ ) ); // not needed
-    int_map.insert( IntMap::value_type( "say_msg_size", &param.say_msg_size_ ) );
-    int_map.insert( IntMap::value_type( "clang_win_size", &param.clang_win_size_ ) );
-    int_map.insert( IntMap::value_type( "clang_define_win", &param.clang_define_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_meta_win", &param.clang_meta_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_advice_win", &param.clang_advice_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_info_win", &param.clang_info_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_del_win", &param.clang_del_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_rule_win", &param.clang_rule_win_ ) );
-    int_map.insert( IntMap::value_type( "clang_mess_delay", &param.clang_mess_delay_ ) );
-    int_map.insert( IntMap::value_type( "clang_mess_per_cycle", &param.clang_mess_per_cycle_ ) );
-    int_map.insert( IntMap::value_type( "hear_max", &param.hear_max_ ) );
-    int_map.insert( IntMap::value_type( "hear_inc", &param.hear_inc_ ) );
-    int_map.insert( IntMap::value_type( "hear_decay", &param.hear_decay_ ) );
-    int_map.insert( IntMap::value_type( "catch_ban_cycle", &param.catch_ban_cycle_ ) );
-    bool_map.insert( BoolMap::value_type( "coach", &param.coach_mode_ ) );
-    bool_map.insert( BoolMap::value_type( "coach_w_referee", &param.coach_with_referee_mode_ ) );
-    bool_map.insert( BoolMap::value_type( "old_coach_hear", &param.old_coach_hear_ ) );
-    int_map.insert( IntMap::value_type( "send_vi_step", &param.send_vi_step_ ) );
-    bool_map.insert( BoolMap::value_type( "use_offside", &param.use_offside_ ) );
-    double_map.insert( DoubleMap::value_type( "offside_kick_margin", &param.offside_kick_margin_ ) );
-    bool_map.insert( BoolMap::value_type( "forbid_kick_off_offside", &param.forbid_kick_off_offside_ ) );
-    bool_map.insert( BoolMap::value_type( "verbose", &param.verbose_ ) );
-    double_map.insert( DoubleMap::value_type( "offside_active_area_size", &param.offside_active_area_size_ ) );
-    int_map.insert( IntMap::value_type( "slow_down_factor", &param.slow_down_factor_ ) );
-    bool_map.insert( BoolMap::value_type( "synch_mode", &param.synch_mode_ ) );
-    int_map.insert( IntMap::value_type( "synch_offset", &param.synch_offset_ ) );
-    int_map.insert( IntMap::value_type( "synch_micro_sleep", &param.synch_micro_sleep_ ) );
-    int_map.insert( IntMap::value_type( "start_goal_l", &param.start_goal_l_ ) );
-    int_map.insert( IntMap::value_type( "start_goal_r", &param.start_goal_r_ ) );
-    bool_map.insert( BoolMap::value_type( "fullstate_l", &param.fullstate_l_ ) );
-    bool_map.insert( BoolMap::value_type( "fullstate_r", &param.fullstate_r_ ) );
-    double_map.insert( DoubleMap::value_type( "slowness_on_top_for_left_team", &param.slowness_on_top_for_left_team_ ) );
-    double_map.insert( DoubleMap::value_type( "slowness_on_top_for_right_team", &param.slowness_on_top_for_right_team_ ) );
-    string_map.insert( StringMap::value_type( "landmark_file", &param.landmark_file_ ) );
-    bool_map.insert( BoolMap::value_type( "send_comms", &param.send_comms_ ) );
-    bool_map.insert( BoolMap::value_type( "text_logging", &param.text_logging_ ) );
-    bool_map.insert( BoolMap::value_type( "game_logging", &param.game_logging_ ) );
-    int_map.insert( IntMap::value_type( "game_log_version", &param.game_log_version_ ) );
-    string_map.insert( StringMap::value_type( "text_log_dir", &param.text_log_dir_ ) );
-    string_map.insert( StringMap::value_type( "game_log_dir", &param.game_log_dir_ ) );
-    string_map.insert( StringMap::value_type( "text_log_fixed_name", &param.text_log_fixed_name_ ) );
-    string_map.insert( StringMap::value_type( "game_log_fixed_name", &param.game_log_fixed_name_ ) );
-    bool_map.insert( BoolMap::value_type( "text_log_fixed", &param.text_log_fixed_ ) );
-    bool_map.insert( BoolMap::value_type( "game_log_fixed", &param.game_log_fixed_ ) );
-    bool_map.insert( BoolMap::value_type( "text_log_dated", &param.text_log_dated_ ) );
-    bool_map.insert( BoolMap::value_type( "game_log_dated", &param.game_log_dated_ ) );
-    string_map.insert( StringMap::value_type( "log_date_format", &param.log_date_format_ ) );
-    bool_map.insert( BoolMap::value_type( "log_times", &param.log_times_ ) );
-    bool_map.insert( BoolMap::value_type( "record_messages", &param.record_messages_ ) );
-    int_map.insert( IntMap::value_type( "text_log_compression", &param.text_log_compression_ ) );
-    int_map.insert( IntMap::value_type( "game_log_compression", &param.game_log_compression_ ) );
-    bool_map.insert( BoolMap::value_type( "profile", &param.profile_ ) );
-    int_map.insert( IntMap::value_type( "point_to_ban", &param.point_to_ban_ ) );
-    int_map.insert( IntMap::value_type( "point_to_duration", &param.point_to_duration_ ) );
-    double_map.insert( DoubleMap::value_type( "tackle_dist", &param.tackle_dist_ ) );
-    double_map.insert( DoubleMap::value_type( "tackle_back_dist", &param.tackle_back_dist_ ) );
-    double_map.insert( DoubleMap::value_type( "tackle_width", &param.tackle_width_ ) );
-    double_map.insert( DoubleMap::value_type( "tackle_exponent", &param.tackle_exponent_ ) );
-    int_map.insert( IntMap::value_type( "tackle_cycles", &param.tackle_cycles_ ) );
-    double_map.insert( DoubleMap::value_type( "tackle_power_rate", &param.tackle_power_rate_ ) );
-    int_map.insert( IntMap::value_type( "freeform_wait_period", &param.freeform_wait_period_ ) );
-    int_map.insert( IntMap::value_type( "freeform_send_period", &param.freeform_send_period_ ) );
-    bool_map.insert( BoolMap::value_type( "free_kick_faults", &param.free_kick_faults_ ) );
-    bool_map.insert( BoolMap::value_type( "back_passes", &param.back_passes_ ) );
-    bool_map.insert( BoolMap::value_type( "proper_goal_kicks", &param.proper_goal_kicks_ ) );
-    double_map.insert( DoubleMap::value_type( "stopped_ball_vel", &param.stopped_ball_vel_ ) );
-    int_map.insert( IntMap::value_type( "max_goal_kicks", &param.max_goal_kicks_ ) );
-    bool_map.insert( BoolMap::value_type( "auto_mode", &param.auto_mode_ ) );
-    int_map.insert( IntMap::value_type( "kick_off_wait", &param.kick_off_wait_ ) );
-    int_map.insert( IntMap::value_type( "connect_wait", &param.connect_wait_ ) );
-    int_map.insert( IntMap::value_type( "game_over_wait", &param.game_over_wait_ ) );
-    string_map.insert( StringMap::value_type( "team_l_start", &param.team_l_start_ ) );
-    string_map.insert( StringMap::value_type( "team_r_start", &param.team_r_start_ ) );
-    bool_map.insert( BoolMap::value_type( "keepaway", &param.keepaway_mode_ ) );
-    double_map.insert( DoubleMap::value_type( "keepaway_length", &param.keepaway_length_ ) );
-    double_map.insert( DoubleMap::value_type( "keepaway_width", &param.keepaway_width_ ) );
-    bool_map.insert( BoolMap::value_type( "keepaway_logging", &param.keepaway_logging_ ) );
-    string_map.insert( StringMap::value_type( "keepaway_log_dir", &param.keepaway_log_dir_ ) );
-    string_map.insert( StringMap::value_type( "keepaway_log_fixed_name", &param.keepaway_log_fixed_name_ ) );
-    bool_map.insert( BoolMap::value_type( "keepaway_log_fixed", &param.keepaway_log_fixed_ ) );
-    bool_map.insert( BoolMap::value_type( "keepaway_log_dated", &param.keepaway_log_dated_ ) );
-    int_map.insert( IntMap::value_type( "keepaway_start", &param.keepaway_start_ ) );
-    int_map.insert( IntMap::value_type( "nr_normal_halfs", &param.nr_normal_halfs_ ) );
-    int_map.insert( IntMap::value_type( "nr_extra_halfs", &param.nr_extra_halfs_ ) );
-    bool_map.insert( BoolMap::value_type( "penalty_shoot_outs", &param.penalty_shoot_outs_ ) );
-    int_map.insert( IntMap::value_type( "pen_before_setup_wait", &param.pen_before_setup_wait_ ) );
-    int_map.insert( IntMap::value_type( "pen_setup_wait", &param.pen_setup_wait_ ) );
-    int_map.insert( IntMap::value_type( "pen_ready_wait", &param.pen_ready_wait_ ) );
-    int_map.insert( IntMap::value_type( "pen_taken_wait", &param.pen_taken_wait_ ) );
-    int_map.insert( IntMap::value_type( "pen_nr_kicks", &param.pen_nr_kicks_ ) );
-    int_map.insert( IntMap::value_type( "pen_max_extra_kicks", &param.pen_max_extra_kicks_ ) );
-    double_map.insert( DoubleMap::value_type( "pen_dist_x", &param.pen_dist_x_ ) );
-    bool_map.insert( BoolMap::value_type( "pen_random_winner", &param.pen_random_winner_ ) );
-    double_map.insert( DoubleMap::value_type( "pen_max_goalie_dist_x", &param.pen_max_goalie_dist_x_ ) );
-    bool_map.insert( BoolMap::value_type( "pen_allow_mult_kicks", &param.pen_allow_mult_kicks_ ) );
-    bool_map.insert( BoolMap::value_type( "pen_coach_moves_players", &param.pen_coach_moves_players_ ) );
-    // v11
-    double_map.insert( DoubleMap::value_type( "ball_stuck_area", &param.ball_stuck_area_ ) );
-    string_map.insert( StringMap::value_type( "coach_msg_file", &param.coach_msg_file_ ) );
-    // v12
-    double_map.insert( DoubleMap::value_type( "max_tackle_power", &param.max_tackle_power_ ) );
-    double_map.insert( DoubleMap::value_type( "max_back_tackle_power", &param.max_back_tackle_power_ ) );
-    double_map.insert( DoubleMap::value_type( "player_speed_max_min", &param.player_speed_max_min_ ) );
-    double_map.insert( DoubleMap::value_type( "extra_stamina", &param.extra_stamina_ ) );
-    int_map.insert( IntMap::value_type( "synch_see_offset", &param.synch_see_offset_ ) );
-    int_map.insert( IntMap::value_type( "max_monitors", &param.max_monitors_ ) );
-    // v12.1.3
-    int_map.insert( IntMap::value_type( "extra_half_time", &param.extra_half_time_ ) );
-    // v13
-    double_map.insert( DoubleMap::value_type( "stamina_capacity", &param.stamina_capacity_ ) );
-    double_map.insert( DoubleMap::value_type( "max_dash_angle", &param.max_dash_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "min_dash_angle", &param.min_dash_angle_ ) );
-    double_map.insert( DoubleMap::value_type( "dash_angle_step", &param.dash_angle_step_ ) );
-    double_map.insert( DoubleMap::value_type( "side_dash_rate", &param.side_dash_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "back_dash_rate", &param.back_dash_rate_ ) );
-    double_map.insert( DoubleMap::value_type( "max_dash_power", &param.max_dash_power_ ) );
-    double_map.insert( DoubleMap::value_type( "min_dash_power", &param.min_dash_power_ ) );
-    // 14.0.0
-    double_map.insert( DoubleMap::value_type( "tackle_rand_factor", &param.tackle_rand_factor_ ) );
-    double_map.insert( DoubleMap::value_type( "foul_detect_probability", &param.foul_detect_probability_ ) );
-    double_map.insert( DoubleMap::value_type( "foul_exponent", &param.foul_exponent_ ) );
-    int_map.insert( IntMap::value_type( "foul_cycles", &param.foul_cycles_ ) );
-    bool_map.insert( BoolMap::value_type( "golden_goal", &param.golden_goal_ ) );
-    // 15.0
-    double_map.insert( DoubleMap::value_type( "red_card_probability", &param.red_card_probability_ ) );
+    static ParamMap< ServerParamT > s_param_map;
+    if ( ! s_param_map.built() )
+    {
+        s_param_map.add( "goal_width", &ServerParamT::goal_width_ );
+        s_param_map.add( "inertia_moment", &ServerParamT::inertia_moment_ );
+        s_param_map.add( "player_size", &ServerParamT::player_size_ );
+        s_param_map.add( "player_decay", &ServerParamT::player_decay_ );
+        s_param_map.add( "player_rand", &ServerParamT::player_rand_ );
+        s_param_map.add( "player_weight", &ServerParamT::player_weight_ );
+        s_param_map.add( "player_speed_max", &ServerParamT::player_speed_max_ );
+        s_param_map.add( "player_accel_max", &ServerParamT::player_accel_max_ );
+        s_param_map.add( "stamina_max", &ServerParamT::stamina_max_ );
+        s_param_map.add( "stamina_inc_max", &ServerParamT::stamina_inc_max_ );
+        s_param_map.add( "recover_init", &ServerParamT::recover_init_ ); // not necessary
+        s_param_map.add( "recover_dec_thr", &ServerParamT::recover_dec_thr_ );
+        s_param_map.add( "recover_min", &ServerParamT::recover_min_ );
+        s_param_map.add( "recover_dec", &ServerParamT::recover_dec_ );
+        s_param_map.add( "effort_init", &ServerParamT::effort_init_ );
+        s_param_map.add( "effort_dec_thr", &ServerParamT::effort_dec_thr_ );
+        s_param_map.add( "effort_min", &ServerParamT::effort_min_ );
+        s_param_map.add( "effort_dec", &ServerParamT::effort_dec_ );
+        s_param_map.add( "effort_inc_thr", &ServerParamT::effort_inc_thr_ );
+        s_param_map.add( "effort_inc", &ServerParamT::effort_inc_ );
+        s_param_map.add( "kick_rand", &ServerParamT::kick_rand_ );
+        s_param_map.add( "team_actuator_noise", &ServerParamT::team_actuator_noise_ );
+        s_param_map.add( "prand_factor_l", &ServerParamT::player_rand_factor_l_ );
+        s_param_map.add( "prand_factor_r", &ServerParamT::player_rand_factor_r_ );
+        s_param_map.add( "kick_rand_factor_l", &ServerParamT::kick_rand_factor_l_ );
+        s_param_map.add( "kick_rand_factor_r", &ServerParamT::kick_rand_factor_r_ );
+        s_param_map.add( "ball_size", &ServerParamT::ball_size_ );
+        s_param_map.add( "ball_decay", &ServerParamT::ball_decay_ );
+        s_param_map.add( "ball_rand", &ServerParamT::ball_rand_ );
+        s_param_map.add( "ball_weight", &ServerParamT::ball_weight_ );
+        s_param_map.add( "ball_speed_max", &ServerParamT::ball_speed_max_ );
+        s_param_map.add( "ball_accel_max", &ServerParamT::ball_accel_max_ );
+        s_param_map.add( "dash_power_rate", &ServerParamT::dash_power_rate_ );
+        s_param_map.add( "kick_power_rate", &ServerParamT::kick_power_rate_ );
+        s_param_map.add( "kickable_margin", &ServerParamT::kickable_margin_ );
+        s_param_map.add( "control_radius", &ServerParamT::control_radius_ );
+        //s_param_map.add( "control_radius_width", &ServerParamT::control_radius_width_ );
+        //s_param_map.add( "kickable_area", &ServerParamT::kickable_area_ ); // not needed
+        s_param_map.add( "catch_probability", &ServerParamT::catch_probability_ );
+        s_param_map.add( "catchable_area_l", &ServerParamT::catchable_area_l_ );
+        s_param_map.add( "catchable_area_w", &ServerParamT::catchable_area_w_ );
+        s_param_map.add( "goalie_max_moves", &ServerParamT::goalie_max_moves_ );
+        s_param_map.add( "maxpower", &ServerParamT::max_power_ );
+        s_param_map.add( "minpower", &ServerParamT::min_power_ );
+        s_param_map.add( "maxmoment", &ServerParamT::max_moment_ );
+        s_param_map.add( "minmoment", &ServerParamT::min_moment_ );
+        s_param_map.add( "maxneckmoment", &ServerParamT::max_neck_moment_ );
+        s_param_map.add( "minneckmoment", &ServerParamT::min_neck_moment_ );
+        s_param_map.add( "maxneckang", &ServerParamT::max_neck_angle_ );
+        s_param_map.add( "minneckang", &ServerParamT::min_neck_angle_ );
+        s_param_map.add( "visible_angle", &ServerParamT::visible_angle_ );
+        s_param_map.add( "visible_distance", &ServerParamT::visible_distance_ );
+        s_param_map.add( "audio_cut_dist", &ServerParamT::audio_cut_dist_ );
+        s_param_map.add( "quantize_step", &ServerParamT::quantize_step_ );
+        s_param_map.add( "quantize_step_l", &ServerParamT::landmark_quantize_step_ );
+        //s_param_map.add( "quantize_step_dir", &ServerParamT::dir_quantize_step_ );
+        //s_param_map.add( "quantize_step_dist_team_l", &ServerParamT::dist_quantize_step_l_ );
+        //s_param_map.add( "quantize_step_dist_team_r", &ServerParamT::dist_quantize_step_r_ );
+        //s_param_map.add( "quantize_step_dist_l_team_l", &ServerParamT::landmark_dist_quantize_step_l_ );
+        //s_param_map.add( "quantize_step_dist_l_team_r", &ServerParamT::landmark_dist_quantize_step_r_ );
+        //s_param_map.add( "quantize_step_dir_team_l", &ServerParamT::dir_quantize_step_l_ );
+        //s_param_map.add( "quantize_step_dir_team_r", &ServerParamT::dir_quantize_step_r_ );
+        s_param_map.add( "ckick_margin", &ServerParamT::corner_kick_margin_ );
+        s_param_map.add( "wind_dir", &ServerParamT::wind_dir_ );
+        s_param_map.add( "wind_force", &ServerParamT::wind_force_ );
+        s_param_map.add( "wind_ang", &ServerParamT::wind_angle_ );
+        s_param_map.add( "wind_rand", &ServerParamT::wind_rand_ );
+        s_param_map.add( "wind_none", &ServerParamT::wind_none_ );
+        s_param_map.add( "wind_random", &ServerParamT::wind_random_ );
+        s_param_map.add( "half_time", &ServerParamT::half_time_ );
+        s_param_map.add( "drop_ball_time", &ServerParamT::drop_ball_time_ );
+        s_param_map.add( "port", &ServerParamT::port_ );
+        s_param_map.add( "coach_port", &ServerParamT::coach_port_ );
+        s_param_map.add( "olcoach_port", &ServerParamT::online_coach_port_ );
+        s_param_map.add( "say_coach_cnt_max", &ServerParamT::say_coach_count_max_ );
+        s_param_map.add( "say_coach_msg_size", &ServerParamT::say_coach_msg_size_ );
+        s_param_map.add( "simulator_step", &ServerParamT::simulator_step_ );
+        s_param_map.add( "send_step", &ServerParamT::send_step_ );
+        s_param_map.add( "recv_step", &ServerParamT::recv_step_ );
+        s_param_map.add( "sense_body_step", &ServerParamT::sense_body_step_ );
+        //s_param_map.add( "lcm_step", &ServerParamT::lcm_step_ ); // not needed
+        s_param_map.add( "say_msg_size", &ServerParamT::say_msg_size_ );
+        s_param_map.add( "clang_win_size", &ServerParamT::clang_win_size_ );
+        s_param_map.add( "clang_define_win", &ServerParamT::clang_define_win_ );
+        s_param_map.add( "clang_meta_win", &ServerParamT::clang_meta_win_ );
+        s_param_map.add( "clang_advice_win", &ServerParamT::clang_advice_win_ );
+        s_param_map.add( "clang_info_win", &ServerParamT::clang_info_win_ );
+        s_param_map.add( "clang_del_win", &ServerParamT::clang_del_win_ );
+        s_param_map.add( "clang_rule_win", &ServerParamT::clang_rule_win_ );
+        s_param_map.add( "clang_mess_delay", &ServerParamT::clang_mess_delay_ );
+        s_param_map.add( "clang_mess_per_cycle", &ServerParamT::clang_mess_per_cycle_ );
+        s_param_map.add( "hear_max", &ServerParamT::hear_max_ );
+        s_param_map.add( "hear_inc", &ServerParamT::hear_inc_ );
+        s_param_map.add( "hear_decay", &ServerParamT::hear_decay_ );
+        s_param_map.add( "catch_ban_cycle", &ServerParamT::catch_ban_cycle_ );
+        s_param_map.add( "coach", &ServerParamT::coach_mode_ );
+        s_param_map.add( "coach_w_referee", &ServerParamT::coach_with_referee_mode_ );
+        s_param_map.add( "old_coach_hear", &ServerParamT::old_coach_hear_ );
+        s_param_map.add( "send_vi_step", &ServerParamT::send_vi_step_ );
+        s_param_map.add( "use_offside", &ServerParamT::use_offside_ );
+        s_param_map.add( "offside_kick_margin", &ServerParamT::offside_kick_margin_ );
+        s_param_map.add( "forbid_kick_off_offside", &ServerParamT::forbid_kick_off_offside_ );
+        s_param_map.add( "verbose", &ServerParamT::verbose_ );
+        s_param_map.add( "offside_active_area_size", &ServerParamT::offside_active_area_size_ );
+        s_param_map.add( "slow_down_factor", &ServerParamT::slow_down_factor_ );
+        s_param_map.add( "synch_mode", &ServerParamT::synch_mode_ );
+        s_param_map.add( "synch_offset", &ServerParamT::synch_offset_ );
+        s_param_map.add( "synch_micro_sleep", &ServerParamT::synch_micro_sleep_ );
+        s_param_map.add( "start_goal_l", &ServerParamT::start_goal_l_ );
+        s_param_map.add( "start_goal_r", &ServerParamT::start_goal_r_ );
+        s_param_map.add( "fullstate_l", &ServerParamT::fullstate_l_ );
+        s_param_map.add( "fullstate_r", &ServerParamT::fullstate_r_ );
+        s_param_map.add( "slowness_on_top_for_left_team", &ServerParamT::slowness_on_top_for_left_team_ );
+        s_param_map.add( "slowness_on_top_for_right_team", &ServerParamT::slowness_on_top_for_right_team_ );
+        s_param_map.add( "landmark_file", &ServerParamT::landmark_file_ );
+        s_param_map.add( "send_comms", &ServerParamT::send_comms_ );
+        s_param_map.add( "text_logging", &ServerParamT::text_logging_ );
+        s_param_map.add( "game_logging", &ServerParamT::game_logging_ );
+        s_param_map.add( "game_log_version", &ServerParamT::game_log_version_ );
+        s_param_map.add( "text_log_dir", &ServerParamT::text_log_dir_ );
+        s_param_map.add( "game_log_dir", &ServerParamT::game_log_dir_ );
+        s_param_map.add( "text_log_fixed_name", &ServerParamT::text_log_fixed_name_ );
+        s_param_map.add( "game_log_fixed_name", &ServerParamT::game_log_fixed_name_ );
+        s_param_map.add( "text_log_fixed", &ServerParamT::text_log_fixed_ );
+        s_param_map.add( "game_log_fixed", &ServerParamT::game_log_fixed_ );
+        s_param_map.add( "text_log_dated", &ServerParamT::text_log_dated_ );
+        s_param_map.add( "game_log_dated", &ServerParamT::game_log_dated_ );
+        s_param_map.add( "log_date_format", &ServerParamT::log_date_format_ );
+        s_param_map.add( "log_times", &ServerParamT::log_times_ );
+        s_param_map.add( "record_messages", &ServerParamT::record_messages_ );
+        s_param_map.add( "text_log_compression", &ServerParamT::text_log_compression_ );
+        s_param_map.add( "game_log_compression", &ServerParamT::game_log_compression_ );
+        s_param_map.add( "profile", &ServerParamT::profile_ );
+        s_param_map.add( "point_to_ban", &ServerParamT::point_to_ban_ );
+        s_param_map.add( "point_to_duration", &ServerParamT::point_to_duration_ );
+        s_param_map.add( "tackle_dist", &ServerParamT::tackle_dist_ );
+        s_param_map.add( "tackle_back_dist", &ServerParamT::tackle_back_dist_ );
+        s_param_map.add( "tackle_width", &ServerParamT::tackle_width_ );
+        s_param_map.add( "tackle_exponent", &ServerParamT::tackle_exponent_ );
+        s_param_map.add( "tackle_cycles", &ServerParamT::tackle_cycles_ );
+        s_param_map.add( "tackle_power_rate", &ServerParamT::tackle_power_rate_ );
+        s_param_map.add( "freeform_wait_period", &ServerParamT::freeform_wait_period_ );
+        s_param_map.add( "freeform_send_period", &ServerParamT::freeform_send_period_ );
+        s_param_map.add( "free_kick_faults", &ServerParamT::free_kick_faults_ );
+        s_param_map.add( "back_passes", &ServerParamT::back_passes_ );
+        s_param_map.add( "proper_goal_kicks", &ServerParamT::proper_goal_kicks_ );
+        s_param_map.add( "stopped_ball_vel", &ServerParamT::stopped_ball_vel_ );
+        s_param_map.add( "max_goal_kicks", &ServerParamT::max_goal_kicks_ );
+        s_param_map.add( "auto_mode", &ServerParamT::auto_mode_ );
+        s_param_map.add( "kick_off_wait", &ServerParamT::kick_off_wait_ );
+        s_param_map.add( "connect_wait", &ServerParamT::connect_wait_ );
+        s_param_map.add( "game_over_wait", &ServerParamT::game_over_wait_ );
+        s_param_map.add( "team_l_start", &ServerParamT::team_l_start_ );
+        s_param_map.add( "team_r_start", &ServerParamT::team_r_start_ );
+        s_param_map.add( "keepaway", &ServerParamT::keepaway_mode_ );
+        s_param_map.add( "keepaway_length", &ServerParamT::keepaway_length_ );
+        s_param_map.add( "keepaway_width", &ServerParamT::keepaway_width_ );
+        s_param_map.add( "keepaway_logging", &ServerParamT::keepaway_logging_ );
+        s_param_map.add( "keepaway_log_dir", &ServerParamT::keepaway_log_dir_ );
+        s_param_map.add( "keepaway_log_fixed_name", &ServerParamT::keepaway_log_fixed_name_ );
+        s_param_map.add( "keepaway_log_fixed", &ServerParamT::keepaway_log_fixed_ );
+        s_param_map.add( "keepaway_log_dated", &ServerParamT::keepaway_log_dated_ );
+        s_param_map.add( "keepaway_start", &ServerParamT::keepaway_start_ );
+        s_param_map.add( "nr_normal_halfs", &ServerParamT::nr_normal_halfs_ );
+        s_param_map.add( "nr_extra_halfs", &ServerParamT::nr_extra_halfs_ );
+        s_param_map.add( "penalty_shoot_outs", &ServerParamT::penalty_shoot_outs_ );
+        s_param_map.add( "pen_before_setup_wait", &ServerParamT::pen_before_setup_wait_ );
+        s_param_map.add( "pen_setup_wait", &ServerParamT::pen_setup_wait_ );
+        s_param_map.add( "pen_ready_wait", &ServerParamT::pen_ready_wait_ );
+        s_param_map.add( "pen_taken_wait", &ServerParamT::pen_taken_wait_ );
+        s_param_map.add( "pen_nr_kicks", &ServerParamT::pen_nr_kicks_ );
+        s_param_map.add( "pen_max_extra_kicks", &ServerParamT::pen_max_extra_kicks_ );
+        s_param_map.add( "pen_dist_x", &ServerParamT::pen_dist_x_ );
+        s_param_map.add( "pen_random_winner", &ServerParamT::pen_random_winner_ );
+        s_param_map.add( "pen_max_goalie_dist_x", &ServerParamT::pen_max_goalie_dist_x_ );
+        s_param_map.add( "pen_allow_mult_kicks", &ServerParamT::pen_allow_mult_kicks_ );
+        s_param_map.add( "pen_coach_moves_players", &ServerParamT::pen_coach_moves_players_ );
+        // v11
+        s_param_map.add( "ball_stuck_area", &ServerParamT::ball_stuck_area_ );
+        s_param_map.add( "coach_msg_file", &ServerParamT::coach_msg_file_ );
+        // v12
+        s_param_map.add( "max_tackle_power", &ServerParamT::max_tackle_power_ );
+        s_param_map.add( "max_back_tackle_power", &ServerParamT::max_back_tackle_power_ );
+        s_param_map.add( "player_speed_max_min", &ServerParamT::player_speed_max_min_ );
+        s_param_map.add( "extra_stamina", &ServerParamT::extra_stamina_ );
+        s_param_map.add( "synch_see_offset", &ServerParamT::synch_see_offset_ );
+        s_param_map.add( "max_monitors", &ServerParamT::max_monitors_ );
+        // v12.1.3
+        s_param_map.add( "extra_half_time", &ServerParamT::extra_half_time_ );
+        // v13
+        s_param_map.add( "stamina_capacity", &ServerParamT::stamina_capacity_ );
+        s_param_map.add( "max_dash_angle", &ServerParamT::max_dash_angle_ );
+        s_param_map.add( "min_dash_angle", &ServerParamT::min_dash_angle_ );
+        s_param_map.add( "dash_angle_step", &ServerParamT::dash_angle_step_ );
+        s_param_map.add( "side_dash_rate", &ServerParamT::side_dash_rate_ );
+        s_param_map.add( "back_dash_rate", &ServerParamT::back_dash_rate_ );
+        s_param_map.add( "max_dash_power", &ServerParamT::max_dash_power_ );
+        s_param_map.add( "min_dash_power", &ServerParamT::min_dash_power_ );
+        // 14.0.0
+        s_param_map.add( "tackle_rand_factor", &ServerParamT::tackle_rand_factor_ );
+        s_param_map.add( "foul_detect_probability", &ServerParamT::foul_detect_probability_ );
+        s_param_map.add( "foul_exponent", &ServerParamT::foul_exponent_ );
+        s_param_map.add( "foul_cycles", &ServerParamT::foul_cycles_ );
+        s_param_map.add( "golden_goal", &ServerParamT::golden_goal_ );
+        // 15.0
+        s_param_map.add( "red_card_probability", &ServerParamT::red_card_probability_ );
+        s_param_map.build();
+    }
 
     //
     // parse
     //
 
-    if ( ! parse_param_line( n_line, line,
-                             int_map, double_map, bool_map, string_map ) )
+    if ( ! parse_param_line( n_line, line, param, s_param_map ) )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal server_param line. \"" << line << "\"" << std::endl;;
@@ -0,0 +1,856 @@
+// -*-c++-*-
+
+/*!
+  \file parser_bench.cpp
+  \brief throughput benchmark for the rcg parser.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef PARSER_BENCH_USE_DISP_HOLDER
+#include <QApplication>
+#include "disp_holder.h"
+#include "options.h"
+#endif
+
+#include "gzfstream.h"
+#include "handler.h"
+#include "parser.h"
+#include "types.h"
+#include "util.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <new>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+
+#if __cplusplus >= 201103L
+#define PARSER_BENCH_THROW_BAD_ALLOC
+#define PARSER_BENCH_NOTHROW noexcept
+#else
+#define PARSER_BENCH_THROW_BAD_ALLOC throw( std::bad_alloc )
+#define PARSER_BENCH_NOTHROW throw()
+#endif
+
+namespace {
+
+//! the number of heap allocations. counted by the global operator new.
+long g_allocation_count = 0;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  count all heap allocations in this program.
+ */
+void *
+operator new( std::size_t size ) PARSER_BENCH_THROW_BAD_ALLOC
+{
+    ++g_allocation_count;
+    void * p = std::malloc( size == 0 ? 1 : size );
+    if ( ! p )
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+operator delete( void * p ) PARSER_BENCH_NOTHROW
+{
+    std::free( p );
+}
+
+#if __cplusplus >= 201402L
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+operator delete( void * p,
+                 std::size_t ) PARSER_BENCH_NOTHROW
+{
+    std::free( p );
+}
+#endif
+
+using namespace rcss::rcg;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief handler that only counts the received data.
+ */
+class CountingHandler
+    : public Handler {
+private:
+    int M_log_version;
+    long M_show_count;
+    long M_other_count;
+
+public:
+    CountingHandler()
+        : M_log_version( 0 )
+        , M_show_count( 0 )
+        , M_other_count( 0 )
+      { }
+
+    long count() const { return M_show_count + M_other_count; }
+
+protected:
+    void doHandleLogVersion( int ver ) { M_log_version = ver; }
+    int doGetLogVersion() const { return M_log_version; }
+    void doHandleShowInfo( const ShowInfoT & ) { ++M_show_count; }
+    void doHandleMsgInfo( const int, const int, const std::string & ) { ++M_other_count; }
+    void doHandlePlayMode( const int, const PlayMode ) { ++M_other_count; }
+    void doHandleTeamInfo( const int, const TeamT &, const TeamT & ) { ++M_other_count; }
+    void doHandleDrawClear( const int ) { ++M_other_count; }
+    void doHandleDrawPointInfo( const int, const PointInfoT & ) { ++M_other_count; }
+    void doHandleDrawCircleInfo( const int, const CircleInfoT & ) { ++M_other_count; }
+    void doHandleDrawLineInfo( const int, const LineInfoT & ) { ++M_other_count; }
+    void doHandleServerParam( const ServerParamT & ) { ++M_other_count; }
+    void doHandlePlayerParam( const PlayerParamT & ) { ++M_other_count; }
+    void doHandlePlayerType( const PlayerTypeT & ) { ++M_other_count; }
+    void doHandleEOF() { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief generated input data
+ */
+struct Input {
+    std::string name_; //!< input name
+    std::string path_; //!< temporary file path
+    long records_; //!< the number of lines or binary records
+    long bytes_; //!< uncompressed data size
+    bool compressed_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief measurement result
+ */
+struct Result {
+    double sec_;
+    long allocations_;
+
+    Result()
+        : sec_( 0.0 )
+        , allocations_( 0 )
+      { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create a show data.
+  players move around the ball with various states.
+ */
+ShowInfoT
+create_show( const int t )
+{
+    ShowInfoT show;
+
+    show.time_ = t;
+
+    const double ball_x = -45.0 + ( t % 900 ) * 0.1;
+    const double ball_y = 20.0 * std::sin( t * 0.01 );
+
+    show.ball_.x_ = ball_x;
+    show.ball_.y_ = ball_y;
+    show.ball_.vx_ = 1.2345f;
+    show.ball_.vy_ = -0.5432f;
+
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        PlayerT & p = show.player_[i];
+        const double angle = i * 0.2856 + t * 0.013;
+        const double r = 2.0 + ( i % 11 ) * 3.0;
+
+        p.side_ = ( i < MAX_PLAYER ? 'l' : 'r' );
+        p.unum_ = i % MAX_PLAYER + 1;
+        p.type_ = i % 18;
+        p.state_ = STAND | ( ( t + i ) % 7 == 0 ? KICK : 0 ) | ( p.unum_ == 1 ? GOALIE : 0 );
+        p.x_ = ball_x + r * std::cos( angle );
+        p.y_ = ball_y + r * std::sin( angle );
+        p.vx_ = 0.1234f * ( i % 5 );
+        p.vy_ = -0.0567f * ( i % 3 );
+        p.body_ = std::fmod( t * 3.0 + i * 17.0, 360.0 ) - 180.0;
+        p.neck_ = ( i % 9 ) * 10.0 - 40.0;
+        if ( i % 6 == 0 )
+        {
+            p.point_x_ = ball_x + 10.0;
+            p.point_y_ = ball_y - 5.0;
+        }
+        p.view_quality_ = 'h';
+        p.view_width_ = ( i % 3 == 0 ? 60.0 : 120.0 );
+        p.stamina_ = 8000.0 - ( ( t * 7 + i * 300 ) % 6000 );
+        p.effort_ = ( i % 4 == 0 ? 0.8654f : 1.0f );
+        p.recovery_ = 1.0f;
+        p.stamina_capacity_ = 130600.0f - t * 3.0f;
+        if ( i % 5 == 0 )
+        {
+            p.focus_side_ = p.side_;
+            p.focus_unum_ = ( p.unum_ % MAX_PLAYER ) + 1;
+        }
+        p.kick_count_ = t / 10;
+        p.dash_count_ = t / 2;
+        p.turn_count_ = t / 4;
+        p.catch_count_ = 0;
+        p.move_count_ = 1;
+        p.turn_neck_count_ = t / 3;
+        p.change_view_count_ = t / 50;
+        p.say_count_ = t / 20;
+        p.tackle_count_ = t / 200;
+        p.pointto_count_ = t / 100;
+        p.attentionto_count_ = t / 100;
+    }
+
+    return show;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief make a text show line in the v4/v5 format.
+ */
+std::string
+to_show_line( const ShowInfoT & show,
+              const int version )
+{
+    std::ostringstream os;
+    char buf[256];
+
+    os << "(show " << show.time_;
+
+    snprintf( buf, sizeof( buf ), " ((b) %.4f %.4f %.4f %.4f)",
+              show.ball_.x_, show.ball_.y_, show.ball_.vx_, show.ball_.vy_ );
+    os << buf;
+
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        const PlayerT & p = show.player_[i];
+        snprintf( buf, sizeof( buf ),
+                  " ((%c %d) %d %x %.4f %.4f %.4f %.4f %.3f %.3f",
+                  p.side_, p.unum_, p.type_, p.state_,
+                  p.x_, p.y_, p.vx_, p.vy_, p.body_, p.neck_ );
+        os << buf;
+        if ( p.isPointing() )
+        {
+            snprintf( buf, sizeof( buf ), " %.4f %.4f", p.point_x_, p.point_y_ );
+            os << buf;
+        }
+        snprintf( buf, sizeof( buf ), " (v %c %.0f)", p.view_quality_, p.view_width_ );
+        os << buf;
+        if ( version >= REC_VERSION_5 )
+        {
+            snprintf( buf, sizeof( buf ), " (s %.4f %.6f %.6f %.4f)",
+                      p.stamina_, p.effort_, p.recovery_, p.stamina_capacity_ );
+            os << buf;
+            if ( p.isFocusing() )
+            {
+                snprintf( buf, sizeof( buf ), " (f %c %d)", p.focus_side_, p.focus_unum_ );
+                os << buf;
+            }
+        }
+        else
+        {
+            snprintf( buf, sizeof( buf ), " (s %.4f %.6f %.6f)",
+                      p.stamina_, p.effort_, p.recovery_ );
+            os << buf;
+        }
+        snprintf( buf, sizeof( buf ), " (c %d %d %d %d %d %d %d %d %d %d %d))",
+                  p.kick_count_, p.dash_count_, p.turn_count_, p.catch_count_,
+                  p.move_count_, p.turn_neck_count_, p.change_view_count_,
+                  p.say_count_, p.tackle_count_, p.pointto_count_, p.attentionto_count_ );
+        os << buf;
+    }
+
+    os << ')';
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief make the text header lines (parameters).
+ */
+void
+create_param_lines( std::vector< std::string > & lines )
+{
+    lines.push_back( "(server_param (audio_cut_dist 50)(auto_mode 0)(back_dash_rate 0.6)"
+                     "(back_passes 1)(ball_accel_max 2.7)(ball_decay 0.94)(ball_rand 0.05)"
+                     "(ball_size 0.085)(ball_speed_max 3)(ball_stuck_area 3)(ball_weight 0.2)"
+                     "(catch_ban_cycle 5)(catch_probability 1)(catchable_area_l 1.2)"
+                     "(catchable_area_w 1)(ckick_margin 1)(clang_advice_win 1)(coach 0)"
+                     "(coach_msg_file \"\")(coach_port 6001)(coach_w_referee 0)"
+                     "(connect_wait 300)(control_radius 2)(dash_angle_step 45)"
+                     "(dash_power_rate 0.006)(drop_ball_time 100)(effort_dec 0.005)"
+                     "(effort_dec_thr 0.3)(effort_inc 0.01)(effort_inc_thr 0.6)"
+                     "(effort_init 1)(effort_min 0.6)(extra_half_time 100)"
+                     "(extra_stamina 50)(forbid_kick_off_offside 1)(foul_cycles 5)"
+                     "(foul_detect_probability 0.5)(foul_exponent 10)(free_kick_faults 1)"
+                     "(freeform_send_period 20)(freeform_wait_period 600)(fullstate_l 0)"
+                     "(fullstate_r 0)(game_log_compression 0)(game_log_dated 1)"
+                     "(game_log_dir \"./\")(game_log_fixed 0)(game_log_fixed_name \"rcssserver\")"
+                     "(game_log_version 5)(game_logging 1)(game_over_wait 100)(goal_width 14.02)"
+                     "(goalie_max_moves 2)(golden_goal 0)(half_time 300)(hear_decay 1)"
+                     "(hear_inc 1)(hear_max 1)(inertia_moment 5)(keepaway 0)"
+                     "(kick_off_wait 100)(kick_power_rate 0.027)(kick_rand 0.1)"
+                     "(kickable_margin 0.7)(landmark_file \"~/.rcssserver-landmark.xml\")"
+                     "(log_date_format \"%Y%m%d%H%M%S-\")(log_times 0)(max_dash_angle 180)"
+                     "(max_dash_power 100)(max_goal_kicks 3)(max_tackle_power 100)"
+                     "(maxmoment 180)(maxneckang 90)(maxneckmoment 180)(maxpower 100)"
+                     "(min_dash_angle -180)(min_dash_power -100)(minmoment -180)"
+                     "(minneckang -90)(minneckmoment -180)(minpower -100)(nr_extra_halfs 2)"
+                     "(nr_normal_halfs 2)(offside_active_area_size 2.5)(offside_kick_margin 9.15)"
+                     "(olcoach_port 6002)(old_coach_hear 0)(pen_allow_mult_kicks 1)"
+                     "(pen_before_setup_wait 10)(pen_dist_x 42.5)(pen_max_extra_kicks 5)"
+                     "(penalty_shoot_outs 1)(player_accel_max 1)(player_decay 0.4)"
+                     "(player_rand 0.1)(player_size 0.3)(player_speed_max 1.05)"
+                     "(player_weight 60)(point_to_ban 5)(point_to_duration 20)(port 6000)"
+                     "(prand_factor_l 1)(prand_factor_r 1)(profile 0)(proper_goal_kicks 0)"
+                     "(quantize_step 0.1)(quantize_step_l 0.01)(record_messages 0)"
+                     "(recover_dec 0.002)(recover_dec_thr 0.3)(recover_init 1)(recover_min 0.5)"
+                     "(recv_step 10)(red_card_probability 0)(say_coach_cnt_max 128)"
+                     "(say_coach_msg_size 128)(say_msg_size 10)(send_comms 0)(send_step 150)"
+                     "(send_vi_step 100)(sense_body_step 100)(side_dash_rate 0.4)"
+                     "(simulator_step 100)(slow_down_factor 1)(slowness_on_top_for_left_team 1)"
+                     "(slowness_on_top_for_right_team 1)(stamina_capacity 130600)"
+                     "(stamina_inc_max 45)(stamina_max 8000)(start_goal_l 0)(start_goal_r 0)"
+                     "(stopped_ball_vel 0.01)(synch_micro_sleep 1)(synch_mode 0)"
+                     "(synch_offset 60)(synch_see_offset 0)(tackle_back_dist 0)"
+                     "(tackle_cycles 10)(tackle_dist 2)(tackle_exponent 6)"
+                     "(tackle_power_rate 0.027)(tackle_rand_factor 2)(tackle_width 1.25)"
+                     "(team_actuator_noise 0)(team_l_start \"\")(team_r_start \"\")"
+                     "(text_log_compression 0)(text_log_dated 1)(text_log_dir \"./\")"
+                     "(text_log_fixed 0)(text_log_fixed_name \"rcssserver\")(text_logging 1)"
+                     "(use_offside 1)(verbose 0)(visible_angle 90)(visible_distance 3)"
+                     "(wind_ang 0)(wind_dir 0)(wind_force 0)(wind_none 0)(wind_rand 0)"
+                     "(wind_random 0))" );
+
+    lines.push_back( "(player_param (allow_mult_default_type 0)(catchable_area_l_stretch_max 1.3)"
+                     "(catchable_area_l_stretch_min 1)(dash_power_rate_delta_max 0)"
+                     "(dash_power_rate_delta_min 0)(effort_max_delta_factor -0.004)"
+                     "(effort_min_delta_factor -0.004)(extra_stamina_delta_max 50)"
+                     "(extra_stamina_delta_min 0)(foul_detect_probability_delta_factor 0)"
+                     "(inertia_moment_delta_factor 25)(kick_power_rate_delta_max 0)"
+                     "(kick_power_rate_delta_min 0)(kick_rand_delta_factor 1)"
+                     "(kickable_margin_delta_max 0.1)(kickable_margin_delta_min -0.1)"
+                     "(new_dash_power_rate_delta_max 0.0008)(new_dash_power_rate_delta_min -0.0012)"
+                     "(new_stamina_inc_max_delta_factor -6000)(player_decay_delta_max 0.1)"
+                     "(player_decay_delta_min -0.1)(player_size_delta_factor -100)"
+                     "(player_speed_max_delta_max 0)(player_speed_max_delta_min 0)"
+                     "(player_types 18)(pt_max 1)(random_seed -1)"
+                     "(stamina_inc_max_delta_factor 0)(subs_max 3))" );
+
+    for ( int id = 0; id < 18; ++id )
+    {
+        char buf[1024];
+        snprintf( buf, sizeof( buf ),
+                  "(player_type (id %d)(player_speed_max 1.05)(stamina_inc_max %.4f)"
+                  "(player_decay %.6f)(inertia_moment %.4f)(dash_power_rate %.6f)"
+                  "(player_size 0.3)(kickable_margin %.6f)(kick_rand %.6f)"
+                  "(extra_stamina %.4f)(effort_max %.6f)(effort_min %.6f)"
+                  "(kick_power_rate 0.027)(foul_detect_probability 0.5)"
+                  "(catchable_area_l_stretch %.6f))",
+                  id,
+                  45.0 - id * 0.71,
+                  0.4 + id * 0.0031,
+                  5.0 + id * 0.17,
+                  0.006 + id * 0.00003,
+                  0.7 + id * 0.0021,
+                  0.1 + id * 0.0011,
+                  id * 2.3,
+                  1.0 - id * 0.0013,
+                  0.6 - id * 0.0013,
+                  1.0 + id * 0.011 );
+        lines.push_back( buf );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write text log data
+ */
+long
+write_text_log( std::ostream & os,
+                const int version,
+                const int n_cycles,
+                long * bytes )
+{
+    static const char * s_playmode_strings[] = PLAYMODE_STRINGS;
+
+    std::vector< std::string > lines;
+    create_param_lines( lines );
+
+    std::ostringstream buf;
+    buf << "ULG" << version << '\n';
+
+    long records = 0;
+    for ( std::vector< std::string >::const_iterator it = lines.begin();
+          it != lines.end();
+          ++it )
+    {
+        buf << *it << '\n';
+        ++records;
+    }
+
+    for ( int t = 1; t <= n_cycles; ++t )
+    {
+        if ( t == 1 || t % 300 == 0 )
+        {
+            buf << "(playmode " << t << ' '
+                << s_playmode_strings[ t == 1 ? PM_KickOff_Left : PM_PlayOn ] << ")\n";
+            buf << "(team " << t << " BenchLeft BenchRight " << t / 1000 << " 0)\n";
+            records += 2;
+        }
+
+        buf << to_show_line( create_show( t ), version ) << '\n';
+        ++records;
+
+        if ( t % 50 == 0 )
+        {
+            buf << "(msg " << t << " 1 \"(bench message)\")\n";
+            ++records;
+        }
+    }
+
+    const std::string data = buf.str();
+    os.write( data.c_str(), data.length() );
+    *bytes = data.length();
+    return records;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write binary log data for the v3 format.
+ */
+template < typename T >
+void
+write_record( std::ostream & os,
+              const Int16 mode,
+              const T & data,
+              long * bytes )
+{
+    const Int16 n_mode = hitons( mode );
+    os.write( reinterpret_cast< const char * >( &n_mode ), sizeof( Int16 ) );
+    os.write( reinterpret_cast< const char * >( &data ), sizeof( T ) );
+    *bytes += sizeof( Int16 ) + sizeof( T );
+}
+
+long
+write_v3_log( std::ostream & os,
+              const int n_cycles,
+              long * bytes )
+{
+    const char header[4] = { 'U', 'L', 'G', static_cast< char >( REC_VERSION_3 ) };
+    os.write( header, 4 );
+    *bytes = 4;
+
+    long records = 0;
+
+    {
+        ServerParamT sparam;
+        server_params_t sparam_t;
+        convert( sparam, sparam_t );
+        write_record( os, PARAM_MODE, sparam_t, bytes );
+
+        PlayerParamT pparam;
+        player_params_t pparam_t;
+        convert( pparam, pparam_t );
+        write_record( os, PPARAM_MODE, pparam_t, bytes );
+
+        records += 2;
+
+        for ( int id = 0; id < 18; ++id )
+        {
+            PlayerTypeT ptype;
+            ptype.id_ = id;
+            player_type_t ptype_t;
+            convert( ptype, ptype_t );
+            write_record( os, PT_MODE, ptype_t, bytes );
+            ++records;
+        }
+    }
+
+    for ( int t = 1; t <= n_cycles; ++t )
+    {
+        if ( t == 1 || t % 300 == 0 )
+        {
+            const char pm = static_cast< char >( t == 1 ? PM_KickOff_Left : PM_PlayOn );
+            write_record( os, PM_MODE, pm, bytes );
+
+            team_t teams[2];
+            convert( TeamT( "BenchLeft", t / 1000, 0, 0 ), teams[0] );
+            convert( TeamT( "BenchRight", 0, 0, 0 ), teams[1] );
+            const Int16 n_mode = hitons( TEAM_MODE );
+            os.write( reinterpret_cast< const char * >( &n_mode ), sizeof( Int16 ) );
+            os.write( reinterpret_cast< const char * >( teams ), sizeof( team_t ) * 2 );
+            *bytes += sizeof( Int16 ) + sizeof( team_t ) * 2;
+
+            records += 2;
+        }
+
+        short_showinfo_t2 show;
+        convert( create_show( t ), show );
+        write_record( os, SHOW_MODE, show, bytes );
+        ++records;
+    }
+
+    return records;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create temporary input files.
+ */
+bool
+create_inputs( const std::string & prefix,
+               const int n_cycles,
+               std::vector< Input > & inputs )
+{
+    const int versions[] = { REC_VERSION_3, REC_VERSION_4, REC_VERSION_5 };
+
+    for ( int v = 0; v < 3; ++v )
+    {
+        for ( int z = 0; z < 2; ++z )
+        {
+            Input input;
+            std::ostringstream name;
+            name << 'v' << versions[v] << ( z == 0 ? "" : "_gz" );
+            input.name_ = name.str();
+            input.path_ = prefix + input.name_ + ( z == 0 ? ".rcg" : ".rcg.gz" );
+            input.compressed_ = ( z != 0 );
+            input.bytes_ = 0;
+
+            boost::shared_ptr< std::ostream > os;
+            if ( input.compressed_ )
+            {
+                os = boost::shared_ptr< std::ostream >( new rcss::gzofstream( input.path_.c_str() ) );
+            }
+            else
+            {
+                os = boost::shared_ptr< std::ostream >( new std::ofstream( input.path_.c_str(),
+                                                                           std::ios_base::out
+                                                                           | std::ios_base::binary ) );
+            }
+
+            if ( ! os->good() )
+            {
+                std::cerr << "Failed to create the input file [" << input.path_ << "]"
+                          << std::endl;
+                return false;
+            }
+
+            input.records_ = ( versions[v] == REC_VERSION_3
+                               ? write_v3_log( *os, n_cycles, &input.bytes_ )
+                               : write_text_log( *os, versions[v], n_cycles, &input.bytes_ ) );
+            os->flush();
+            os.reset();
+
+            inputs.push_back( input );
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief parse the whole file
+ */
+Result
+run_parse( const Input & input,
+           Handler & handler )
+{
+    Result result;
+
+    boost::shared_ptr< std::istream > is;
+    if ( input.compressed_ )
+    {
+        is = boost::shared_ptr< std::istream >( new rcss::gzifstream( input.path_.c_str() ) );
+    }
+    else
+    {
+        is = boost::shared_ptr< std::istream >( new std::ifstream( input.path_.c_str(),
+                                                                   std::ios_base::in
+                                                                   | std::ios_base::binary ) );
+    }
+
+    const long start_allocations = g_allocation_count;
+    const std::clock_t start = std::clock();
+
+    Parser parser( handler );
+    while ( parser.parse( *is ) )
+    {
+
+    }
+
+    result.sec_ = static_cast< double >( std::clock() - start ) / CLOCKS_PER_SEC;
+    result.allocations_ = g_allocation_count - start_allocations;
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief parse each line as a monitor datagram.
+ */
+Result
+run_parse_line( const std::vector< std::string > & lines,
+                Handler & handler )
+{
+    Result result;
+
+    const long start_allocations = g_allocation_count;
+    const std::clock_t start = std::clock();
+
+    Parser parser( handler );
+    int n_line = 0;
+    for ( std::vector< std::string >::const_iterator it = lines.begin();
+          it != lines.end();
+          ++it )
+    {
+        parser.parseLine( ++n_line, *it );
+    }
+
+    result.sec_ = static_cast< double >( std::clock() - start ) / CLOCKS_PER_SEC;
+    result.allocations_ = g_allocation_count - start_allocations;
+
+    return result;
+}
+
+#ifdef PARSER_BENCH_USE_DISP_HOLDER
+/*-------------------------------------------------------------------*/
+/*!
+  \brief parse each line in the same way as MonitorClient
+ */
+Result
+run_add_disp_info( const std::vector< std::string > & lines,
+                   DispHolder & holder )
+{
+    Result result;
+
+    const long start_allocations = g_allocation_count;
+    const std::clock_t start = std::clock();
+
+    for ( std::vector< std::string >::const_iterator it = lines.begin();
+          it != lines.end();
+          ++it )
+    {
+        holder.addDispInfoV3( it->c_str() );
+    }
+
+    result.sec_ = static_cast< double >( std::clock() - start ) / CLOCKS_PER_SEC;
+    result.allocations_ = g_allocation_count - start_allocations;
+
+    return result;
+}
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief print one result line
+ */
+void
+print_result( const std::string & bench_case,
+              const std::string & input,
+              const std::string & handler,
+              const long bytes,
+              const long records,
+              const Result & result )
+{
+    const double sec = std::max( result.sec_, 1.0e-9 );
+    std::cout << bench_case
+              << ',' << input
+              << ',' << handler
+              << ',' << bytes
+              << ',' << records
+              << ',' << result.sec_
+              << ',' << records / sec
+              << ',' << bytes / sec / ( 1024.0 * 1024.0 )
+              << ',' << ( records > 0
+                          ? static_cast< double >( result.allocations_ ) / records
+                          : 0.0 )
+              << std::endl;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char ** argv )
+{
+#ifdef PARSER_BENCH_USE_DISP_HOLDER
+    // QFont in Options requires the application object.
+    QApplication app( argc, argv, false );
+    Options::instance().setBufferingMode( true );
+    // measure the team graphic parsing without the cache.
+    Options::instance().setTeamGraphicCache( false );
+#endif
+
+    int n_cycles = 6000;
+    int loops = 3;
+    std::string prefix = "parser_bench_";
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--cycles" ) && i + 1 < argc )
+        {
+            n_cycles = std::atoi( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--loops" ) && i + 1 < argc )
+        {
+            loops = std::atoi( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--prefix" ) && i + 1 < argc )
+        {
+            prefix = argv[++i];
+        }
+        else
+        {
+            std::cout << "Usage: " << argv[0] << " [--cycles N] [--loops N] [--prefix PATH_PREFIX]\n"
+                      << "  --cycles N  the number of generated show data. (default 6000)\n"
+                      << "  --loops N   the number of repetitions for each case. (default 3)\n"
+                      << "  --prefix    path prefix of the temporary input files. (default parser_bench_)"
+                      << std::endl;
+            return ( ! std::strcmp( argv[i], "--help" ) ? 0 : 1 );
+        }
+    }
+
+    if ( n_cycles <= 0 || loops <= 0 )
+    {
+        std::cerr << "Illegal cycles or loops." << std::endl;
+        return 1;
+    }
+
+    std::vector< Input > inputs;
+    if ( ! create_inputs( prefix, n_cycles, inputs ) )
+    {
+        return 1;
+    }
+
+    std::cout << "case,input,handler,bytes,records,sec,records_per_sec,mb_per_sec,allocs_per_record"
+              << std::endl;
+
+    //
+    // whole file
+    //
+
+    for ( std::vector< Input >::const_iterator it = inputs.begin();
+          it != inputs.end();
+          ++it )
+    {
+        for ( int loop = 0; loop < loops; ++loop )
+        {
+            CountingHandler handler;
+            print_result( "parse", it->name_, "count",
+                          it->bytes_, it->records_,
+                          run_parse( *it, handler ) );
+            if ( handler.count() != it->records_ )
+            {
+                std::cerr << it->name_ << ": parsed " << handler.count()
+                          << " records. expected " << it->records_ << std::endl;
+            }
+        }
+
+#ifdef PARSER_BENCH_USE_DISP_HOLDER
+        for ( int loop = 0; loop < loops; ++loop )
+        {
+            boost::shared_ptr< DispHolder > holder( new DispHolder() );
+            print_result( "parse", it->name_, "disp_holder",
+                          it->bytes_, it->records_,
+                          run_parse( *it, *holder ) );
+        }
+#endif
+    }
+
+    //
+    // single datagrams
+    //
+
+    std::vector< std::string > lines;
+    long line_bytes = 0;
+    for ( int t = 1; t <= n_cycles; ++t )
+    {
+        lines.push_back( to_show_line( create_show( t ), REC_VERSION_5 ) );
+        line_bytes += lines.back().length();
+    }
+
+    for ( int loop = 0; loop < loops; ++loop )
+    {
+        CountingHandler handler;
+        print_result( "parse_line", "v5_show", "count",
+                      line_bytes, static_cast< long >( lines.size() ),
+                      run_parse_line( lines, handler ) );
+    }
+
+#ifdef PARSER_BENCH_USE_DISP_HOLDER
+    for ( int loop = 0; loop < loops; ++loop )
+    {
+        boost::shared_ptr< DispHolder > holder( new DispHolder() );
+        print_result( "parse_line", "v5_show", "disp_holder",
+                      line_bytes, static_cast< long >( lines.size() ),
+                      run_parse_line( lines, *holder ) );
+    }
+
+    for ( int loop = 0; loop < loops; ++loop )
+    {
+        boost::shared_ptr< DispHolder > holder( new DispHolder() );
+        print_result( "add_disp_info_v3", "v5_show", "disp_holder",
+                      line_bytes, static_cast< long >( lines.size() ),
+                      run_add_disp_info( lines, *holder ) );
+    }
+#endif
+
+    for ( std::vector< Input >::const_iterator it = inputs.begin();
+          it != inputs.end();
+          ++it )
+    {
+        std::remove( it->path_.c_str() );
+    }
+
+    return 0;
+}
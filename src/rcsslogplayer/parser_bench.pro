@@ -0,0 +1,59 @@
+
+TEMPLATE = app
+TARGET = rcssrcgparser_bench
+DESTDIR = ../../bin
+DEPENDPATH += .
+
+INCLUDEPATH += . ..
+win32 {
+  INCLUDEPATH += ../../zlib123-dll/include
+  INCLUDEPATH += ../../boost
+}
+unix {
+  INCLUDEPATH += /opt/local/include
+}
+macx {
+  INCLUDEPATH += /opt/local/include
+}
+
+win32 {
+  LIBS += ../../zlib123-dll/zlib1.dll
+  LIBS += -lwsock32
+}
+unix {
+  LIBS += -lz
+}
+macx {
+  LIBS += -L/opt/local/lib -lz
+}
+
+DEFINES += HAVE_LIBZ
+win32 {
+  DEFINES += HAVE_WINDOWS_H
+}
+unix {
+  DEFINES += HAVE_NETINET_IN_H
+}
+macx {
+  DEFINES += HAVE_NETINET_IN_H
+}
+
+CONFIG -= qt
+CONFIG += warn_on release console
+
+# Input
+HEADERS += \
+    gzfstream.h \
+    handler.h \
+    parser.h \
+    scanner.h \
+    types.h \
+    util.h
+
+SOURCES += \
+    gzfstream.cpp \
+    parser.cpp \
+    scanner.cpp \
+    types.cpp \
+    util.cpp \
+    parser_bench.cpp
@@ -41,11 +41,13 @@ HEADERS += \
     gzfstream.h \
     handler.h \
     parser.h \
+    scanner.h \
     types.h \
     util.h
 
 SOURCES += \
     gzfstream.cpp \
     parser.cpp \
+    scanner.cpp \
     types.cpp \
     util.cpp
@@ -0,0 +1,535 @@
+// -*-c++-*-
+
+/*!
+  \file scanner.cpp
+  \brief numeric scanner for rcg text lines.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+               Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "scanner.h"
+
+#include <boost/cstdint.hpp>
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+//! exactly representable powers of ten in the double precision.
+const double POW10[] = {
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+    1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+const int MAX_POW10 = 22;
+
+//! the max number of significant digits held by the 64bit integer.
+const int MAX_DIGITS = 19;
+
+//! integer part of the double precision can hold 2^53 exactly.
+const boost::uint64_t MAX_EXACT_MANTISSA = static_cast< boost::uint64_t >( 1 ) << 53;
+
+inline
+bool
+is_digit( const char c )
+{
+    return static_cast< unsigned char >( c - '0' ) < 10;
+}
+
+inline
+int
+hex_value( const char c )
+{
+    if ( is_digit( c ) ) return c - '0';
+    if ( 'a' <= c && c <= 'f' ) return c - 'a' + 10;
+    if ( 'A' <= c && c <= 'F' ) return c - 'A' + 10;
+    return -1;
+}
+
+inline
+int
+digit_value( const char c )
+{
+    if ( is_digit( c ) ) return c - '0';
+    if ( 'a' <= c && c <= 'z' ) return c - 'a' + 10;
+    if ( 'A' <= c && c <= 'Z' ) return c - 'A' + 10;
+    return -1;
+}
+
+inline
+bool
+is_number_char( const char c )
+{
+    return ( digit_value( c ) >= 0
+             || c == '.' || c == '+' || c == '-'
+             || c == '_' || c == '(' || c == ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief std::strtof or std::strtod in the "C" locale.
+  The period is replaced by the decimal point of the current locale
+  before the number is passed to the conversion function.
+  \param str null terminated string
+  \param end if not null, the pointer to the character after the last
+  parsed character is set.
+  \param conv strtof or strtod
+  \return parsed value
+*/
+template < typename T >
+T
+strto_c( const char * str,
+         char ** end,
+         T ( *conv )( const char *, char ** ) )
+{
+    const char * point = std::localeconv()->decimal_point;
+    if ( point[0] == '.' && point[1] == '\0' )
+    {
+        return conv( str, end );
+    }
+
+    const std::size_t point_len = std::strlen( point );
+    const char * p = rcss::rcg::skip_space( str );
+
+    char buf[256];
+    std::size_t len = 0;
+    for ( const char * q = p;
+          is_number_char( *q ) && len + point_len < sizeof( buf );
+          ++q )
+    {
+        if ( *q == '.' )
+        {
+            std::memcpy( buf + len, point, point_len );
+            len += point_len;
+        }
+        else
+        {
+            buf[len++] = *q;
+        }
+    }
+    buf[len] = '\0';
+
+    char * buf_end;
+    const T value = conv( buf, &buf_end );
+
+    if ( end )
+    {
+        if ( buf_end == buf )
+        {
+            *end = const_cast< char * >( str );
+        }
+        else
+        {
+            // map the parsed length back to the original string.
+            std::size_t parsed = buf_end - buf;
+            while ( parsed > 0 )
+            {
+                parsed -= ( *p == '.' ? point_len : 1 );
+                ++p;
+            }
+            *end = const_cast< char * >( p );
+        }
+    }
+
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief round the double value to the float value without the double rounding error.
+  \param d positive double value
+  \param f reference to the result variable
+  \return false if the rounding result may be different from the direct conversion.
+*/
+inline
+bool
+to_float( const double d,
+          float & f )
+{
+    if ( d < FLT_MIN || FLT_MAX < d )
+    {
+        return false;
+    }
+
+    // d is the correctly rounded value of the decimal number. Rounding d
+    // to float gives the same result as rounding the decimal number
+    // directly unless d is exactly the midpoint of two float values.
+    boost::uint64_t bits;
+    std::memcpy( &bits, &d, sizeof( bits ) );
+    if ( ( bits & 0x1FFFFFFF ) == 0x10000000 )
+    {
+        return false;
+    }
+
+    f = static_cast< float >( d );
+    return true;
+}
+
+}
+
+namespace rcss {
+namespace rcg {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+float
+scan_float( const char * str,
+            char ** end )
+{
+    const char * p = skip_space( str );
+
+    bool negative = false;
+    if ( *p == '-' )
+    {
+        negative = true;
+        ++p;
+    }
+    else if ( *p == '+' )
+    {
+        ++p;
+    }
+
+    boost::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found = false;
+
+    // integer part
+    for ( ; is_digit( *p ); ++p )
+    {
+        found = true;
+        if ( mantissa == 0 && *p == '0' ) continue;
+        if ( ++digits > MAX_DIGITS ) goto fallback;
+        mantissa = mantissa * 10 + ( *p - '0' );
+    }
+
+    // fraction part
+    if ( *p == '.' )
+    {
+        for ( ++p; is_digit( *p ); ++p )
+        {
+            found = true;
+            --exponent;
+            if ( mantissa == 0 && *p == '0' ) continue;
+            if ( ++digits > MAX_DIGITS ) goto fallback;
+            mantissa = mantissa * 10 + ( *p - '0' );
+        }
+    }
+
+    if ( ! found
+         || *p == 'e' || *p == 'E'
+         || *p == 'x' || *p == 'X' )
+    {
+        goto fallback;
+    }
+
+    if ( mantissa == 0 )
+    {
+        if ( end ) *end = const_cast< char * >( p );
+        return ( negative ? -0.0f : 0.0f );
+    }
+
+    // remove trailing zeros
+    while ( exponent < 0 && mantissa % 10 == 0 )
+    {
+        mantissa /= 10;
+        ++exponent;
+    }
+
+    if ( mantissa <= MAX_EXACT_MANTISSA
+         && -MAX_POW10 <= exponent && exponent <= MAX_POW10 )
+    {
+        // both operands are exact. the result is correctly rounded.
+        const double d = ( exponent < 0
+                           ? static_cast< double >( mantissa ) / POW10[-exponent]
+                           : static_cast< double >( mantissa ) * POW10[exponent] );
+        float f;
+        if ( to_float( d, f ) )
+        {
+            if ( end ) *end = const_cast< char * >( p );
+            return ( negative ? -f : f );
+        }
+    }
+
+ fallback:
+    return strto_c( str, end, &strtof );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+scan_double( const char * str,
+             char ** end )
+{
+    return strto_c( str, end, &strtod );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+long
+scan_long( const char * str,
+           char ** end,
+           const int base )
+{
+    const char * p = skip_space( str );
+
+    bool negative = false;
+    if ( *p == '-' )
+    {
+        negative = true;
+        ++p;
+    }
+    else if ( *p == '+' )
+    {
+        ++p;
+    }
+
+    int radix = base;
+    if ( ( radix == 0 || radix == 16 )
+         && p[0] == '0'
+         && ( p[1] == 'x' || p[1] == 'X' )
+         && 0 <= digit_value( p[2] ) && digit_value( p[2] ) < 16 )
+    {
+        p += 2;
+        radix = 16;
+    }
+    else if ( radix == 0 )
+    {
+        radix = ( p[0] == '0' ? 8 : 10 );
+    }
+
+    if ( radix < 2 || 36 < radix )
+    {
+        // invalid base. same as strtol
+        errno = EINVAL;
+        if ( end ) *end = const_cast< char * >( str );
+        return 0;
+    }
+
+    const char * start = p;
+    unsigned long value = 0;
+    bool overflow = false;
+
+    // the numbers shorter than these digits never overflow.
+    if ( radix == 10 )
+    {
+        const int safe_digits = ( sizeof( long ) >= 8 ? 18 : 9 );
+        for ( ; is_digit( *p ) && p - start < safe_digits; ++p )
+        {
+            value = value * 10 + ( *p - '0' );
+        }
+    }
+    else if ( radix == 16 )
+    {
+        const int safe_digits = ( sizeof( long ) >= 8 ? 15 : 7 );
+        for ( int v = hex_value( *p ); v >= 0 && p - start < safe_digits; v = hex_value( *++p ) )
+        {
+            value = value * 16 + v;
+        }
+    }
+
+    int v = digit_value( *p );
+    if ( 0 <= v && v < radix )
+    {
+        // the remaining digits are checked one by one.
+        // the magnitude of LONG_MIN is LONG_MAX + 1.
+        const unsigned long limit = ( negative
+                                      ? static_cast< unsigned long >( LONG_MAX ) + 1
+                                      : static_cast< unsigned long >( LONG_MAX ) );
+        const unsigned long cutoff = limit / radix;
+        const int cutlim = static_cast< int >( limit - cutoff * radix );
+
+        for ( ; 0 <= v && v < radix; v = digit_value( *++p ) )
+        {
+            if ( value > cutoff
+                 || ( value == cutoff && v > cutlim ) )
+            {
+                overflow = true;
+            }
+            else
+            {
+                value = value * radix + v;
+            }
+        }
+    }
+
+    if ( p == start )
+    {
+        // no digit. same as strtol
+        if ( end ) *end = const_cast< char * >( str );
+        return 0;
+    }
+
+    if ( end ) *end = const_cast< char * >( p );
+
+    if ( overflow )
+    {
+        errno = ERANGE;
+        return ( negative ? LONG_MIN : LONG_MAX );
+    }
+
+    if ( negative )
+    {
+        return ( value > static_cast< unsigned long >( LONG_MAX )
+                 ? LONG_MIN
+                 : -static_cast< long >( value ) );
+    }
+
+    return static_cast< long >( value );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+scan_int( const char * str,
+          int & value )
+{
+    str = skip_space( str );
+
+    char * next;
+    long val = scan_long( str, &next, 10 );
+    if ( next == str )
+    {
+        return static_cast< const char * >( 0 );
+    }
+
+    value = static_cast< int >( val );
+    return next;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+scan_float( const char * str,
+            float & value )
+{
+    str = skip_space( str );
+
+    char * next;
+    float val = scan_float( str, &next );
+    if ( next == str )
+    {
+        return static_cast< const char * >( 0 );
+    }
+
+    value = val;
+    return next;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+scan_token( const char * str,
+            char * buf,
+            const std::size_t max_len )
+{
+    str = skip_space( str );
+
+    std::size_t len = 0;
+    while ( len < max_len
+            && *str != '\0'
+            && ! is_space( *str ) )
+    {
+        buf[len++] = *str++;
+    }
+    buf[len] = '\0';
+
+    return ( len == 0 ? static_cast< const char * >( 0 ) : str );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+scan_until( const char * str,
+            const char delim,
+            char * buf,
+            const std::size_t max_len )
+{
+    std::size_t len = 0;
+    while ( len < max_len
+            && *str != '\0'
+            && *str != delim )
+    {
+        buf[len++] = *str++;
+    }
+    buf[len] = '\0';
+
+    return ( len == 0 ? static_cast< const char * >( 0 ) : str );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+scan_literal( const char * str,
+              const char * literal )
+{
+    for ( ; *literal != '\0'; ++literal )
+    {
+        if ( is_space( *literal ) )
+        {
+            str = skip_space( str );
+        }
+        else if ( *str == *literal )
+        {
+            ++str;
+        }
+        else
+        {
+            return static_cast< const char * >( 0 );
+        }
+    }
+
+    return str;
+}
+
+}
+}
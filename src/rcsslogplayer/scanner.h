@@ -0,0 +1,181 @@
+// -*-c++-*-
+
+/*!
+  \file scanner.h
+  \brief numeric scanner for rcg text lines.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+               Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSLOGPLAYER_SCANNER_H
+#define RCSSLOGPLAYER_SCANNER_H
+
+#include <cstddef>
+
+namespace rcss {
+namespace rcg {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the character is a white space in the "C" locale.
+  \param c checked character
+  \return true if c is a white space.
+*/
+inline
+bool
+is_space( const char c )
+{
+    return c == ' ' || ( '\t' <= c && c <= '\r' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip white spaces in the same way as the white space directive of scanf.
+  \param str null terminated string
+  \return pointer to the first non white space character
+*/
+inline
+const char *
+skip_space( const char * str )
+{
+    while ( is_space( *str ) ) ++str;
+    return str;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief locale independent replacement of std::strtof.
+  Plain decimal numbers are converted without any library call. Other
+  forms (exponent, hexadecimal, inf, nan, too many digits, ...) are
+  passed to std::strtof with the period replaced by the decimal point of
+  the current locale. The result is always same as std::strtof in the
+  "C" locale.
+  \param str null terminated string
+  \param end if not null, the pointer to the character after the last
+  parsed character is set.
+  \return parsed value
+*/
+float
+scan_float( const char * str,
+            char ** end );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief locale independent replacement of std::strtod.
+  The number is passed to std::strtod with the period replaced by the
+  decimal point of the current locale. The result is always same as
+  std::strtod in the "C" locale.
+  \param str null terminated string
+  \param end if not null, the pointer to the character after the last
+  parsed character is set.
+  \return parsed value
+*/
+double
+scan_double( const char * str,
+             char ** end );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief locale independent replacement of std::strtol.
+  No library function is called. The overflow is reported in the same
+  way as std::strtol in the "C" locale.
+  \param str null terminated string
+  \param end if not null, the pointer to the character after the last
+  parsed character is set.
+  \param base 0 or 2-36, same as std::strtol.
+  \return parsed value
+*/
+long
+scan_long( const char * str,
+           char ** end,
+           const int base );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan an integer in the same way as "%d" of scanf.
+  \param str null terminated string
+  \param value reference to the result variable
+  \return pointer to the next character or 0 if no integer is found.
+*/
+const char *
+scan_int( const char * str,
+          int & value );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan a floating point number in the same way as "%f" of scanf.
+  \param str null terminated string
+  \param value reference to the result variable
+  \return pointer to the next character or 0 if no number is found.
+*/
+const char *
+scan_float( const char * str,
+            float & value );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan a non white space string in the same way as "%Ns" of scanf.
+  \param str null terminated string
+  \param buf destination buffer. its size must be max_len + 1 at least.
+  \param max_len maximum length of the scanned string
+  \return pointer to the next character or 0 if no string is found.
+*/
+const char *
+scan_token( const char * str,
+            char * buf,
+            const std::size_t max_len );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan a string in the same way as "%N[^c]" of scanf.
+  \param str null terminated string
+  \param delim terminating character
+  \param buf destination buffer. its size must be max_len + 1 at least.
+  \param max_len maximum length of the scanned string
+  \return pointer to the next character or 0 if no string is found.
+*/
+const char *
+scan_until( const char * str,
+            const char delim,
+            char * buf,
+            const std::size_t max_len );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief match the literal string in the same way as the format string of scanf.
+  A white space in the literal matches any number of white spaces.
+  \param str null terminated string
+  \param literal matched string
+  \return pointer to the next character or 0 if not matched.
+*/
+const char *
+scan_literal( const char * str,
+              const char * literal );
+
+}
+}
+
+#endif
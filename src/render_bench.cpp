@@ -0,0 +1,714 @@
+// -*-c++-*-
+
+/*!
+  \file render_bench.cpp
+  \brief rendering benchmark for the field canvas painters.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "disp_holder.h"
+#include "options.h"
+#include "render_frame.h"
+#include "render_settings.h"
+#include "render_worker.h"
+
+#include "field_painter.h"
+#include "heat_map_painter.h"
+#include "ball_painter.h"
+#include "player_painter.h"
+#include "score_board_painter.h"
+#include "team_graphic_painter.h"
+#include "trace_painter.h"
+#include "draw_info_painter.h"
+
+#include <rcsslogplayer/gzfstream.h>
+#include <rcsslogplayer/parser.h>
+#include <rcsslogplayer/types.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <clocale>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief wall clock stop watch with nano second resolution if possible.
+ */
+class StopWatch {
+private:
+#if QT_VERSION >= 0x040800
+    QElapsedTimer M_timer;
+#else
+    QTime M_timer;
+#endif
+public:
+    void start()
+      {
+          M_timer.start();
+      }
+
+    double elapsedMSec() const
+      {
+#if QT_VERSION >= 0x040800
+          return M_timer.nsecsElapsed() * 1.0e-6;
+#else
+          return M_timer.elapsed();
+#endif
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set of the view options used by one benchmark case.
+ */
+struct ViewConfig {
+    std::string name_;
+    bool anti_aliasing_;
+    bool show_score_board_;
+    bool show_team_graphic_;
+    bool show_flag_;
+    bool show_ball_;
+    bool show_player_;
+    bool show_player_number_;
+    bool show_player_type_;
+    bool show_view_area_;
+    bool show_catch_area_;
+    bool show_tackle_area_;
+    bool show_kick_accel_area_;
+    bool show_stamina_;
+    bool show_stamina_capacity_;
+    bool show_pointto_;
+    bool show_card_;
+    bool show_offside_line_;
+    bool show_draw_info_;
+    double grid_step_;
+    int selected_number_;
+    int ball_trace_cycle_;
+    int player_trace_cycle_;
+    bool player_trace_all_;
+    Options::HeatMapType heat_map_type_;
+
+    /*!
+      \brief capture the current options.
+     */
+    explicit
+    ViewConfig( const std::string & name )
+        : name_( name )
+      {
+          const Options & opt = Options::instance();
+          anti_aliasing_ = opt.antiAliasing();
+          show_score_board_ = opt.showScoreBoard();
+          show_team_graphic_ = opt.showTeamGraphic();
+          show_flag_ = opt.showFlag();
+          show_ball_ = opt.showBall();
+          show_player_ = opt.showPlayer();
+          show_player_number_ = opt.showPlayerNumber();
+          show_player_type_ = opt.showPlayerType();
+          show_view_area_ = opt.showViewArea();
+          show_catch_area_ = opt.showCatchArea();
+          show_tackle_area_ = opt.showTackleArea();
+          show_kick_accel_area_ = opt.showKickAccelArea();
+          show_stamina_ = opt.showStamina();
+          show_stamina_capacity_ = opt.showStaminaCapacity();
+          show_pointto_ = opt.showPointto();
+          show_card_ = opt.showCard();
+          show_offside_line_ = opt.showOffsideLine();
+          show_draw_info_ = opt.showDrawInfo();
+          grid_step_ = opt.gridStep();
+          selected_number_ = opt.selectedNumber();
+          ball_trace_cycle_ = opt.ballTraceCycle();
+          player_trace_cycle_ = opt.playerTraceCycle();
+          player_trace_all_ = opt.playerTraceAll();
+          heat_map_type_ = opt.heatMapType();
+      }
+
+    ViewConfig & overlays( const bool on )
+      {
+          show_player_type_ = on;
+          show_view_area_ = on;
+          show_catch_area_ = on;
+          show_tackle_area_ = on;
+          show_kick_accel_area_ = on;
+          show_stamina_ = on;
+          show_stamina_capacity_ = on;
+          show_pointto_ = on;
+          show_card_ = on;
+          show_offside_line_ = on;
+          show_flag_ = on;
+          grid_step_ = ( on ? 10.0 : 0.0 );
+          selected_number_ = ( on ? 10 : 0 );
+          ball_trace_cycle_ = 0;
+          player_trace_cycle_ = 0;
+          player_trace_all_ = false;
+          heat_map_type_ = Options::HEAT_MAP_NONE;
+          return *this;
+      }
+
+    /*!
+      \brief apply this configuration to the options.
+      Options has only toggle methods for the view flags.
+     */
+    void apply() const
+      {
+          Options & opt = Options::instance();
+          if ( opt.antiAliasing() != anti_aliasing_ ) opt.toggleAntiAliasing();
+          if ( opt.showScoreBoard() != show_score_board_ ) opt.toggleShowScoreBoard();
+          if ( opt.showTeamGraphic() != show_team_graphic_ ) opt.toggleShowTeamGraphic();
+          if ( opt.showFlag() != show_flag_ ) opt.toggleShowFlag();
+          if ( opt.showBall() != show_ball_ ) opt.toggleShowBall();
+          if ( opt.showPlayer() != show_player_ ) opt.toggleShowPlayer();
+          if ( opt.showPlayerNumber() != show_player_number_ ) opt.toggleShowPlayerNumber();
+          if ( opt.showPlayerType() != show_player_type_ ) opt.toggleShowPlayerType();
+          if ( opt.showViewArea() != show_view_area_ ) opt.toggleShowViewArea();
+          if ( opt.showCatchArea() != show_catch_area_ ) opt.toggleShowCatchArea();
+          if ( opt.showTackleArea() != show_tackle_area_ ) opt.toggleShowTackleArea();
+          if ( opt.showKickAccelArea() != show_kick_accel_area_ ) opt.toggleShowKickAccelArea();
+          if ( opt.showStamina() != show_stamina_ ) opt.toggleShowStamina();
+          if ( opt.showStaminaCapacity() != show_stamina_capacity_ ) opt.toggleShowStaminaCapacity();
+          if ( opt.showPointto() != show_pointto_ ) opt.toggleShowPointto();
+          if ( opt.showCard() != show_card_ ) opt.toggleShowCard();
+          if ( opt.showOffsideLine() != show_offside_line_ ) opt.toggleShowOffsideLine();
+          if ( opt.showDrawInfo() != show_draw_info_ ) opt.toggleShowDrawInfo();
+          if ( opt.playerTraceAll() != player_trace_all_ ) opt.togglePlayerTraceAll();
+          opt.setBallTraceCycle( ball_trace_cycle_ );
+          opt.setPlayerTraceCycle( player_trace_cycle_ );
+          opt.setHeatMapType( heat_map_type_ );
+          opt.setGridStep( grid_step_ );
+          opt.setSelectedNumber( selected_number_ >= 0 ? rcss::rcg::LEFT : rcss::rcg::RIGHT,
+                                 std::abs( selected_number_ ) );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief the painters of the layers in RenderWorker::createLayers(),
+  drawn directly into one image to measure each painter.
+ */
+struct PainterStack {
+    RenderFrame frame_;
+    std::vector< boost::shared_ptr< PainterInterface > > painters_;
+
+    explicit
+    PainterStack( const DispHolder & holder )
+      {
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new FieldPainter( frame_ ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new ScoreBoardPainter( frame_ ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new TeamGraphicPainter( holder ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new HeatMapPainter( holder ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new TracePainter( holder ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new PlayerPainter( frame_ ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new BallPainter( frame_ ) ) );
+          painters_.push_back( boost::shared_ptr< PainterInterface >( new DrawInfoPainter( frame_ ) ) );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load all show data in the game log file.
+ */
+bool
+load_rcg( const std::string & path,
+          DispHolder & holder )
+{
+    rcss::gzifstream fin( path.c_str() );
+
+    if ( ! fin.is_open() )
+    {
+        std::cerr << "Failed to open the game log file [" << path << "]"
+                  << std::endl;
+        return false;
+    }
+
+    rcss::rcg::Parser parser( holder );
+    while ( parser.parse( fin ) )
+    {
+
+    }
+
+    if ( holder.dispCont().empty() )
+    {
+        std::cerr << "No show data in [" << path << "]"
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief generate worst case frames.
+  all players are gathered around the ball, every player has some status flags,
+  a card, a pointing arm and decayed stamina.
+  each frame also has many draw info objects.
+ */
+void
+create_synthetic_frames( const int n_frames,
+                         const int n_draw_objects,
+                         DispHolder & holder )
+{
+    const int states[] = {
+        rcss::rcg::STAND | rcss::rcg::KICK,
+        rcss::rcg::STAND | rcss::rcg::TACKLE | rcss::rcg::YELLOW_CARD,
+        rcss::rcg::STAND | rcss::rcg::KICK_FAULT | rcss::rcg::PLAYER_COLLIDE,
+        rcss::rcg::STAND | rcss::rcg::BALL_COLLIDE | rcss::rcg::RED_CARD,
+        rcss::rcg::STAND | rcss::rcg::FOUL_CHARGED | rcss::rcg::TACKLE_FAULT,
+    };
+    const int n_states = sizeof( states ) / sizeof( states[0] );
+
+    char buf[512];
+
+    for ( int t = 1; t <= n_frames; ++t )
+    {
+        const double ball_x = -40.0 + ( t % 80 );
+        const double ball_y = 10.0 * std::sin( t * 0.1 );
+
+        std::ostringstream os;
+        os << "(show " << t << " (pm 2) (tm bench_left bench_right " << t / 1000 << " 0)";
+
+        snprintf( buf, sizeof( buf ), " ((b) %.4f %.4f %.4f %.4f)",
+                  ball_x, ball_y, 1.2, -0.4 );
+        os << buf;
+
+        for ( int i = 0; i < rcss::rcg::MAX_PLAYER * 2; ++i )
+        {
+            const char side = ( i < rcss::rcg::MAX_PLAYER ? 'l' : 'r' );
+            const int unum = i % rcss::rcg::MAX_PLAYER + 1;
+            const double angle = i * 2.0 * M_PI / ( rcss::rcg::MAX_PLAYER * 2 ) + t * 0.05;
+            const double r = 0.8 + ( i % 6 );
+            int state = states[( i + t / 10 ) % n_states];
+            if ( unum == 1 ) state |= rcss::rcg::GOALIE | rcss::rcg::CATCH;
+
+            snprintf( buf, sizeof( buf ),
+                      " ((%c %d) %d %x %.4f %.4f %.4f %.4f %.1f %.1f %.4f %.4f"
+                      " (v h 90) (s %.1f %.3f %.3f %.1f) (f l 1)"
+                      " (c 1 2 3 4 5 6 7 8 9 10 11))",
+                      side, unum, i % 7, state,
+                      ball_x + r * std::cos( angle ),
+                      ball_y + r * std::sin( angle ),
+                      0.3, -0.2,
+                      std::fmod( t * 7.0 + i * 30.0, 360.0 ) - 180.0,
+                      45.0,
+                      ball_x + 20.0, ball_y - 10.0,
+                      std::fmod( t * 37.0 + i * 500.0, 8000.0 ),
+                      ( i % 3 == 0 ? 0.8 : 1.0 ),
+                      ( i % 4 == 0 ? 0.7 : 1.0 ),
+                      130600.0 - t * 10.0 );
+            os << buf;
+        }
+        os << ')';
+
+        holder.addDispInfoV3( os.str().c_str() );
+
+        for ( int i = 0; i < n_draw_objects; ++i )
+        {
+            const double x = -50.0 + ( ( i * 13 + t ) % 100 );
+            const double y = -30.0 + ( ( i * 7 + t ) % 60 );
+            switch ( i % 3 ) {
+            case 0:
+                snprintf( buf, sizeof( buf ), "(draw %d (point %.2f %.2f \"red\"))",
+                          t, x, y );
+                break;
+            case 1:
+                snprintf( buf, sizeof( buf ), "(draw %d (circle %.2f %.2f %.2f \"#00ffff\"))",
+                          t, x, y, 1.0 + i % 5 );
+                break;
+            default:
+                snprintf( buf, sizeof( buf ), "(draw %d (line %.2f %.2f %.2f %.2f \"yellow\"))",
+                          t, x, y, ball_x, ball_y );
+                break;
+            }
+            holder.addDispInfoV3( buf );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief draw all frames in the holder and print the result as one csv line.
+ */
+void
+run_case( const std::string & source,
+          DispHolder & holder,
+          const ViewConfig & config,
+          const int width,
+          const int height,
+          const int max_frames,
+          const int loops )
+{
+    config.apply();
+    holder.updateHeatMap();
+
+    PainterStack stack( holder );
+    std::vector< double > painter_msec( stack.painters_.size(), 0.0 );
+
+    QImage image( width, height, QImage::Format_RGB32 );
+
+    const size_t n_frames = ( max_frames > 0
+                              ? std::min( holder.dispCont().size(), static_cast< size_t >( max_frames ) )
+                              : holder.dispCont().size() );
+
+    // the options are not changed while the case is running.
+    Options::instance().updateFieldSize( width, height );
+    const RenderSettings settings( Options::instance(), 0,
+                                   Options::instance().fieldCenter(),
+                                   Options::instance().fieldScale(),
+                                   Options::instance().selectedNumber() );
+
+    // warm up the caches in the painters.
+    {
+        holder.setIndexFirst();
+        stack.frame_.update( holder );
+        QPainter painter( &image );
+        for ( size_t p = 0; p < stack.painters_.size(); ++p )
+        {
+            stack.painters_[p]->prepare( settings );
+            stack.painters_[p]->draw( painter, settings );
+        }
+    }
+
+    StopWatch total_timer;
+    StopWatch timer;
+
+    total_timer.start();
+
+    for ( int loop = 0; loop < loops; ++loop )
+    {
+        for ( size_t i = 0; i < n_frames; ++i )
+        {
+            holder.setIndex( i );
+            stack.frame_.update( holder );
+
+            QPainter painter( &image );
+
+            for ( size_t p = 0; p < stack.painters_.size(); ++p )
+            {
+                timer.start();
+                stack.painters_[p]->prepare( settings );
+                stack.painters_[p]->draw( painter, settings );
+                painter_msec[p] += timer.elapsedMSec();
+            }
+        }
+    }
+
+    const double total_msec = total_timer.elapsedMSec();
+    const double n_drawn = static_cast< double >( n_frames ) * loops;
+
+    std::cout << source << ',' << config.name_ << ",painters"
+              << ',' << width << ',' << height
+              << ',' << static_cast< long >( n_drawn )
+              << ',' << ( total_msec > 0.0 ? n_drawn * 1000.0 / total_msec : 0.0 );
+    for ( size_t p = 0; p < painter_msec.size(); ++p )
+    {
+        std::cout << ',' << ( n_drawn > 0.0 ? painter_msec[p] / n_drawn : 0.0 );
+    }
+    std::cout << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief render all frames in the holder through RenderWorker and print
+  the result as one csv line.
+  the unchanged layers are skipped and the layer images are composited
+  as the monitor does. the per painter times are not available.
+ */
+void
+run_layered_case( const std::string & source,
+                  DispHolder & holder,
+                  const ViewConfig & config,
+                  const bool parallel,
+                  const int width,
+                  const int height,
+                  const int max_frames,
+                  const int loops )
+{
+    config.apply();
+    holder.updateHeatMap();
+
+    // the worker thread is not started. the requests are painted by paintNow().
+    RenderWorker worker( holder, parallel, 0 );
+
+    const QSize size( width, height );
+
+    const size_t n_frames = ( max_frames > 0
+                              ? std::min( holder.dispCont().size(), static_cast< size_t >( max_frames ) )
+                              : holder.dispCont().size() );
+
+    Options::instance().updateFieldSize( width, height );
+    const boost::shared_ptr< const RenderSettings >
+        settings( new RenderSettings( Options::instance(), 0,
+                                      Options::instance().fieldCenter(),
+                                      Options::instance().fieldScale(),
+                                      Options::instance().selectedNumber() ) );
+
+    // warm up the caches in the painters and paint the pitch layer.
+    holder.setIndexFirst();
+    worker.paintNow( size, settings );
+
+    StopWatch total_timer;
+    total_timer.start();
+
+    for ( int loop = 0; loop < loops; ++loop )
+    {
+        for ( size_t i = 0; i < n_frames; ++i )
+        {
+            holder.setIndex( i );
+            worker.paintNow( size, settings );
+        }
+    }
+
+    const double total_msec = total_timer.elapsedMSec();
+    const double n_drawn = static_cast< double >( n_frames ) * loops;
+
+    std::cout << source << ',' << config.name_
+              << ',' << ( parallel ? "layers_parallel" : "layers" )
+              << ',' << width << ',' << height
+              << ',' << static_cast< long >( n_drawn )
+              << ',' << ( total_msec > 0.0 ? n_drawn * 1000.0 / total_msec : 0.0 );
+    for ( int p = 0; p < 8; ++p )
+    {
+        std::cout << ',';
+    }
+    std::cout << std::endl;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char ** argv )
+{
+    QApplication app( argc, argv );
+
+    std::setlocale( LC_NUMERIC, "C" );
+
+    namespace po = boost::program_options;
+
+    std::string game_log_file;
+    std::string sizes = "640x480,1024x768,1920x1080";
+    int synthetic_frames = 300;
+    int draw_objects = 150;
+    int max_frames = 1000;
+    int loops = 1;
+
+    po::options_description visibles( "Allowed options:" );
+    visibles.add_options()
+        ( "help,h",
+          "print this message." )
+        ( "game-log-file,f",
+          po::value< std::string >( &game_log_file )->default_value( game_log_file ),
+          "set the path to Game Log file(.rcg or .rcg.gz) used as recorded frames." )
+        ( "sizes",
+          po::value< std::string >( &sizes )->default_value( sizes ),
+          "set comma separated list of canvas sizes (WxH)." )
+        ( "synthetic-frames",
+          po::value< int >( &synthetic_frames )->default_value( synthetic_frames ),
+          "set the number of generated worst case frames." )
+        ( "draw-objects",
+          po::value< int >( &draw_objects )->default_value( draw_objects ),
+          "set the number of draw info objects in each generated frame." )
+        ( "max-frames",
+          po::value< int >( &max_frames )->default_value( max_frames ),
+          "set max number of recorded frames to be drawn." )
+        ( "loops",
+          po::value< int >( &loops )->default_value( loops ),
+          "set the number of repetitions for each case." )
+        ;
+
+    po::positional_options_description pdesc;
+    pdesc.add( "game-log-file", 1 );
+
+    try
+    {
+        po::variables_map vm;
+        po::command_line_parser parser( argc, argv );
+        parser.options( visibles ).positional( pdesc );
+        po::store( parser.run(), vm );
+        po::notify( vm );
+
+        if ( vm.count( "help" ) )
+        {
+            std::cout << "Usage: rcssmonitor_render_bench [options ... ] [GameLogFile]\n";
+            std::cout << visibles << std::endl;
+            return 0;
+        }
+    }
+    catch ( std::exception & e )
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector< std::pair< int, int > > canvas_sizes;
+    {
+        std::istringstream is( sizes );
+        std::string token;
+        while ( std::getline( is, token, ',' ) )
+        {
+            int w = 0, h = 0;
+            if ( std::sscanf( token.c_str(), " %dx%d ", &w, &h ) != 2
+                 || w <= 0 || h <= 0 )
+            {
+                std::cerr << "Illegal canvas size [" << token << "]" << std::endl;
+                return 1;
+            }
+            canvas_sizes.push_back( std::make_pair( w, h ) );
+        }
+    }
+
+    Options & opt = Options::instance();
+
+    // the view options are saved into the config file when the program exits.
+    const ViewConfig user_config( "user" );
+    const bool user_buffering_mode = opt.bufferingMode();
+    opt.setBufferingMode( true );
+    opt.setTeamGraphicCache( false );
+
+    //
+    // benchmark cases
+    //
+
+    std::vector< ViewConfig > configs;
+    {
+        ViewConfig plain( "plain" );
+        plain.overlays( false );
+        plain.show_draw_info_ = false;
+        plain.anti_aliasing_ = false;
+        configs.push_back( plain );
+
+        plain.name_ = "plain_aa";
+        plain.anti_aliasing_ = true;
+        configs.push_back( plain );
+
+        ViewConfig overlays( "overlays" );
+        overlays.overlays( true );
+        overlays.show_draw_info_ = false;
+        overlays.anti_aliasing_ = false;
+        configs.push_back( overlays );
+
+        overlays.name_ = "overlays_aa";
+        overlays.anti_aliasing_ = true;
+        configs.push_back( overlays );
+
+        overlays.name_ = "overlays_aa_draw_info";
+        overlays.show_draw_info_ = true;
+        configs.push_back( overlays );
+
+        // trails of the ball and all players over 200 cycles
+        ViewConfig trace( "trace_aa" );
+        trace.overlays( false );
+        trace.show_draw_info_ = false;
+        trace.anti_aliasing_ = true;
+        trace.ball_trace_cycle_ = 200;
+        trace.player_trace_cycle_ = 200;
+        trace.player_trace_all_ = true;
+        configs.push_back( trace );
+
+        // heat map of the left team over the whole buffered frames
+        ViewConfig heat_map( "heat_map_aa" );
+        heat_map.overlays( false );
+        heat_map.show_draw_info_ = false;
+        heat_map.anti_aliasing_ = true;
+        heat_map.heat_map_type_ = Options::HEAT_MAP_LEFT;
+        configs.push_back( heat_map );
+    }
+
+    //
+    // frame sources
+    //
+
+    std::vector< std::pair< std::string, boost::shared_ptr< DispHolder > > > sources;
+
+    if ( ! game_log_file.empty() )
+    {
+        boost::shared_ptr< DispHolder > holder( new DispHolder() );
+        if ( load_rcg( game_log_file, *holder ) )
+        {
+            sources.push_back( std::make_pair( std::string( "recorded" ), holder ) );
+        }
+    }
+
+    if ( synthetic_frames > 0 )
+    {
+        boost::shared_ptr< DispHolder > holder( new DispHolder() );
+        create_synthetic_frames( synthetic_frames, draw_objects, *holder );
+        sources.push_back( std::make_pair( std::string( "synthetic" ), holder ) );
+    }
+
+    //
+    // run
+    //
+
+    std::cout << "source,config,renderer,width,height,frames,fps"
+              << ",field_msec,score_board_msec,team_graphic_msec"
+              << ",heat_map_msec,trace_msec,player_msec,ball_msec,draw_info_msec"
+              << std::endl;
+
+    for ( size_t s = 0; s < sources.size(); ++s )
+    {
+        DispHolder & holder = *sources[s].second;
+
+        for ( size_t c = 0; c < configs.size(); ++c )
+        {
+            for ( size_t z = 0; z < canvas_sizes.size(); ++z )
+            {
+                run_case( sources[s].first, holder, configs[c],
+                          canvas_sizes[z].first, canvas_sizes[z].second,
+                          max_frames, std::max( 1, loops ) );
+                run_layered_case( sources[s].first, holder, configs[c], false,
+                                  canvas_sizes[z].first, canvas_sizes[z].second,
+                                  max_frames, std::max( 1, loops ) );
+                run_layered_case( sources[s].first, holder, configs[c], true,
+                                  canvas_sizes[z].first, canvas_sizes[z].second,
+                                  max_frames, std::max( 1, loops ) );
+            }
+        }
+    }
+
+    user_config.apply();
+    opt.setBufferingMode( user_buffering_mode );
+
+    return 0;
+}
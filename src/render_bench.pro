@@ -0,0 +1,109 @@
+TEMPLATE = app
+QT += network
+TARGET = rcssmonitor_render_bench
+DESTDIR = ../bin
+
+DEPENDPATH += .
+
+INCLUDEPATH += . ..
+win32 {
+  INCLUDEPATH +=  c:/Qt/boost-include
+}
+unix {
+  INCLUDEPATH += /opt/local/include
+}
+macx-g++ {
+  INCLUDEPATH += /opt/local/include
+}
+
+win32 {
+  LIBS += c:/Qt/boost-lib/boost_program_options-mgw44-mt-1_42.dll
+  LIBS += -lwsock32
+}
+unix {
+  LIBS += -L/opt/local/lib
+  LIBS += -lboost_program_options-mt -lz
+}
+macx-g++ {
+  LIBS += -L/opt/local/lib
+  LIBS += -lboost_program_options-mt -lz
+}
+
+DEFINES += HAVE_LIBZ
+win32 {
+  DEFINES += HAVE_WINDOWS_H
+  DEFINES += HAVE_BOOST_PROGRAM_OPTIONS
+}
+unix {
+  DEFINES += HAVE_NETINET_IN_H
+  DEFINES += HAVE_BOOST_PROGRAM_OPTIONS
+}
+macx-g++ {
+  DEFINES += HAVE_NETINET_IN_H
+  DEFINES += HAVE_BOOST_PROGRAM_OPTIONS
+}
+DEFINES += PACKAGE="\\\"rcssmonitor\\\""
+DEFINES += PACKAGE_NAME="\\\"rcssmonitor\\\""
+DEFINES += VERSION="\\\"14.1.1\\\""
+
+CONFIG += qt warn_on release console
+
+# Input
+HEADERS += \
+	rcsslogplayer/gzfstream.h \
+	rcsslogplayer/handler.h \
+	rcsslogplayer/parser.h \
+	rcsslogplayer/scanner.h \
+	rcsslogplayer/types.h \
+	rcsslogplayer/util.h \
+	angle_deg.h \
+	ball_painter.h \
+	circle_2d.h \
+	cycle_stats.h \
+	disp_holder.h \
+	draw_info_painter.h \
+	field_painter.h \
+	heat_map.h \
+	heat_map_painter.h \
+	line_2d.h \
+	options.h \
+	painter_interface.h \
+	player_painter.h \
+	render_frame.h \
+	render_layer.h \
+	render_settings.h \
+	render_worker.h \
+	score_board_painter.h \
+	team_graphic.h \
+	team_graphic_painter.h \
+	trace_painter.h \
+	vector_2d.h
+
+SOURCES += \
+	rcsslogplayer/gzfstream.cpp \
+	rcsslogplayer/parser.cpp \
+	rcsslogplayer/scanner.cpp \
+	rcsslogplayer/types.cpp \
+	rcsslogplayer/util.cpp \
+	angle_deg.cpp \
+	ball_painter.cpp \
+	circle_2d.cpp \
+	cycle_stats.cpp \
+	disp_holder.cpp \
+	draw_info_painter.cpp \
+	field_painter.cpp \
+	heat_map.cpp \
+	heat_map_painter.cpp \
+	line_2d.cpp \
+	options.cpp \
+	player_painter.cpp \
+	render_frame.cpp \
+	render_layer.cpp \
+	render_settings.cpp \
+	render_worker.cpp \
+	score_board_painter.cpp \
+	team_graphic.cpp \
+	team_graphic_painter.cpp \
+	trace_painter.cpp \
+	vector_2d.cpp \
+	render_bench.cpp
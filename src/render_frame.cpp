@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/*!
+  \file render_frame.cpp
+  \brief display data snapshot for one painting Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "render_frame.h"
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  copy the entries of the given time.
+ */
+template < typename Cont >
+void
+copy_time_range( const Cont & from,
+                 const int time,
+                 Cont & to )
+{
+    to.clear();
+
+    const std::pair< typename Cont::const_iterator,
+        typename Cont::const_iterator > range = from.equal_range( time );
+    to.insert( range.first, range.second );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+RenderFrame::RenderFrame()
+    : M_revision( -1 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RenderFrame::update( const DispHolder & holder )
+{
+    M_disp = holder.currentDisp();
+    M_analysis = holder.currentAnalysis();
+
+    if ( M_revision != holder.revision() )
+    {
+        M_revision = holder.revision();
+
+        M_server_param = holder.serverParam();
+        M_player_types = holder.playerTypes();
+        M_penalty_scores_left = holder.penaltyScoresLeft();
+        M_penalty_scores_right = holder.penaltyScoresRight();
+    }
+
+    const int time = ( M_disp
+                       ? static_cast< int >( M_disp->show_.time_ )
+                       : -1 );
+    copy_time_range( holder.pointCont(), time, M_point_cont );
+    copy_time_range( holder.circleCont(), time, M_circle_cont );
+    copy_time_range( holder.lineCont(), time, M_line_cont );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const
+rcss::rcg::PlayerTypeT &
+RenderFrame::playerType( const int id ) const
+{
+    std::map< int, rcss::rcg::PlayerTypeT >::const_iterator it
+        = M_player_types.find( id );
+
+    if ( it == M_player_types.end() )
+    {
+        return M_default_player_type;
+    }
+
+    return it->second;
+}
@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/*!
+  \file render_frame.h
+  \brief display data snapshot for one painting Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_RENDER_FRAME_H
+#define RCSSMONITOR_RENDER_FRAME_H
+
+#include "disp_holder.h"
+
+#include <rcsslogplayer/types.h>
+
+#include <vector>
+#include <map>
+
+/*!
+  \class RenderFrame
+  \brief copy of the display data used by one painting.
+
+  The render worker updates the frame from DispHolder under a short read
+  lock, and the painters read only the frame while they paint, so the
+  GUI thread can update the holder during the painting. The current
+  display data is shared by the pointer, and the debug draw data of the
+  current cycle are copied for each frame. The parameters and the
+  penalty records are copied only when the revision of the holder is
+  changed.
+*/
+class RenderFrame {
+public:
+    typedef std::vector< std::pair< int, rcss::rcg::PlayMode > > PenaltyCont;
+
+private:
+
+    //! revision of the holder when the parameters were copied. -1 if not copied.
+    int M_revision;
+
+    DispConstPtr M_disp;
+    DispAnalysis M_analysis;
+
+    rcss::rcg::ServerParamT M_server_param;
+    rcss::rcg::PlayerTypeT M_default_player_type;
+    std::map< int, rcss::rcg::PlayerTypeT > M_player_types;
+
+    PenaltyCont M_penalty_scores_left;
+    PenaltyCont M_penalty_scores_right;
+
+    //! debug draw data of the current cycle
+    PointCont M_point_cont;
+    CircleCont M_circle_cont;
+    LineCont M_line_cont;
+
+    // not used
+    RenderFrame( const RenderFrame & );
+    const RenderFrame & operator=( const RenderFrame & );
+
+public:
+
+    RenderFrame();
+
+    /*!
+      \brief copy the data of the current display data from the holder.
+      the caller must hold the read lock of the holder.
+      \param holder source holder
+     */
+    void update( const DispHolder & holder );
+
+    /*!
+      \brief get the revision of the holder when the frame was updated.
+      \return revision number
+     */
+    int revision() const { return M_revision; }
+
+    DispConstPtr currentDisp() const { return M_disp; }
+    const DispAnalysis & currentAnalysis() const { return M_analysis; }
+
+    const rcss::rcg::ServerParamT & serverParam() const { return M_server_param; }
+    const rcss::rcg::PlayerTypeT & playerType( const int id ) const;
+
+    const PenaltyCont & penaltyScoresLeft() const { return M_penalty_scores_left; }
+    const PenaltyCont & penaltyScoresRight() const { return M_penalty_scores_right; }
+
+    const PointCont & pointCont() const { return M_point_cont; }
+    const CircleCont & circleCont() const { return M_circle_cont; }
+    const LineCont & lineCont() const { return M_line_cont; }
+
+};
+
+#endif
@@ -0,0 +1,241 @@
+// -*-c++-*-
+
+/*!
+  \file render_layer.cpp
+  \brief field render layer class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "render_layer.h"
+
+#include "painter_interface.h"
+#include "render_settings.h"
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderLayer::RenderLayer( const Input input )
+    : M_input( input ),
+      M_version( -1 ),
+      M_revision( -1 ),
+      M_busy( false ),
+      M_stop( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderLayer::~RenderLayer()
+{
+    stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::addPainter( const boost::shared_ptr< PainterInterface > & painter )
+{
+    M_painters.push_back( painter );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+RenderLayer::isDirty( const QSize & size,
+                      const RenderSettings & settings,
+                      const DispConstPtr & disp,
+                      const int revision ) const
+{
+    return ( size != M_size
+             || settings.version() != M_version
+             || disp != M_disp
+             || revision != M_revision );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::prepare( const QSize & size,
+                      const RenderSettings & settings,
+                      const DispConstPtr & disp,
+                      const int revision )
+{
+    // the inputs are not read by the layer thread.
+    M_size = size;
+    M_version = settings.version();
+    M_disp = disp;
+    M_revision = revision;
+
+    for ( std::vector< boost::shared_ptr< PainterInterface > >::iterator it = M_painters.begin();
+          it != M_painters.end();
+          ++it )
+    {
+        (*it)->prepare( settings );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::render( const boost::shared_ptr< const RenderSettings > & settings )
+{
+    paint( *settings );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::post( const boost::shared_ptr< const RenderSettings > & settings )
+{
+    QMutexLocker lock( &M_mutex );
+    M_job_settings = settings;
+    M_busy = true;
+    M_start_condition.wakeOne();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::waitForFinish()
+{
+    QMutexLocker lock( &M_mutex );
+
+    while ( M_busy )
+    {
+        M_finish_condition.wait( &M_mutex );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::stop()
+{
+    {
+        QMutexLocker lock( &M_mutex );
+        M_stop = true;
+        M_start_condition.wakeOne();
+    }
+
+    wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::run()
+{
+    while ( true )
+    {
+        boost::shared_ptr< const RenderSettings > settings;
+
+        {
+            QMutexLocker lock( &M_mutex );
+
+            while ( ! M_stop
+                    && ( ! M_busy || ! M_job_settings ) )
+            {
+                M_start_condition.wait( &M_mutex );
+            }
+
+            if ( M_stop )
+            {
+                M_busy = false;
+                M_finish_condition.wakeAll();
+                return;
+            }
+
+            settings = M_job_settings;
+            M_job_settings.reset();
+        }
+
+        paint( *settings );
+
+        {
+            QMutexLocker lock( &M_mutex );
+            M_busy = false;
+            M_finish_condition.wakeAll();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderLayer::paint( const RenderSettings & settings )
+{
+    if ( M_image.size() != M_size )
+    {
+        M_image = QImage( M_size, QImage::Format_ARGB32_Premultiplied );
+    }
+
+    M_image.fill( 0 );
+
+    QPainter painter( &M_image );
+
+    // each layer has its own painter, so the state left by the pitch
+    // painter is not inherited.
+    if ( settings.antiAliasing() )
+    {
+        painter.setRenderHint( QPainter::Antialiasing );
+    }
+
+    for ( std::vector< boost::shared_ptr< PainterInterface > >::iterator it = M_painters.begin();
+          it != M_painters.end();
+          ++it )
+    {
+        (*it)->draw( painter, settings );
+    }
+}
@@ -0,0 +1,171 @@
+// -*-c++-*-
+
+/*!
+  \file render_layer.h
+  \brief field render layer class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_RENDER_LAYER_H
+#define RCSSMONITOR_RENDER_LAYER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QImage>
+#include <QSize>
+
+#include "disp_holder.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+class PainterInterface;
+class RenderSettings;
+
+/*!
+  \class RenderLayer
+  \brief one layer of the field image painted by its own painters.
+
+  Each layer owns its painters and a premultiplied transparent image, so
+  the layers can be painted concurrently without sharing any painter
+  state. The layer remembers the inputs of the last painting, and is
+  painted again only when they are changed. The painters copy the data
+  from DispHolder in prepare() under the read lock held by the caller,
+  and paint without the lock.
+*/
+class RenderLayer
+    : public QThread {
+public:
+
+    /*!
+      \enum Input
+      \brief the display data that the layer depends on.
+     */
+    enum Input {
+        LOG_INPUT, //!< depends only on the opened log, e.g. the server parameters.
+        DISP_INPUT //!< depends on the current display data.
+    };
+
+private:
+
+    const Input M_input;
+
+    std::vector< boost::shared_ptr< PainterInterface > > M_painters;
+
+    //! painted image. written only while the layer is busy.
+    QImage M_image;
+
+    //! image size of the last painting
+    QSize M_size;
+    //! settings version of the last painting
+    int M_version;
+    //! display data of the last painting
+    DispConstPtr M_disp;
+    //! holder revision of the last painting
+    int M_revision;
+
+    QMutex M_mutex;
+    QWaitCondition M_start_condition;
+    QWaitCondition M_finish_condition;
+
+    //! the settings of the posted job. protected by M_mutex.
+    boost::shared_ptr< const RenderSettings > M_job_settings;
+    //! true while the posted job is not finished. protected by M_mutex.
+    bool M_busy;
+    //! true if the thread should exit. protected by M_mutex.
+    bool M_stop;
+
+    // not used
+    RenderLayer();
+    RenderLayer( const RenderLayer & );
+    const RenderLayer & operator=( const RenderLayer & );
+
+public:
+
+    explicit
+    RenderLayer( const Input input );
+    ~RenderLayer();
+
+    void addPainter( const boost::shared_ptr< PainterInterface > & painter );
+
+    Input input() const { return M_input; }
+    const QImage & image() const { return M_image; }
+
+    /*!
+      \brief check if the inputs are changed since the last painting.
+      \param size image size
+      \param settings render settings
+      \param disp the display data that the layer depends on.
+      \param revision the holder revision that the layer depends on.
+     */
+    bool isDirty( const QSize & size,
+                  const RenderSettings & settings,
+                  const DispConstPtr & disp,
+                  const int revision ) const;
+
+    /*!
+      \brief record the inputs and let the painters copy the holder data.
+      the caller must hold the read lock of DispHolder.
+     */
+    void prepare( const QSize & size,
+                  const RenderSettings & settings,
+                  const DispConstPtr & disp,
+                  const int revision );
+
+    /*!
+      \brief paint the prepared layer in the caller's thread.
+     */
+    void render( const boost::shared_ptr< const RenderSettings > & settings );
+
+    /*!
+      \brief post the prepared painting to the layer thread. the thread must be started.
+     */
+    void post( const boost::shared_ptr< const RenderSettings > & settings );
+
+    /*!
+      \brief block until the posted painting is finished.
+     */
+    void waitForFinish();
+
+    /*!
+      \brief stop the thread and wait for its finish.
+     */
+    void stop();
+
+protected:
+
+    void run();
+
+private:
+
+    void paint( const RenderSettings & settings );
+
+};
+
+#endif
@@ -0,0 +1,123 @@
+// -*-c++-*-
+
+/*!
+  \file render_settings.cpp
+  \brief immutable render settings snapshot class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "render_settings.h"
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderSettings::RenderSettings( const Options & opt,
+                                const int version,
+                                const QPoint & field_center,
+                                const double & field_scale,
+                                const int selected_number )
+    : M_version( version ),
+      M_field_center( field_center ),
+      M_field_scale( field_scale ),
+      M_anti_aliasing( opt.antiAliasing() ),
+      M_show_score_board( opt.showScoreBoard() ),
+      M_show_keepaway_area( opt.showKeepawayArea() ),
+      M_show_team_graphic( opt.showTeamGraphic() ),
+      M_show_flag( opt.showFlag() ),
+      M_show_ball( opt.showBall() ),
+      M_show_player( opt.showPlayer() ),
+      M_show_player_number( opt.showPlayerNumber() ),
+      M_show_player_type( opt.showPlayerType() ),
+      M_show_view_area( opt.showViewArea() ),
+      M_show_catch_area( opt.showCatchArea() ),
+      M_show_tackle_area( opt.showTackleArea() ),
+      M_show_kick_accel_area( opt.showKickAccelArea() ),
+      M_show_stamina( opt.showStamina() ),
+      M_show_stamina_capacity( opt.showStaminaCapacity() ),
+      M_show_pointto( opt.showPointto() ),
+      M_show_card( opt.showCard() ),
+      M_show_offside_line( opt.showOffsideLine() ),
+      M_show_draw_info( opt.showDrawInfo() ),
+      M_show_grid_coord( opt.showGridCoord() ),
+      M_player_trace_all( opt.playerTraceAll() ),
+      M_ball_size( opt.ballSize() ),
+      M_player_size( opt.playerSize() ),
+      M_grid_step( opt.gridStep() ),
+      M_selected_number( selected_number ),
+      M_ball_vel_cycle( opt.ballVelCycle() ),
+      M_ball_trace_cycle( opt.ballTraceCycle() ),
+      M_player_trace_cycle( opt.playerTraceCycle() ),
+      M_heat_map_type( opt.heatMapType() ),
+      M_heat_map_cycle( opt.heatMapCycle() ),
+      M_field_brush( opt.fieldBrush() ),
+      M_line_pen( opt.linePen() ),
+      M_score_board_pen( opt.scoreBoardPen() ),
+      M_score_board_brush( opt.scoreBoardBrush() ),
+      M_ball_pen( opt.ballPen() ),
+      M_ball_brush( opt.ballBrush() ),
+      M_ball_vel_pen( opt.ballVelPen() ),
+      M_player_pen( opt.playerPen() ),
+      M_selected_player_pen( opt.selectedPlayerPen() ),
+      M_left_team_pen( opt.leftTeamPen() ),
+      M_left_team_brush( opt.leftTeamBrush() ),
+      M_left_goalie_pen( opt.leftGoaliePen() ),
+      M_left_goalie_stretch_pen( opt.leftGoalieStretchPen() ),
+      M_left_goalie_brush( opt.leftGoalieBrush() ),
+      M_right_team_pen( opt.rightTeamPen() ),
+      M_right_team_brush( opt.rightTeamBrush() ),
+      M_right_goalie_pen( opt.rightGoaliePen() ),
+      M_right_goalie_stretch_pen( opt.rightGoalieStretchPen() ),
+      M_right_goalie_brush( opt.rightGoalieBrush() ),
+      M_player_number_pen( opt.playerNumberPen() ),
+      M_player_number_inner_pen( opt.playerNumberInnerPen() ),
+      M_neck_pen( opt.neckPen() ),
+      M_view_area_pen( opt.viewAreaPen() ),
+      M_large_view_area_pen( opt.largeViewAreaPen() ),
+      M_ball_collide_brush( opt.ballCollideBrush() ),
+      M_player_collide_brush( opt.playerCollideBrush() ),
+      M_effort_decayed_pen( opt.effortDecayedPen() ),
+      M_recovery_decayed_pen( opt.recoveryDecayedPen() ),
+      M_kick_pen( opt.kickPen() ),
+      M_kick_fault_brush( opt.kickFaultBrush() ),
+      M_kick_accel_pen( opt.kickAccelPen() ),
+      M_catch_brush( opt.catchBrush() ),
+      M_catch_fault_brush( opt.catchFaultBrush() ),
+      M_tackle_pen( opt.tacklePen() ),
+      M_tackle_brush( opt.tackleBrush() ),
+      M_tackle_fault_brush( opt.tackleFaultBrush() ),
+      M_foul_charged_brush( opt.foulChargedBrush() ),
+      M_pointto_pen( opt.pointtoPen() ),
+      M_score_board_font( opt.scoreBoardFont() ),
+      M_player_font( opt.playerFont() )
+{
+
+}
@@ -0,0 +1,297 @@
+// -*-c++-*-
+
+/*!
+  \file render_settings.h
+  \brief immutable render settings snapshot class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_RENDER_SETTINGS_H
+#define RCSSMONITOR_RENDER_SETTINGS_H
+
+#include <QPen>
+#include <QBrush>
+#include <QFont>
+#include <QPoint>
+
+#include "options.h"
+
+#include <rcsslogplayer/types.h>
+
+#include <cmath>
+
+/*!
+  \class RenderSettings
+  \brief snapshot of the view options used by the painters.
+
+  The snapshot is copied from Options by the GUI thread when any view
+  option or the field transform is changed, and never modified after
+  that. The painters read only this object, so they can be driven
+  without the Options singleton, e.g. from a worker thread. The version
+  number is incremented for each new snapshot, and can be used as the
+  key of the painter side caches.
+*/
+class RenderSettings {
+private:
+
+    int M_version;
+
+    // transform
+    QPoint M_field_center;
+    double M_field_scale;
+
+    // switches
+    bool M_anti_aliasing;
+    bool M_show_score_board;
+    bool M_show_keepaway_area;
+    bool M_show_team_graphic;
+    bool M_show_flag;
+    bool M_show_ball;
+    bool M_show_player;
+    bool M_show_player_number;
+    bool M_show_player_type;
+    bool M_show_view_area;
+    bool M_show_catch_area;
+    bool M_show_tackle_area;
+    bool M_show_kick_accel_area;
+    bool M_show_stamina;
+    bool M_show_stamina_capacity;
+    bool M_show_pointto;
+    bool M_show_card;
+    bool M_show_offside_line;
+    bool M_show_draw_info;
+    bool M_show_grid_coord;
+    bool M_player_trace_all;
+
+    double M_ball_size;
+    double M_player_size;
+    double M_grid_step;
+
+    int M_selected_number;
+    int M_ball_vel_cycle;
+    int M_ball_trace_cycle;
+    int M_player_trace_cycle;
+    Options::HeatMapType M_heat_map_type;
+    int M_heat_map_cycle;
+
+    // pens, brushes and fonts
+    QBrush M_field_brush;
+    QPen M_line_pen;
+
+    QPen M_score_board_pen;
+    QBrush M_score_board_brush;
+
+    QPen M_ball_pen;
+    QBrush M_ball_brush;
+    QPen M_ball_vel_pen;
+
+    QPen M_player_pen;
+    QPen M_selected_player_pen;
+    QPen M_left_team_pen;
+    QBrush M_left_team_brush;
+    QPen M_left_goalie_pen;
+    QPen M_left_goalie_stretch_pen;
+    QBrush M_left_goalie_brush;
+    QPen M_right_team_pen;
+    QBrush M_right_team_brush;
+    QPen M_right_goalie_pen;
+    QPen M_right_goalie_stretch_pen;
+    QBrush M_right_goalie_brush;
+    QPen M_player_number_pen;
+    QPen M_player_number_inner_pen;
+    QPen M_neck_pen;
+    QPen M_view_area_pen;
+    QPen M_large_view_area_pen;
+    QBrush M_ball_collide_brush;
+    QBrush M_player_collide_brush;
+    QPen M_effort_decayed_pen;
+    QPen M_recovery_decayed_pen;
+    QPen M_kick_pen;
+    QBrush M_kick_fault_brush;
+    QPen M_kick_accel_pen;
+    QBrush M_catch_brush;
+    QBrush M_catch_fault_brush;
+    QPen M_tackle_pen;
+    QBrush M_tackle_brush;
+    QBrush M_tackle_fault_brush;
+    QBrush M_foul_charged_brush;
+    QPen M_pointto_pen;
+
+    QFont M_score_board_font;
+    QFont M_player_font;
+
+    // not used
+    RenderSettings();
+    const RenderSettings & operator=( const RenderSettings & );
+
+public:
+
+    /*!
+      \brief take the snapshot of the options.
+      \param opt view options
+      \param version version number of the snapshot
+      \param field_center screen point of the field center
+      \param field_scale field scale
+      \param selected_number selected player number. see Options::selectedNumber().
+      the canvases of the field wall give their own transform and no selection.
+     */
+    RenderSettings( const Options & opt,
+                    const int version,
+                    const QPoint & field_center,
+                    const double & field_scale,
+                    const int selected_number );
+
+    int version() const { return M_version; }
+
+    //
+    // transform
+    //
+
+    const QPoint & fieldCenter() const { return M_field_center; }
+    const double & fieldScale() const { return M_field_scale; }
+
+    int scale( const double & len ) const
+      {
+          return static_cast< int >( ::rint( len * M_field_scale ) );
+      }
+
+    int screenX( const double & x ) const
+      {
+          return M_field_center.x() + scale( x );
+      }
+
+    int screenY( const double & y ) const
+      {
+          return M_field_center.y() + scale( y );
+      }
+
+    double fieldX( const int x ) const
+      {
+          return ( x - M_field_center.x() ) / M_field_scale;
+      }
+
+    double fieldY( const int y ) const
+      {
+          return ( y - M_field_center.y() ) / M_field_scale;
+      }
+
+    //
+    // switches
+    //
+
+    bool antiAliasing() const { return M_anti_aliasing; }
+    bool showScoreBoard() const { return M_show_score_board; }
+    bool showKeepawayArea() const { return M_show_keepaway_area; }
+    bool showTeamGraphic() const { return M_show_team_graphic; }
+    bool showFlag() const { return M_show_flag; }
+    bool showBall() const { return M_show_ball; }
+    bool showPlayer() const { return M_show_player; }
+    bool showPlayerNumber() const { return M_show_player_number; }
+    bool showPlayerType() const { return M_show_player_type; }
+    bool showViewArea() const { return M_show_view_area; }
+    bool showCatchArea() const { return M_show_catch_area; }
+    bool showTackleArea() const { return M_show_tackle_area; }
+    bool showKickAccelArea() const { return M_show_kick_accel_area; }
+    bool showStamina() const { return M_show_stamina; }
+    bool showStaminaCapacity() const { return M_show_stamina_capacity; }
+    bool showPointto() const { return M_show_pointto; }
+    bool showCard() const { return M_show_card; }
+    bool showOffsideLine() const { return M_show_offside_line; }
+    bool showDrawInfo() const { return M_show_draw_info; }
+    bool showGridCoord() const { return M_show_grid_coord; }
+    bool playerTraceAll() const { return M_player_trace_all; }
+
+    const double & ballSize() const { return M_ball_size; }
+    const double & playerSize() const { return M_player_size; }
+    const double & gridStep() const { return M_grid_step; }
+
+    int selectedNumber() const { return M_selected_number; }
+    bool selectedPlayer( const rcss::rcg::Side side,
+                         const int unum ) const
+      {
+          return ( M_selected_number
+                   == ( side == rcss::rcg::LEFT ? unum : -unum ) );
+      }
+
+    int ballVelCycle() const { return M_ball_vel_cycle; }
+    int ballTraceCycle() const { return M_ball_trace_cycle; }
+    int playerTraceCycle() const { return M_player_trace_cycle; }
+    Options::HeatMapType heatMapType() const { return M_heat_map_type; }
+    int heatMapCycle() const { return M_heat_map_cycle; }
+
+    //
+    // pens, brushes and fonts
+    //
+
+    const QBrush & fieldBrush() const { return M_field_brush; }
+    const QPen & linePen() const { return M_line_pen; }
+
+    const QPen & scoreBoardPen() const { return M_score_board_pen; }
+    const QBrush & scoreBoardBrush() const { return M_score_board_brush; }
+
+    const QPen & ballPen() const { return M_ball_pen; }
+    const QBrush & ballBrush() const { return M_ball_brush; }
+    const QPen & ballVelPen() const { return M_ball_vel_pen; }
+
+    const QPen & playerPen() const { return M_player_pen; }
+    const QPen & selectedPlayerPen() const { return M_selected_player_pen; }
+    const QPen & leftTeamPen() const { return M_left_team_pen; }
+    const QBrush & leftTeamBrush() const { return M_left_team_brush; }
+    const QPen & leftGoaliePen() const { return M_left_goalie_pen; }
+    const QPen & leftGoalieStretchPen() const { return M_left_goalie_stretch_pen; }
+    const QBrush & leftGoalieBrush() const { return M_left_goalie_brush; }
+    const QPen & rightTeamPen() const { return M_right_team_pen; }
+    const QBrush & rightTeamBrush() const { return M_right_team_brush; }
+    const QPen & rightGoaliePen() const { return M_right_goalie_pen; }
+    const QPen & rightGoalieStretchPen() const { return M_right_goalie_stretch_pen; }
+    const QBrush & rightGoalieBrush() const { return M_right_goalie_brush; }
+    const QPen & playerNumberPen() const { return M_player_number_pen; }
+    const QPen & playerNumberInnerPen() const { return M_player_number_inner_pen; }
+    const QPen & neckPen() const { return M_neck_pen; }
+    const QPen & viewAreaPen() const { return M_view_area_pen; }
+    const QPen & largeViewAreaPen() const { return M_large_view_area_pen; }
+    const QBrush & ballCollideBrush() const { return M_ball_collide_brush; }
+    const QBrush & playerCollideBrush() const { return M_player_collide_brush; }
+    const QPen & effortDecayedPen() const { return M_effort_decayed_pen; }
+    const QPen & recoveryDecayedPen() const { return M_recovery_decayed_pen; }
+    const QPen & kickPen() const { return M_kick_pen; }
+    const QBrush & kickFaultBrush() const { return M_kick_fault_brush; }
+    const QPen & kickAccelPen() const { return M_kick_accel_pen; }
+    const QBrush & catchBrush() const { return M_catch_brush; }
+    const QBrush & catchFaultBrush() const { return M_catch_fault_brush; }
+    const QPen & tacklePen() const { return M_tackle_pen; }
+    const QBrush & tackleBrush() const { return M_tackle_brush; }
+    const QBrush & tackleFaultBrush() const { return M_tackle_fault_brush; }
+    const QBrush & foulChargedBrush() const { return M_foul_charged_brush; }
+    const QPen & pointtoPen() const { return M_pointto_pen; }
+
+    const QFont & scoreBoardFont() const { return M_score_board_font; }
+    const QFont & playerFont() const { return M_player_font; }
+
+};
+
+#endif
@@ -0,0 +1,386 @@
+// -*-c++-*-
+
+/*!
+  \file render_worker.cpp
+  \brief field render worker class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "render_worker.h"
+
+#include "disp_holder.h"
+#include "render_layer.h"
+#include "render_settings.h"
+
+#include "field_painter.h"
+#include "heat_map_painter.h"
+#include "ball_painter.h"
+#include "player_painter.h"
+#include "score_board_painter.h"
+#include "team_graphic_painter.h"
+#include "trace_painter.h"
+#include "draw_info_painter.h"
+
+#include <iostream>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderWorker::RenderWorker( const DispHolder & disp_holder,
+                            const bool parallel_layers,
+                            QObject * parent )
+    : QThread( parent ),
+      M_disp_holder( disp_holder ),
+#if QT_VERSION >= 0x040400
+      M_threaded( QFontDatabase::supportsThreadedFontRendering() ),
+#else
+      M_threaded( false ),
+#endif
+      M_parallel( M_threaded
+                  && parallel_layers
+                  && QThread::idealThreadCount() > 1 ),
+      M_requested( false ),
+      M_stop( false ),
+      M_front( -1 )
+{
+    if ( ! M_threaded )
+    {
+        std::cerr << "The threaded font rendering is not supported."
+                  << " The field is painted in the GUI thread." << std::endl;
+    }
+
+    createLayers();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderWorker::~RenderWorker()
+{
+    stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::createLayers()
+{
+    boost::shared_ptr< RenderLayer > pitch( new RenderLayer( RenderLayer::LOG_INPUT ) );
+    pitch->addPainter( boost::shared_ptr< PainterInterface >( new FieldPainter( M_frame ) ) );
+    M_layers.push_back( pitch );
+
+    boost::shared_ptr< RenderLayer > players( new RenderLayer( RenderLayer::DISP_INPUT ) );
+    players->addPainter( boost::shared_ptr< PainterInterface >( new HeatMapPainter( M_disp_holder ) ) );
+    players->addPainter( boost::shared_ptr< PainterInterface >( new TracePainter( M_disp_holder ) ) );
+    players->addPainter( boost::shared_ptr< PainterInterface >( new PlayerPainter( M_frame ) ) );
+    M_layers.push_back( players );
+
+    boost::shared_ptr< RenderLayer > ball( new RenderLayer( RenderLayer::DISP_INPUT ) );
+    ball->addPainter( boost::shared_ptr< PainterInterface >( new BallPainter( M_frame ) ) );
+    M_layers.push_back( ball );
+
+    boost::shared_ptr< RenderLayer > draw_info( new RenderLayer( RenderLayer::DISP_INPUT ) );
+    draw_info->addPainter( boost::shared_ptr< PainterInterface >( new DrawInfoPainter( M_frame ) ) );
+    M_layers.push_back( draw_info );
+
+    boost::shared_ptr< RenderLayer > hud( new RenderLayer( RenderLayer::DISP_INPUT ) );
+    hud->addPainter( boost::shared_ptr< PainterInterface >( new ScoreBoardPainter( M_frame ) ) );
+    hud->addPainter( boost::shared_ptr< PainterInterface >( new TeamGraphicPainter( M_disp_holder ) ) );
+    M_layers.push_back( hud );
+
+    if ( M_parallel )
+    {
+        for ( std::vector< boost::shared_ptr< RenderLayer > >::iterator it = M_layers.begin();
+              it != M_layers.end();
+              ++it )
+        {
+            (*it)->start();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::request( const QSize & size,
+                       const boost::shared_ptr< const RenderSettings > & settings )
+{
+    if ( ! M_threaded )
+    {
+        paintNow( size, settings );
+        return;
+    }
+
+    QMutexLocker lock( &M_request_mutex );
+    M_request_size = size;
+    M_request_settings = settings;
+    M_requested = true;
+    M_wait_condition.wakeOne();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::paintNow( const QSize & size,
+                        const boost::shared_ptr< const RenderSettings > & settings )
+{
+    if ( size.isEmpty()
+         || ! settings )
+    {
+        return;
+    }
+
+    paintBackBuffer( size, settings );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+RenderWorker::copyFrontBuffer( QPixmap & pixmap )
+{
+    QMutexLocker lock( &M_buffer_mutex );
+
+    if ( M_front < 0 )
+    {
+        return false;
+    }
+
+    pixmap = QPixmap::fromImage( M_buffers[M_front] );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::stop()
+{
+    {
+        QMutexLocker lock( &M_request_mutex );
+        M_stop = true;
+        M_requested = false;
+        M_request_settings.reset();
+        M_wait_condition.wakeOne();
+    }
+
+    wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::run()
+{
+    while ( true )
+    {
+        QSize size;
+        boost::shared_ptr< const RenderSettings > settings;
+
+        {
+            QMutexLocker lock( &M_request_mutex );
+
+            while ( ! M_stop
+                    && ! M_requested )
+            {
+                M_wait_condition.wait( &M_request_mutex );
+            }
+
+            if ( M_stop )
+            {
+                return;
+            }
+
+            size = M_request_size;
+            settings = M_request_settings;
+            M_requested = false;
+        }
+
+        if ( size.isEmpty()
+             || ! settings )
+        {
+            continue;
+        }
+
+        paintBackBuffer( size, settings );
+
+        emit rendered();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::paintBackBuffer( const QSize & size,
+                               const boost::shared_ptr< const RenderSettings > & settings )
+{
+    // the back buffer is never read by the GUI thread.
+    int back = 0;
+    {
+        QMutexLocker lock( &M_buffer_mutex );
+        back = ( M_front == 0 ? 1 : 0 );
+    }
+
+    QImage & image = M_buffers[back];
+    if ( image.size() != size )
+    {
+        image = QImage( size, QImage::Format_RGB32 );
+    }
+
+    render( image, settings );
+
+    {
+        QMutexLocker lock( &M_buffer_mutex );
+        M_front = back;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderWorker::render( QImage & image,
+                      const boost::shared_ptr< const RenderSettings > & settings )
+{
+    DispConstPtr disp;
+    std::vector< RenderLayer * > dirty_layers;
+
+    {
+        // the GUI thread modifies the holder only under the write lock.
+        // the lock is released before the painting.
+        QReadLocker lock( &M_disp_holder.lock() );
+
+        M_frame.update( M_disp_holder );
+
+        disp = M_frame.currentDisp();
+        // the pitch is painted again only when a new log is opened.
+        const DispConstPtr first_disp = ( M_disp_holder.dispCont().empty()
+                                          ? DispConstPtr()
+                                          : M_disp_holder.dispCont().front() );
+
+        for ( std::vector< boost::shared_ptr< RenderLayer > >::iterator it = M_layers.begin();
+              it != M_layers.end();
+              ++it )
+        {
+            RenderLayer * layer = it->get();
+
+            if ( layer->input() == RenderLayer::DISP_INPUT
+                 && ! disp )
+            {
+                continue;
+            }
+
+            const bool log_input = ( layer->input() == RenderLayer::LOG_INPUT );
+            const DispConstPtr & input = ( log_input ? first_disp : disp );
+            const int revision = ( log_input ? 0 : M_frame.revision() );
+
+            if ( ! layer->isDirty( image.size(), *settings, input, revision ) )
+            {
+                continue;
+            }
+
+            layer->prepare( image.size(), *settings, input, revision );
+            dirty_layers.push_back( layer );
+        }
+    }
+
+    if ( M_parallel )
+    {
+        for ( std::vector< RenderLayer * >::iterator it = dirty_layers.begin();
+              it != dirty_layers.end();
+              ++it )
+        {
+            (*it)->post( settings );
+        }
+
+        for ( std::vector< RenderLayer * >::iterator it = dirty_layers.begin();
+              it != dirty_layers.end();
+              ++it )
+        {
+            (*it)->waitForFinish();
+        }
+    }
+    else
+    {
+        for ( std::vector< RenderLayer * >::iterator it = dirty_layers.begin();
+              it != dirty_layers.end();
+              ++it )
+        {
+            (*it)->render( settings );
+        }
+    }
+
+    //
+    // composite the layers
+    //
+
+    QPainter painter( &image );
+
+    for ( std::vector< boost::shared_ptr< RenderLayer > >::iterator it = M_layers.begin();
+          it != M_layers.end();
+          ++it )
+    {
+        if ( (*it)->input() == RenderLayer::DISP_INPUT
+             && ! disp )
+        {
+            continue;
+        }
+
+        if ( it == M_layers.begin() )
+        {
+            // the pitch layer is opaque.
+            painter.setCompositionMode( QPainter::CompositionMode_Source );
+        }
+        else
+        {
+            painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+        }
+
+        painter.drawImage( 0, 0, (*it)->image() );
+    }
+}
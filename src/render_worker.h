@@ -0,0 +1,179 @@
+// -*-c++-*-
+
+/*!
+  \file render_worker.h
+  \brief field render worker class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_RENDER_WORKER_H
+#define RCSSMONITOR_RENDER_WORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QImage>
+#include <QSize>
+
+#include "render_frame.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+class QPixmap;
+
+class DispHolder;
+class RenderLayer;
+class RenderSettings;
+
+/*!
+  \class RenderWorker
+  \brief worker thread that paints the field into the back buffer image.
+
+  The GUI thread posts the request with the settings snapshot, and only
+  copies the front buffer when a new frame has been rendered. The worker keeps only the
+  latest request, so the frames requested while the worker is busy are
+  dropped instead of queued. The worker holds the read lock of DispHolder
+  only while it copies the display data into the frame snapshot and the
+  painters prepare their own copies, so the GUI thread can handle the
+  packets during the painting. The buffers are swapped when the painting
+  is finished.
+
+  The painters are grouped into the layers (pitch, players and areas,
+  ball, debug draw info and HUD). The changed layers are painted
+  concurrently by their own threads on multi-core machines, and the
+  layer images are composited in order into the back buffer.
+
+  The painters draw texts. If the platform does not support the font
+  rendering outside the GUI thread, the thread is not used, and the
+  request is painted immediately in the caller's thread.
+*/
+class RenderWorker
+    : public QThread {
+
+    Q_OBJECT
+
+private:
+
+    const DispHolder & M_disp_holder;
+
+    //! the display data copied for the current painting. read by the painters.
+    RenderFrame M_frame;
+
+    //! layers in the compositing order
+    std::vector< boost::shared_ptr< RenderLayer > > M_layers;
+    //! true if the texts can be painted by the worker thread.
+    bool M_threaded;
+    //! true if the layers are painted by their own threads.
+    //! disabled when many canvases run their own workers.
+    bool M_parallel;
+
+    QMutex M_request_mutex;
+    QWaitCondition M_wait_condition;
+
+    //! the latest request. protected by M_request_mutex.
+    boost::shared_ptr< const RenderSettings > M_request_settings;
+    //! image size of the latest request. protected by M_request_mutex.
+    QSize M_request_size;
+    //! true if the request has not been taken. protected by M_request_mutex.
+    bool M_requested;
+    //! true if the thread should exit. protected by M_request_mutex.
+    bool M_stop;
+
+    //! protects M_front. the front buffer is read by the GUI thread under this lock.
+    QMutex M_buffer_mutex;
+    //! back buffer images. only the worker writes them.
+    QImage M_buffers[2];
+    //! index of the completed buffer. protected by M_buffer_mutex.
+    int M_front;
+
+    // not used
+    RenderWorker();
+    RenderWorker( const RenderWorker & );
+    const RenderWorker & operator=( const RenderWorker & );
+
+public:
+
+    RenderWorker( const DispHolder & disp_holder,
+                  const bool parallel_layers,
+                  QObject * parent );
+    ~RenderWorker();
+
+    /*!
+      \brief check if the worker thread is used.
+      \return false if the requests are painted in the caller's thread.
+     */
+    bool isThreaded() const { return M_threaded; }
+
+    /*!
+      \brief replace the pending request. never blocks except the request lock.
+      if the worker thread is not used, the request is painted before return,
+      and rendered() is not emitted.
+     */
+    void request( const QSize & size,
+                  const boost::shared_ptr< const RenderSettings > & settings );
+
+    /*!
+      \brief paint the request in the caller's thread and update the front buffer.
+      must not be called while the worker thread is running.
+      rendered() is not emitted.
+     */
+    void paintNow( const QSize & size,
+                   const boost::shared_ptr< const RenderSettings > & settings );
+
+    /*!
+      \brief convert the latest completed image. must be called by the GUI thread.
+      \param pixmap reference to the result variable
+      \return false if no image has been completed yet.
+     */
+    bool copyFrontBuffer( QPixmap & pixmap );
+
+    /*!
+      \brief stop the thread and wait for its finish.
+     */
+    void stop();
+
+private:
+
+    void createLayers();
+    void paintBackBuffer( const QSize & size,
+                          const boost::shared_ptr< const RenderSettings > & settings );
+    void render( QImage & image,
+                 const boost::shared_ptr< const RenderSettings > & settings );
+
+protected:
+
+    void run();
+
+signals:
+
+    void rendered();
+
+};
+
+#endif
@@ -0,0 +1,671 @@
+// -*-c++-*-
+
+/*!
+  \file replay_server.cpp
+  \brief rcg replay server for the monitor load test.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsslogplayer/gzfstream.h>
+#include <rcsslogplayer/handler.h>
+#include <rcsslogplayer/parser.h>
+#include <rcsslogplayer/types.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+using namespace rcss::rcg;
+
+namespace {
+
+//! simulator cycle length at the normal speed [ms]
+const double SIMULATOR_STEP_MSEC = 100.0;
+
+//! the client is removed after this number of consecutive send errors
+//! other than the full socket buffer, e.g. ECONNREFUSED from a closed monitor.
+//! some platforms never report such errors on the unconnected socket,
+//! so --client-timeout is still needed to remove the silent clients.
+const int MAX_SEND_ERRORS = 50;
+
+//! set by the signal handler to print the final statistics.
+volatile std::sig_atomic_t g_stop = 0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+extern "C"
+void
+handle_signal( int )
+{
+    g_stop = 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return current time [ms]
+ */
+double
+current_msec()
+{
+    struct timeval tv;
+    ::gettimeofday( &tv, 0 );
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief one line of the game log and its kind.
+ */
+struct Record {
+    enum Kind {
+        SHOW, //!< show data. one simulator cycle ends with it.
+        PARAM, //!< parameters. sent to each client when it connects.
+        OTHER //!< playmode, team, message and draw data
+    };
+
+    std::string line_;
+    Kind kind_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief handler that remembers the kind of the last parsed line.
+ */
+class RecordClassifier
+    : public Handler {
+private:
+    int M_log_version;
+    Record::Kind M_kind;
+
+public:
+    explicit
+    RecordClassifier( const int log_version )
+        : M_log_version( log_version )
+        , M_kind( Record::OTHER )
+      { }
+
+    Record::Kind kind() const { return M_kind; }
+    void reset() { M_kind = Record::OTHER; }
+
+protected:
+    void doHandleLogVersion( int ver ) { M_log_version = ver; }
+    int doGetLogVersion() const { return M_log_version; }
+    void doHandleShowInfo( const ShowInfoT & ) { M_kind = Record::SHOW; }
+    void doHandleServerParam( const ServerParamT & ) { M_kind = Record::PARAM; }
+    void doHandlePlayerParam( const PlayerParamT & ) { M_kind = Record::PARAM; }
+    void doHandlePlayerType( const PlayerTypeT & ) { M_kind = Record::PARAM; }
+
+    void doHandleMsgInfo( const int, const int, const std::string & ) { }
+    void doHandlePlayMode( const int, const PlayMode ) { }
+    void doHandleTeamInfo( const int, const TeamT &, const TeamT & ) { }
+    void doHandleDrawClear( const int ) { }
+    void doHandleDrawPointInfo( const int, const PointInfoT & ) { }
+    void doHandleDrawCircleInfo( const int, const CircleInfoT & ) { }
+    void doHandleDrawLineInfo( const int, const LineInfoT & ) { }
+    void doHandleEOF() { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief connected monitor client and its statistics.
+ */
+struct Client {
+    struct sockaddr_in addr_;
+    int version_;
+    double connect_time_; //!< [ms]
+    double command_time_; //!< time of the last command from the client [ms]
+
+    // only the send side is counted. the packets lost in the network or in
+    // the receive buffer of the monitor are not visible from the server.
+    long sent_; //!< total number of the sent packets
+    long dropped_; //!< total number of the packets rejected by the full socket buffer
+    long errors_; //!< total number of the packets failed by the other errors
+    long window_sent_; //!< packets sent in the current report window
+    long window_dropped_; //!< packets rejected in the current report window
+    int consecutive_errors_; //!< errors since the last successful send
+
+    std::string name() const
+      {
+          std::ostringstream os;
+          os << inet_ntoa( addr_.sin_addr ) << ':' << ntohs( addr_.sin_port );
+          return os.str();
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the text game log into memory.
+  \return true if successfully loaded.
+ */
+bool
+load_records( const std::string & path,
+              std::vector< Record > & records )
+{
+    boost::shared_ptr< std::istream > is;
+    if ( path.size() > 3
+         && path.compare( path.size() - 3, 3, ".gz" ) == 0 )
+    {
+        is = boost::shared_ptr< std::istream >( new rcss::gzifstream( path.c_str() ) );
+    }
+    else
+    {
+        is = boost::shared_ptr< std::istream >( new std::ifstream( path.c_str() ) );
+    }
+
+    std::string line;
+    if ( ! std::getline( *is, line ) )
+    {
+        std::cerr << "Failed to read the game log [" << path << "]" << std::endl;
+        return false;
+    }
+
+    // the monitor protocol v3+ uses the same text lines as the rcg v4+.
+    int log_version = 0;
+    if ( line.compare( 0, 4, "ULG4" ) == 0 )
+    {
+        log_version = REC_VERSION_4;
+    }
+    else if ( line.compare( 0, 4, "ULG5" ) == 0 )
+    {
+        log_version = REC_VERSION_5;
+    }
+    else
+    {
+        std::cerr << "Unsupported game log format. Only the text rcg (v4 or later) is supported."
+                  << std::endl;
+        return false;
+    }
+
+    RecordClassifier classifier( log_version );
+    Parser parser( classifier );
+
+    int n_line = 1;
+    while ( std::getline( *is, line ) )
+    {
+        ++n_line;
+        if ( line.empty()
+             || line[0] != '(' )
+        {
+            continue;
+        }
+
+        classifier.reset();
+        parser.parseLine( n_line, line );
+
+        Record record;
+        record.line_ = line;
+        record.kind_ = classifier.kind();
+        if ( record.kind_ == Record::OTHER
+             && line.compare( 0, 6, "(show " ) == 0 )
+        {
+            // the broken show line still ends the cycle.
+            record.kind_ = Record::SHOW;
+        }
+        records.push_back( record );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+send_record( const int sock,
+             const std::string & line,
+             Client & client )
+{
+    const ssize_t n = ::sendto( sock, line.c_str(), line.length() + 1, 0,
+                                reinterpret_cast< const struct sockaddr * >( &client.addr_ ),
+                                sizeof( client.addr_ ) );
+    if ( n >= 0 )
+    {
+        ++client.sent_;
+        ++client.window_sent_;
+        client.consecutive_errors_ = 0;
+    }
+    else if ( errno == EAGAIN
+              || errno == EWOULDBLOCK
+              || errno == ENOBUFS )
+    {
+        ++client.dropped_;
+        ++client.window_dropped_;
+    }
+    else
+    {
+        // the monitor has gone without (dispbye).
+        // the packet is not counted as the drop.
+        ++client.errors_;
+        ++client.consecutive_errors_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief remove the clients that have gone without (dispbye).
+  \param timeout_msec command timeout. no timeout if not positive.
+ */
+void
+expire_clients( std::vector< Client > & clients,
+                const double & timeout_msec )
+{
+    const double now = current_msec();
+
+    std::vector< Client >::iterator it = clients.begin();
+    while ( it != clients.end() )
+    {
+        if ( it->consecutive_errors_ >= MAX_SEND_ERRORS )
+        {
+            std::cerr << "Expired " << it->name() << " after "
+                      << it->consecutive_errors_ << " send errors" << std::endl;
+            it = clients.erase( it );
+        }
+        else if ( timeout_msec > 0.0
+                  && now - it->command_time_ >= timeout_msec )
+        {
+            std::cerr << "Expired " << it->name() << " after "
+                      << ( now - it->command_time_ ) / 1000.0 << " sec without command" << std::endl;
+            it = clients.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief handle the datagrams from the monitors.
+ */
+void
+receive_commands( const int sock,
+                  const std::vector< Record > & records,
+                  std::vector< Client > & clients )
+{
+    char buf[8192];
+
+    while ( true )
+    {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof( from );
+        const ssize_t n = ::recvfrom( sock, buf, sizeof( buf ) - 1, 0,
+                                      reinterpret_cast< struct sockaddr * >( &from ), &from_len );
+        if ( n < 0 )
+        {
+            if ( errno == EAGAIN
+                 || errno == EWOULDBLOCK )
+            {
+                // no more datagram.
+                return;
+            }
+            // the pending error of the previous send, e.g. ECONNREFUSED.
+            continue;
+        }
+        buf[n] = '\0';
+
+        std::vector< Client >::iterator client = clients.begin();
+        for ( ; client != clients.end(); ++client )
+        {
+            if ( client->addr_.sin_addr.s_addr == from.sin_addr.s_addr
+                 && client->addr_.sin_port == from.sin_port )
+            {
+                break;
+            }
+        }
+
+        if ( ! std::strncmp( buf, "(dispinit", 9 ) )
+        {
+            int version = 1;
+            std::sscanf( buf, "(dispinit version %d)", &version );
+
+            if ( version < 3 )
+            {
+                std::cerr << "Unsupported monitor protocol version " << version
+                          << ". Use the client version 3 or later." << std::endl;
+                continue;
+            }
+
+            if ( client == clients.end() )
+            {
+                Client c;
+                std::memset( &c, 0, sizeof( c ) );
+                c.addr_ = from;
+                c.connect_time_ = current_msec();
+                clients.push_back( c );
+                client = clients.end() - 1;
+            }
+            client->command_time_ = current_msec();
+            client->version_ = version;
+
+            std::cerr << "Connected " << client->name() << " version " << version << std::endl;
+
+            for ( std::vector< Record >::const_iterator it = records.begin();
+                  it != records.end();
+                  ++it )
+            {
+                if ( it->kind_ == Record::PARAM )
+                {
+                    send_record( sock, it->line_, *client );
+                }
+            }
+        }
+        else if ( ! std::strncmp( buf, "(dispbye", 8 ) )
+        {
+            if ( client != clients.end() )
+            {
+                std::cerr << "Disconnected " << client->name() << std::endl;
+                clients.erase( client );
+            }
+        }
+        else
+        {
+            if ( client != clients.end() )
+            {
+                client->command_time_ = current_msec();
+            }
+            // the referee commands are not supported.
+            std::cerr << "Ignored: " << buf << std::endl;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+print_statistics( const std::vector< Client > & clients,
+                  const double & window_sec,
+                  const bool total )
+{
+    const double now = current_msec();
+
+    for ( std::vector< Client >::const_iterator it = clients.begin();
+          it != clients.end();
+          ++it )
+    {
+        const long sent = ( total ? it->sent_ : it->window_sent_ );
+        const long dropped = ( total ? it->dropped_ : it->window_dropped_ );
+        const double sec = ( total ? ( now - it->connect_time_ ) / 1000.0 : window_sec );
+        const double rate = ( sec > 0.0 ? sent / sec : 0.0 );
+        const double drop_rate = ( sent + dropped > 0
+                                   ? 100.0 * dropped / ( sent + dropped )
+                                   : 0.0 );
+
+        char buf[256];
+        std::snprintf( buf, sizeof( buf ),
+                       "%s %-21s sent %8ld  %9.1f pkt/s  send-dropped %6ld (%.2f%%)",
+                       ( total ? "total " : "client" ),
+                       it->name().c_str(), sent, rate, dropped, drop_rate );
+        if ( total )
+        {
+            std::snprintf( buf + std::strlen( buf ), sizeof( buf ) - std::strlen( buf ),
+                           "  errors %ld", it->errors_ );
+        }
+        std::cout << buf << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char ** argv )
+{
+    int port = 6000;
+    double speed = 1.0;
+    double report_sec = 5.0;
+    double client_timeout_sec = 0.0;
+    bool loop = false;
+    std::string path;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--port" ) && i + 1 < argc )
+        {
+            port = std::atoi( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--speed" ) && i + 1 < argc )
+        {
+            speed = std::atof( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--report" ) && i + 1 < argc )
+        {
+            report_sec = std::atof( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--client-timeout" ) && i + 1 < argc )
+        {
+            client_timeout_sec = std::atof( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "--loop" ) )
+        {
+            loop = true;
+        }
+        else if ( argv[i][0] != '-'
+                  && path.empty() )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            std::cout << "Usage: " << argv[0] << " [--port N] [--speed X] [--report SEC]"
+                      << " [--client-timeout SEC] [--loop] GameLogFile\n"
+                      << "  --port N              port number for the monitors. (default 6000)\n"
+                      << "  --speed X             replay speed. 1 is the real time, 0 is unthrottled. (default 1)\n"
+                      << "  --report SEC          interval of the statistics report. (default 5)\n"
+                      << "  --client-timeout SEC  remove the client that sends no command for SEC.\n"
+                      << "                        the monitor sends no command while it is receiving,\n"
+                      << "                        so use it only with the clients sending (dispinit)\n"
+                      << "                        periodically. 0 disables it. (default 0)\n"
+                      << "  --loop                replay the game log repeatedly.\n"
+                      << "The send-dropped counts only the packets rejected by the local socket.\n"
+                      << "Run the monitor with --cycle-stats to see the cycles lost on the way."
+                      << std::endl;
+            return ( ! std::strcmp( argv[i], "--help" ) ? 0 : 1 );
+        }
+    }
+
+    if ( path.empty() )
+    {
+        std::cerr << "No game log file." << std::endl;
+        return 1;
+    }
+
+    if ( port <= 0 || speed < 0.0 || report_sec <= 0.0 || client_timeout_sec < 0.0 )
+    {
+        std::cerr << "Illegal port, speed, report interval or client timeout." << std::endl;
+        return 1;
+    }
+
+    std::vector< Record > records;
+    if ( ! load_records( path, records ) )
+    {
+        return 1;
+    }
+
+    const int sock = ::socket( AF_INET, SOCK_DGRAM, 0 );
+    if ( sock == -1 )
+    {
+        std::cerr << "Failed to create the socket. " << std::strerror( errno ) << std::endl;
+        return 1;
+    }
+
+    struct sockaddr_in addr;
+    std::memset( &addr, 0, sizeof( addr ) );
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl( INADDR_ANY );
+    addr.sin_port = htons( static_cast< unsigned short >( port ) );
+
+    if ( ::bind( sock, reinterpret_cast< struct sockaddr * >( &addr ), sizeof( addr ) ) == -1 )
+    {
+        std::cerr << "Failed to bind the port " << port << ". " << std::strerror( errno ) << std::endl;
+        ::close( sock );
+        return 1;
+    }
+
+    // the full socket buffer is counted as the send-side drop instead of blocking.
+    ::fcntl( sock, F_SETFL, ::fcntl( sock, F_GETFL ) | O_NONBLOCK );
+
+    std::signal( SIGINT, handle_signal );
+    std::signal( SIGTERM, handle_signal );
+
+    std::cerr << "Loaded " << records.size() << " records. Waiting for monitors on port "
+              << port << " ..." << std::endl;
+
+    const double interval = ( speed > 0.0 ? SIMULATOR_STEP_MSEC / speed : 0.0 );
+
+    std::vector< Client > clients;
+    std::size_t pos = 0;
+    double next_time = current_msec();
+    double report_start = next_time;
+
+    while ( ! g_stop )
+    {
+        double now = current_msec();
+
+        // wait for the next cycle or the commands from the monitors.
+        double wait_msec = ( clients.empty()
+                             ? report_sec * 1000.0
+                             : std::max( 0.0, next_time - now ) );
+
+        fd_set fds;
+        FD_ZERO( &fds );
+        FD_SET( sock, &fds );
+        struct timeval tv;
+        tv.tv_sec = static_cast< long >( wait_msec / 1000.0 );
+        tv.tv_usec = static_cast< long >( wait_msec * 1000.0 ) % 1000000;
+
+        if ( ::select( sock + 1, &fds, 0, 0, &tv ) > 0 )
+        {
+            const bool first = clients.empty();
+            receive_commands( sock, records, clients );
+            if ( first && ! clients.empty() )
+            {
+                // start the replay with the first monitor.
+                next_time = current_msec();
+                report_start = next_time;
+            }
+        }
+
+        expire_clients( clients, client_timeout_sec * 1000.0 );
+
+        now = current_msec();
+
+        if ( ! clients.empty()
+             && now >= next_time )
+        {
+            // send one simulator cycle.
+            while ( pos < records.size() )
+            {
+                const Record & record = records[pos];
+                ++pos;
+
+                if ( record.kind_ == Record::PARAM )
+                {
+                    continue;
+                }
+
+                for ( std::vector< Client >::iterator it = clients.begin();
+                      it != clients.end();
+                      ++it )
+                {
+                    send_record( sock, record.line_, *it );
+                }
+
+                if ( record.kind_ == Record::SHOW )
+                {
+                    break;
+                }
+            }
+
+            if ( pos >= records.size() )
+            {
+                if ( ! loop )
+                {
+                    break;
+                }
+                pos = 0;
+            }
+
+            next_time += interval;
+            if ( next_time < now - 1000.0 )
+            {
+                // do not try to catch up the long delay.
+                next_time = now;
+            }
+        }
+
+        if ( now - report_start >= report_sec * 1000.0 )
+        {
+            print_statistics( clients, ( now - report_start ) / 1000.0, false );
+
+            for ( std::vector< Client >::iterator it = clients.begin();
+                  it != clients.end();
+                  ++it )
+            {
+                it->window_sent_ = 0;
+                it->window_dropped_ = 0;
+            }
+            report_start = now;
+        }
+    }
+
+    print_statistics( clients, 0.0, true );
+
+    ::close( sock );
+    return 0;
+}
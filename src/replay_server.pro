@@ -0,0 +1,47 @@
+TEMPLATE = app
+TARGET = rcssmonitor_replay_server
+DESTDIR = ../bin
+DEPENDPATH += .
+
+INCLUDEPATH += . ..
+unix {
+  INCLUDEPATH += /opt/local/include
+}
+macx {
+  INCLUDEPATH += /opt/local/include
+}
+
+unix {
+  LIBS += -lz
+}
+macx {
+  LIBS += -L/opt/local/lib -lz
+}
+
+DEFINES += HAVE_LIBZ
+unix {
+  DEFINES += HAVE_NETINET_IN_H
+}
+macx {
+  DEFINES += HAVE_NETINET_IN_H
+}
+
+CONFIG -= qt
+CONFIG += warn_on release console
+
+# Input
+HEADERS += \
+	rcsslogplayer/gzfstream.h \
+	rcsslogplayer/handler.h \
+	rcsslogplayer/parser.h \
+	rcsslogplayer/scanner.h \
+	rcsslogplayer/types.h \
+	rcsslogplayer/util.h
+
+SOURCES += \
+	rcsslogplayer/gzfstream.cpp \
+	rcsslogplayer/parser.cpp \
+	rcsslogplayer/scanner.cpp \
+	rcsslogplayer/types.cpp \
+	rcsslogplayer/util.cpp \
+	replay_server.cpp
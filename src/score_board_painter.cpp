@@ -38,8 +38,8 @@
 
 #include "score_board_painter.h"
 
-#include "disp_holder.h"
-#include "options.h"
+#include "render_frame.h"
+#include "render_settings.h"
 
 #include <iostream>
 
@@ -47,9 +47,14 @@
 /*!
 
 */
-ScoreBoardPainter::ScoreBoardPainter( const DispHolder & disp_holder )
-    : M_disp_holder( disp_holder )
+ScoreBoardPainter::ScoreBoardPainter( const RenderFrame & frame )
+    : M_frame( frame )
+    , M_show_penalty( false )
+    , M_playmode( -1 )
+    , M_bounding_rect( 0, 0, 0, 0 )
+    , M_text_width( 0 )
 {
+    M_scores[0] = M_scores[1] = 0;
     //M_font.setBold( true );
     //M_font.setStyleHint( QFont::System, QFont::PreferBitmap );
     //M_font.setFixedPitch( true );
@@ -69,18 +74,17 @@ ScoreBoardPainter::~ScoreBoardPainter()
 
 */
 void
-ScoreBoardPainter::draw( QPainter & painter )
+ScoreBoardPainter::draw( QPainter & painter,
+                         const RenderSettings & settings )
 {
     static const std::string s_playmode_strings[] = PLAYMODE_STRINGS;
 
-    const Options & opt = Options::instance();
-
-    if ( ! opt.showScoreBoard() )
+    if ( ! settings.showScoreBoard() )
     {
         return;
     }
 
-    DispConstPtr disp = M_disp_holder.currentDisp();
+    DispConstPtr disp = M_frame.currentDisp();
 
     if ( ! disp )
     {
@@ -94,8 +98,8 @@ ScoreBoardPainter::draw( QPainter & painter )
 
     const rcss::rcg::PlayMode pmode = disp->pmode_;
 
-    const std::vector< std::pair< int, rcss::rcg::PlayMode > > & pen_scores_l = M_disp_holder.penaltyScoresLeft();
-    const std::vector< std::pair< int, rcss::rcg::PlayMode > > & pen_scores_r = M_disp_holder.penaltyScoresRight();
+    const std::vector< std::pair< int, rcss::rcg::PlayMode > > & pen_scores_l = M_frame.penaltyScoresLeft();
+    const std::vector< std::pair< int, rcss::rcg::PlayMode > > & pen_scores_r = M_frame.penaltyScoresRight();
 
     bool show_pen_score = true;
 
@@ -119,26 +123,13 @@ ScoreBoardPainter::draw( QPainter & painter )
     }
 
 
-    QString main_buf;
+    std::string left_penalty;
+    std::string right_penalty;
 
-    if ( ! show_pen_score )
-    {
-        main_buf.sprintf( " %10s %d:%d %-10s %19s %6d    ",
-                          ( team_l.name_.empty() || team_l.name_ == "null" )
-                          ? ""
-                          : team_l.name_.c_str(),
-                          team_l.score_,
-                          team_r.score_,
-                          ( team_r.name_.empty() || team_r.name_ == "null" )
-                          ? ""
-                          : team_r.name_.c_str(),
-                          s_playmode_strings[pmode].c_str(),
-                          current_time );
-    }
-    else
+    if ( show_pen_score )
     {
-        std::string left_penalty; left_penalty.reserve( 10 );
-        std::string right_penalty; right_penalty.reserve( 10 );
+        left_penalty.reserve( 10 );
+        right_penalty.reserve( 10 );
 
         for ( std::vector< std::pair< int, rcss::rcg::PlayMode > >::const_iterator it = pen_scores_l.begin();
               it != pen_scores_l.end();
@@ -175,36 +166,94 @@ ScoreBoardPainter::draw( QPainter & painter )
                 right_penalty += 'x';
             }
         }
-
-        main_buf.sprintf( " %10s %d:%d |%-5s:%-5s| %-10s %19s %6d",
-                          ( team_l.name_.empty() || team_l.name_ == "null" )
-                          ? ""
-                          : team_l.name_.c_str(),
-                          team_l.score_, team_r.score_,
-                          left_penalty.c_str(),
-                          right_penalty.c_str(),
-                          ( team_r.name_.empty() || team_r.name_ == "null" )
-                          ? ""
-                          : team_r.name_.c_str(),
-                          s_playmode_strings[pmode].c_str(),
-                          current_time );
     }
 
     //painter.setFont( M_font );
-    painter.setFont( opt.scoreBoardFont() );
-    QRect bounding_rect = painter.fontMetrics().boundingRect( main_buf );
+    painter.setFont( settings.scoreBoardFont() );
+
+    // the text except the time changes only a few times in a game.
+    // it is formatted and laid out only when any of its inputs is changed.
+    if ( show_pen_score != M_show_penalty
+         || pmode != M_playmode
+         || team_l.score_ != M_scores[0]
+         || team_r.score_ != M_scores[1]
+         || team_l.name_ != M_team_names[0]
+         || team_r.name_ != M_team_names[1]
+         || left_penalty != M_penalty_marks[0]
+         || right_penalty != M_penalty_marks[1]
+         || settings.scoreBoardFont() != M_font )
+    {
+        M_show_penalty = show_pen_score;
+        M_playmode = pmode;
+        M_scores[0] = team_l.score_;
+        M_scores[1] = team_r.score_;
+        M_team_names[0] = team_l.name_;
+        M_team_names[1] = team_r.name_;
+        M_penalty_marks[0] = left_penalty;
+        M_penalty_marks[1] = right_penalty;
+        M_font = settings.scoreBoardFont();
+
+        const char * name_l = ( ( team_l.name_.empty() || team_l.name_ == "null" )
+                                ? ""
+                                : team_l.name_.c_str() );
+        const char * name_r = ( ( team_r.name_.empty() || team_r.name_ == "null" )
+                                ? ""
+                                : team_r.name_.c_str() );
+
+        if ( ! show_pen_score )
+        {
+            M_text.sprintf( " %10s %d:%d %-10s %19s ",
+                            name_l,
+                            team_l.score_,
+                            team_r.score_,
+                            name_r,
+                            s_playmode_strings[pmode].c_str() );
+        }
+        else
+        {
+            M_text.sprintf( " %10s %d:%d |%-5s:%-5s| %-10s %19s ",
+                            name_l,
+                            team_l.score_, team_r.score_,
+                            left_penalty.c_str(),
+                            right_penalty.c_str(),
+                            name_r,
+                            s_playmode_strings[pmode].c_str() );
+        }
+
+        M_bounding_rect = painter.fontMetrics().boundingRect( M_text );
+        M_text_width = painter.fontMetrics().width( M_text );
+#if QT_VERSION >= 0x040700
+        M_static_text.setText( M_text );
+        M_static_text.setPerformanceHint( QStaticText::AggressiveCaching );
+        M_static_text.prepare( QTransform(), M_font );
+#endif
+    }
+
+    // same as "%6d" of the whole text format.
+    const QString time_text = QString( show_pen_score ? "%1" : "%1    " ).arg( current_time, 6 );
+    const int time_width = painter.fontMetrics().width( time_text );
 
     QRect rect;
     rect.setLeft( 0 );
-    rect.setTop( painter.window().bottom() - bounding_rect.height() + 1 );
-    rect.setWidth( bounding_rect.width() );
-    rect.setHeight( bounding_rect.height() );
+    rect.setTop( painter.window().bottom() - M_bounding_rect.height() + 1 );
+    rect.setWidth( M_text_width + time_width );
+    rect.setHeight( M_bounding_rect.height() );
 
-    painter.fillRect( rect, opt.scoreBoardBrush() );
+    painter.fillRect( rect, settings.scoreBoardBrush() );
 
-    painter.setPen( opt.scoreBoardPen() );
+    painter.setPen( settings.scoreBoardPen() );
     painter.setBrush( Qt::NoBrush );
+#if QT_VERSION >= 0x040700
+    painter.drawStaticText( rect.left(),
+                            rect.top() + ( rect.height() - static_cast< int >( M_static_text.size().height() ) ) / 2,
+                            M_static_text );
+#else
     painter.drawText( rect,
                       Qt::AlignVCenter,
-                      main_buf );
+                      M_text );
+#endif
+    painter.drawText( QRect( rect.left() + M_text_width, rect.top(),
+                             time_width, rect.height() ),
+                      Qt::AlignVCenter,
+                      time_text );
 }
@@ -38,14 +38,41 @@
 #include <QPen>
 #include <QBrush>
 #include <QFont>
+#include <QRect>
+#include <QString>
+#if QT_VERSION >= 0x040700
+#include <QStaticText>
+#endif
+
+#include <string>
 
-class DispHolder;
+class RenderFrame;
 
 class ScoreBoardPainter
     : public PainterInterface {
 private:
 
-    const DispHolder & M_disp_holder;
+    const RenderFrame & M_frame;
+
+    // the inputs of the cached text. the time is drawn separately.
+    std::string M_team_names[2];
+    int M_scores[2];
+    std::string M_penalty_marks[2];
+    bool M_show_penalty;
+    int M_playmode;
+
+    //! last drawn text except the time
+    QString M_text;
+    //! font used to measure the last drawn text
+    QFont M_font;
+    //! bounding rect of the last drawn text
+    QRect M_bounding_rect;
+    //! advance width of the last drawn text. the time is drawn after it.
+    int M_text_width;
+#if QT_VERSION >= 0x040700
+    //! laid out text
+    QStaticText M_static_text;
+#endif
 
     // not used
     ScoreBoardPainter();
@@ -54,10 +81,11 @@ private:
 public:
 
     explicit
-    ScoreBoardPainter( const DispHolder & disp_holder );
+    ScoreBoardPainter( const RenderFrame & frame );
     ~ScoreBoardPainter();
 
-    void draw( QPainter & painter );
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
 
 };
 
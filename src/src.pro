@@ -41,10 +41,15 @@ win32 {
 }
 unix {
   DEFINES += HAVE_NETINET_IN_H
+  DEFINES += HAVE_SYS_MMAN_H
   DEFINES += HAVE_BOOST_PROGRAM_OPTIONS
 }
+unix:!macx {
+  LIBS += -lrt
+}
 macx-g++ {
   DEFINES += HAVE_NETINET_IN_H
+  DEFINES += HAVE_SYS_MMAN_H
   DEFINES += HAVE_BOOST_PROGRAM_OPTIONS
 }
 DEFINES += PACKAGE="\\\"rcssmonitor\\\""
@@ -66,16 +71,23 @@ win32 {
 HEADERS += \
 	rcsslogplayer/handler.h \
 	rcsslogplayer/parser.h \
+	rcsslogplayer/scanner.h \
 	rcsslogplayer/types.h \
 	rcsslogplayer/util.h \
 	angle_deg.h \
 	ball_painter.h \
 	circle_2d.h \
 	config_dialog.h \
+	cycle_stats.h \
 	disp_holder.h \
 	draw_info_painter.h \
 	field_canvas.h \
 	field_painter.h \
+	field_wall.h \
+	frame_presenter.h \
+	frame_ring.h \
+	heat_map.h \
+	heat_map_painter.h \
 	line_2d.h \
 	log_player.h \
 	main_window.h \
@@ -85,23 +97,37 @@ HEADERS += \
 	painter_interface.h \
 	player_painter.h \
 	player_type_dialog.h \
+	render_frame.h \
+	render_layer.h \
+	render_settings.h \
+	render_worker.h \
 	score_board_painter.h \
 	team_graphic.h \
 	team_graphic_painter.h \
+	thumbnail_renderer.h \
+	timeline_strip.h \
+	trace_painter.h \
 	vector_2d.h
 
 SOURCES += \
 	rcsslogplayer/parser.cpp \
+	rcsslogplayer/scanner.cpp \
 	rcsslogplayer/types.cpp \
 	rcsslogplayer/util.cpp \
 	angle_deg.cpp \
 	ball_painter.cpp \
 	circle_2d.cpp \
 	config_dialog.cpp \
+	cycle_stats.cpp \
 	disp_holder.cpp \
 	draw_info_painter.cpp \
 	field_canvas.cpp \
 	field_painter.cpp \
+	field_wall.cpp \
+	frame_presenter.cpp \
+	frame_ring.cpp \
+	heat_map.cpp \
+	heat_map_painter.cpp \
 	line_2d.cpp \
 	log_player.cpp \
 	main_window.cpp \
@@ -109,9 +135,16 @@ SOURCES += \
 	options.cpp \
 	player_painter.cpp \
 	player_type_dialog.cpp \
+	render_frame.cpp \
+	render_layer.cpp \
+	render_settings.cpp \
+	render_worker.cpp \
 	score_board_painter.cpp \
 	team_graphic.cpp \
 	team_graphic_painter.cpp \
+	thumbnail_renderer.cpp \
+	timeline_strip.cpp \
+	trace_painter.cpp \
 	vector_2d.cpp \
 	main.cpp
 
@@ -34,6 +34,13 @@
 #include <config.h>
 #endif
 
+#include <QColor>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
 #include "team_graphic.h"
 
 #include <algorithm>
@@ -41,61 +48,34 @@
 #include <iostream>
 #include <cstring>
 #include <cstdio>
+#include <cctype>
 
 const int TeamGraphic::MAX_WIDTH = 256;
 const int TeamGraphic::MAX_HEIGHT = 64;
 const int TeamGraphic::TILE_SIZE = 8;
 const int TeamGraphic::MAX_COLOR = 256;
 
-/*-------------------------------------------------------------------*/
-/*!
-
-*/
-TeamGraphic::XpmTile::XpmTile( const int width,
-                               const int height,
-                               const int cpp )
-    : M_width( width )
-    , M_height( height )
-    , M_cpp( cpp )
-{
-    M_pixel_lines.reserve( TILE_SIZE );
-}
+namespace {
+//! color value of "None"
+const QRgb TRANSPARENT_RGB = 0;
 
 /*-------------------------------------------------------------------*/
 /*!
-
+  FNV-1a hash of the null terminated string.
 */
-std::ostream &
-TeamGraphic::XpmTile::print( std::ostream & os ) const
+inline
+quint64
+hash_string( const char * str )
 {
-    os << '"' << width()
-       << ' ' << height()
-       << ' ' << colors().size()
-       << ' ' << cpp()
-       << '"';
-    //os << "\n";
-
-    const std::vector< boost::shared_ptr< std::string > >::const_iterator cend
-        = colors().end();
-    for ( std::vector< boost::shared_ptr< std::string > >::const_iterator it
-              = colors().begin();
-          it != cend;
-          ++it )
-    {
-        os << " \"" << **it << '"';
-        //os << "\n";
-    }
-
-    const std::vector< std::string >::const_iterator pend = pixelLines().end();
-    for ( std::vector< std::string >::const_iterator it = pixelLines().begin();
-          it != pend;
-          ++it )
+    quint64 hash = Q_UINT64_C( 14695981039346656037 );
+    for ( ; *str != '\0'; ++str )
     {
-        os << " \"" << *it << '"';
-        //os << "\n";
+        hash ^= static_cast< unsigned char >( *str );
+        hash *= Q_UINT64_C( 1099511628211 );
     }
+    return hash;
+}
 
-    return os;
 }
 
 /*-------------------------------------------------------------------*/
@@ -105,9 +85,10 @@ TeamGraphic::XpmTile::print( std::ostream & os ) const
 TeamGraphic::TeamGraphic()
     : M_width( 0 )
     , M_height( 0 )
-    , M_cpp( 1 )
+    , M_generation( 0 )
+    , M_modified( false )
 {
-
+    initImage();
 }
 
 /*-------------------------------------------------------------------*/
@@ -119,10 +100,28 @@ TeamGraphic::clear()
 {
     M_width = 0;
     M_height = 0;
-    M_cpp = 1;
+    ++M_generation;
 
-    M_colors.clear();
+    initImage();
     M_tiles.clear();
+    M_updated_tiles.clear();
+    M_modified = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TeamGraphic::initImage()
+{
+    // the palette index 0 is always the transparent color.
+    M_image = QImage( MAX_WIDTH, MAX_HEIGHT, QImage::Format_Indexed8 );
+    M_image.setColorTable( QVector< QRgb >( 1, TRANSPARENT_RGB ) );
+    M_image.fill( 0 );
+
+    M_palette_index.clear();
+    M_palette_index.insert( TRANSPARENT_RGB, 0 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -170,15 +169,27 @@ TeamGraphic::createXpmTiles( const char * const * xpm_data )
 
     ++xpm_data; // skip header line
 
-    // check color data size
+    //
+    // check color data
+    //
+    QRgb colors[256];
+    bool defined[256];
+    std::fill( defined, defined + 256, false );
+
     for ( int i = 0; i < xpm_n_color; ++i )
     {
-        if ( ! xpm_data[i] )
+        QRgb rgb = TRANSPARENT_RGB;
+        if ( ! xpm_data[i]
+             || ! parseColor( xpm_data[i], rgb ) )
         {
             std::cerr << "Illegal xpm data. The number of color is not valid."
                       << std::endl;
             return false;
         }
+
+        const unsigned char symbol = static_cast< unsigned char >( xpm_data[i][0] );
+        colors[symbol] = rgb;
+        defined[symbol] = true;
     }
 
     //
@@ -197,94 +208,27 @@ TeamGraphic::createXpmTiles( const char * const * xpm_data )
     //
     // clear old data
     //
-    M_width = xpm_width;
-    M_height = xpm_height;
-    M_cpp = xpm_cpp;
-    M_colors.clear();
-    M_tiles.clear();
-
-    //
-    // register color strings
-    //
-    for ( int i = 0; i < xpm_n_color; ++i, ++xpm_data )
-    {
-        boost::shared_ptr< std::string > ptr( new std::string( *xpm_data ) );
-        M_colors.push_back( ptr );
-    }
+    clear();
 
     //
-    // create xpm tiles
+    // decode all pixels at once, and register all tiles
     //
-    const int tile_width = TILE_SIZE * xpm_cpp;
+    decodePixels( 0, 0, xpm_width,
+                  xpm_data + xpm_n_color, xpm_height,
+                  colors, defined );
 
-    int index_y = 0;
-    for ( int start_y = 0;
-          start_y < xpm_height;
-          start_y += TILE_SIZE, ++index_y )
+    for ( int index_y = 0; index_y * TILE_SIZE < xpm_height; ++index_y )
     {
-        int index_x = 0;
-        for ( int start_x = 0;
-              start_x < xpm_width * xpm_cpp;
-              start_x += tile_width, ++index_x )
+        for ( int index_x = 0; index_x * TILE_SIZE < xpm_width; ++index_x )
         {
-            const int max_y = std::min( start_y + TILE_SIZE, xpm_height );
-            const int max_x = std::min( start_x + tile_width, xpm_width );
-
-            Index index( index_x, index_y );
-
-            Ptr tile( new XpmTile( ( max_x - start_x ) / xpm_cpp, // width
-                                   max_y - start_y, // height
-                                   xpm_cpp ) );
-
-            M_tiles.insert( std::pair< Index, Ptr >( index, tile ) );
-
-//             std::cout << "---- tile " << M_tiles.size()
-//                       << " (" << index_x << ' ' << index_y << ')'
-//                       << " size=" << max_x - start_x
-//                       << "x" << max_y - start_y
-//                       << " (start_x,start_y)=(" << start_x << ',' << start_y
-//                       << ")"
-//                       << std::endl;
-            for ( int y = start_y; y < max_y; ++y )
-            {
-                tile->addPixelLine( std::string( xpm_data[y],
-                                                 start_x,
-                                                 ( max_x - start_x ) ) );
-                //std::cout << '['
-                //          << std::string( xpm_data[y], start_x, ( max_x - start_x ) )
-                //          << "] : " << y
-                //          << std::endl;
-            }
+            const Index index( index_x, index_y );
+            M_tiles[index] = Tile();
+            M_updated_tiles.push_back( index );
         }
     }
 
-    //
-    // set shared color data strings
-    //
-    const Map::iterator tile_end = M_tiles.end();
-    const std::vector< boost::shared_ptr< std::string > >::iterator color_end = M_colors.end();
-
-    for ( std::vector< boost::shared_ptr< std::string > >::iterator color = M_colors.begin();
-          color != color_end;
-          ++color )
-    {
-        for ( Map::iterator tile = M_tiles.begin();
-              tile != tile_end;
-              ++tile )
-        {
-            const std::vector< std::string >::const_iterator line_end = tile->second->pixelLines().end();
-            for ( std::vector< std::string >::const_iterator line = tile->second->pixelLines().begin();
-                  line != line_end;
-                  ++line )
-            {
-                if ( line->find( (**color)[0] ) != std::string::npos )
-                {
-                    tile->second->addColor( *color );
-                    break;
-                }
-            }
-        }
-    }
+    M_width = xpm_width;
+    M_height = xpm_height;
 
     return true;
 }
@@ -321,6 +265,31 @@ TeamGraphic::parse( const char * server_msg )
         return false;
     }
 
+    const Index index( x, y );
+
+    //
+    // validate the existing tile
+    //
+    const quint64 hash = hash_string( server_msg );
+    {
+        TileMap::iterator it = M_tiles.find( index );
+        if ( it != M_tiles.end() )
+        {
+            if ( it->second.hash_ == hash )
+            {
+                // same tile. no need to decode again.
+                it->second.cached_ = false;
+                return true;
+            }
+
+            if ( it->second.cached_ )
+            {
+                // the team graphic has been changed since it was cached.
+                discardCachedTiles();
+            }
+        }
+    }
+
     //
     // header
     //
@@ -342,14 +311,13 @@ TeamGraphic::parse( const char * server_msg )
     }
     server_msg += n_read;
 
-    Index index( x, y );
-
-    Ptr tile( new XpmTile( xpm_width, xpm_height, xpm_cpp ) );
-
-
     char line_buf[8192];
 
     // colors
+    QRgb colors[256];
+    bool defined[256];
+    std::fill( defined, defined + 256, false );
+
     for ( int i = 0; i < xpm_n_color; ++i )
     {
         if ( std::sscanf( server_msg, " \"%8191[^\"]\" %n ",
@@ -359,20 +327,21 @@ TeamGraphic::parse( const char * server_msg )
         }
         server_msg += n_read;
 
-        boost::shared_ptr< std::string > new_col( new std::string( line_buf ) );
-        boost::shared_ptr< std::string > col = findColor( *new_col );
-        if ( col )
+        QRgb rgb = TRANSPARENT_RGB;
+        if ( ! parseColor( line_buf, rgb ) )
         {
-            tile->addColor( col );
-        }
-        else
-        {
-            M_colors.push_back( new_col );
-            tile->addColor( new_col );
+            return false;
         }
+
+        const unsigned char symbol = static_cast< unsigned char >( line_buf[0] );
+        colors[symbol] = rgb;
+        defined[symbol] = true;
     }
 
     // pixels
+    char pixels[TILE_SIZE][TILE_SIZE + 1];
+    const char * pixel_lines[TILE_SIZE];
+
     for ( int i = 0; i < xpm_height; ++i )
     {
         if ( std::sscanf( server_msg, " \"%8191[^\"]\" %n ",
@@ -387,11 +356,18 @@ TeamGraphic::parse( const char * server_msg )
             return false;
         }
 
-        tile->addPixelLine( line_buf );
+        std::memcpy( pixels[i], line_buf, xpm_width + 1 );
+        pixel_lines[i] = pixels[i];
     }
 
-    // insert new tile
-    M_tiles.insert( std::pair< Index, Ptr >( index, tile ) );
+    // decode the tile into the image
+    decodePixels( x * TILE_SIZE, y * TILE_SIZE, xpm_width,
+                  pixel_lines, xpm_height,
+                  colors, defined );
+
+    M_tiles[index] = Tile( hash, false );
+    M_updated_tiles.push_back( index );
+    M_modified = true;
 
     if ( M_width < ( x + 1 ) * TILE_SIZE )
     {
@@ -410,41 +386,371 @@ TeamGraphic::parse( const char * server_msg )
 /*!
 
 */
-boost::shared_ptr< std::string >
-TeamGraphic::findColor( const std::string & str )
+bool
+TeamGraphic::parseColor( const char * line,
+                         QRgb & rgb )
 {
-    const std::vector< boost::shared_ptr< std::string > >::iterator color_end = M_colors.end();
-    for ( std::vector< boost::shared_ptr< std::string > >::iterator color = M_colors.begin();
-          color != color_end;
-          ++color )
+    if ( ! line || *line == '\0' )
+    {
+        return false;
+    }
+
+    // the first character is the symbol, and the key-value pairs follow.
+    // the color of the key 'c' is used. if not found, the last one is used.
+    const char * msg = line + 1;
+    char key[16];
+    char value[64];
+    std::string color;
+    int n_read = 0;
+
+    while ( std::sscanf( msg, " %15s %63s %n", key, value, &n_read ) == 2 )
     {
-        if ( **color == str )
+        msg += n_read;
+
+        color = value;
+        if ( ! std::strcmp( key, "c" ) )
         {
-            return *color;
+            break;
         }
     }
 
-    return boost::shared_ptr< std::string >();
+    if ( color.empty() )
+    {
+        return false;
+    }
+
+    if ( ! qstricmp( color.c_str(), "None" ) )
+    {
+        rgb = TRANSPARENT_RGB;
+        return true;
+    }
+
+    QColor col( QString::fromAscii( color.c_str() ) );
+    if ( ! col.isValid() )
+    {
+        return false;
+    }
+
+    rgb = col.rgb();
+    return true;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
 */
-std::ostream &
-TeamGraphic::print( std::ostream & os ) const
+int
+TeamGraphic::paletteIndex( const QRgb rgb )
 {
-    const Map::const_iterator end = tiles().end();
-    for ( Map::const_iterator tile = tiles().begin();
-          tile != end;
-          ++tile )
+    QHash< QRgb, int >::const_iterator it = M_palette_index.find( rgb );
+    if ( it != M_palette_index.end() )
+    {
+        return it.value();
+    }
+
+    if ( M_image.format() != QImage::Format_Indexed8
+         || M_palette_index.size() >= MAX_COLOR )
     {
-        //os << "colors = " << tile->second->colors().size() << "\n";
-        os << '(' << tile->first.first
-           << ' ' << tile->first.second << ' ';
-        tile->second->print( os );
-        os << ")\n";
+        return -1;
     }
 
-    return os;
+    const int index = M_palette_index.size();
+
+    QVector< QRgb > table = M_image.colorTable();
+    table.push_back( rgb );
+    M_image.setColorTable( table );
+
+    M_palette_index.insert( rgb, index );
+    return index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TeamGraphic::decodePixels( const int x,
+                           const int y,
+                           const int width,
+                           const char * const * pixel_lines,
+                           const int n_lines,
+                           const QRgb * colors,
+                           const bool * defined )
+{
+    if ( M_image.format() == QImage::Format_Indexed8 )
+    {
+        // resolve the palette index of the used colors only once.
+        unsigned char index[256];
+        bool palette_full = false;
+
+        for ( int c = 0; c < 256; ++c )
+        {
+            index[c] = 0;
+            if ( ! defined[c] )
+            {
+                continue;
+            }
+
+            const int i = paletteIndex( colors[c] );
+            if ( i < 0 )
+            {
+                palette_full = true;
+                break;
+            }
+            index[c] = static_cast< unsigned char >( i );
+        }
+
+        if ( ! palette_full )
+        {
+            for ( int row = 0; row < n_lines; ++row )
+            {
+                const unsigned char * src = reinterpret_cast< const unsigned char * >( pixel_lines[row] );
+                uchar * dst = M_image.scanLine( y + row ) + x;
+                for ( int col = 0; col < width; ++col )
+                {
+                    dst[col] = index[src[col]];
+                }
+            }
+            return;
+        }
+
+        // too many colors for the palette
+        M_image = M_image.convertToFormat( QImage::Format_ARGB32 );
+    }
+
+    for ( int row = 0; row < n_lines; ++row )
+    {
+        const unsigned char * src = reinterpret_cast< const unsigned char * >( pixel_lines[row] );
+        QRgb * dst = reinterpret_cast< QRgb * >( M_image.scanLine( y + row ) ) + x;
+        for ( int col = 0; col < width; ++col )
+        {
+            dst[col] = ( defined[src[col]]
+                         ? colors[src[col]]
+                         : TRANSPARENT_RGB );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  erase the cached tiles that have not been validated yet.
+*/
+void
+TeamGraphic::discardCachedTiles()
+{
+    M_width = 0;
+    M_height = 0;
+
+    TileMap::iterator it = M_tiles.begin();
+    while ( it != M_tiles.end() )
+    {
+        const int x = it->first.first * TILE_SIZE;
+        const int y = it->first.second * TILE_SIZE;
+
+        if ( ! it->second.cached_ )
+        {
+            M_width = std::max( M_width, x + TILE_SIZE );
+            M_height = std::max( M_height, y + TILE_SIZE );
+            ++it;
+            continue;
+        }
+
+        for ( int row = y; row < y + TILE_SIZE; ++row )
+        {
+            if ( M_image.format() == QImage::Format_Indexed8 )
+            {
+                std::fill( M_image.scanLine( row ) + x,
+                           M_image.scanLine( row ) + x + TILE_SIZE,
+                           0 );
+            }
+            else
+            {
+                QRgb * line = reinterpret_cast< QRgb * >( M_image.scanLine( row ) );
+                std::fill( line + x, line + x + TILE_SIZE, TRANSPARENT_RGB );
+            }
+        }
+
+        M_tiles.erase( it++ );
+    }
+
+    // the whole image has to be copied again
+    ++M_generation;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the file name consists of the printable part of the team name and the
+  hash value of the whole team name.
+*/
+QString
+TeamGraphic::cacheFilePath( const QString & dir_path,
+                            const std::string & team_name )
+{
+    QString name;
+    for ( std::string::const_iterator c = team_name.begin();
+          c != team_name.end();
+          ++c )
+    {
+        name += ( std::isalnum( static_cast< unsigned char >( *c ) )
+                  || *c == '-'
+                  || *c == '_'
+                  ? QChar( *c )
+                  : QChar( '_' ) );
+    }
+
+    name += QString( "-%1" ).arg( hash_string( team_name.c_str() ), 16, 16, QChar( '0' ) );
+
+    return dir_path + QDir::separator() + name;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+TeamGraphic::load( const QString & dir_path,
+                   const std::string & team_name )
+{
+    const QString path = cacheFilePath( dir_path, team_name );
+
+    QFile tile_file( path + ".tiles" );
+    if ( ! tile_file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        return false;
+    }
+
+    QImage image( path + ".png" );
+    if ( image.isNull()
+         || image.width() != MAX_WIDTH
+         || image.height() != MAX_HEIGHT )
+    {
+        std::cerr << "Illegal team graphic cache [" << path.toStdString() << ".png]"
+                  << std::endl;
+        return false;
+    }
+
+    // the palette index 0 must be the transparent color.
+    if ( image.format() != QImage::Format_Indexed8
+         || image.colorTable().isEmpty()
+         || image.colorTable().front() != TRANSPARENT_RGB )
+    {
+        image = image.convertToFormat( QImage::Format_ARGB32 );
+    }
+
+    TileMap tiles;
+    int width = 0;
+    int height = 0;
+
+    QTextStream in( &tile_file );
+    while ( ! in.atEnd() )
+    {
+        const QString line = in.readLine().trimmed();
+        if ( line.isEmpty() )
+        {
+            continue;
+        }
+
+        const QStringList values = line.split( ' ', QString::SkipEmptyParts );
+        bool ok[3] = { false, false, false };
+        if ( values.size() != 3 )
+        {
+            return false;
+        }
+
+        const int x = values[0].toInt( &ok[0] );
+        const int y = values[1].toInt( &ok[1] );
+        const quint64 hash = values[2].toULongLong( &ok[2], 16 );
+
+        if ( ! ok[0] || ! ok[1] || ! ok[2]
+             || x < 0 || ( x + 1 ) * TILE_SIZE > MAX_WIDTH
+             || y < 0 || ( y + 1 ) * TILE_SIZE > MAX_HEIGHT )
+        {
+            std::cerr << "Illegal team graphic cache [" << path.toStdString() << ".tiles]"
+                      << std::endl;
+            return false;
+        }
+
+        tiles[Index( x, y )] = Tile( hash, true );
+        width = std::max( width, ( x + 1 ) * TILE_SIZE );
+        height = std::max( height, ( y + 1 ) * TILE_SIZE );
+    }
+
+    if ( tiles.empty() )
+    {
+        return false;
+    }
+
+    clear();
+
+    M_image = image;
+    M_palette_index.clear();
+    if ( M_image.format() == QImage::Format_Indexed8 )
+    {
+        const QVector< QRgb > table = M_image.colorTable();
+        for ( int i = table.size() - 1; i >= 0; --i )
+        {
+            M_palette_index.insert( table[i], i );
+        }
+    }
+
+    M_tiles = tiles;
+    for ( TileMap::const_iterator it = M_tiles.begin(); it != M_tiles.end(); ++it )
+    {
+        M_updated_tiles.push_back( it->first );
+    }
+
+    M_width = width;
+    M_height = height;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+TeamGraphic::save( const QString & dir_path,
+                   const std::string & team_name ) const
+{
+    if ( ! M_modified
+         || M_tiles.empty()
+         || team_name.empty() )
+    {
+        return false;
+    }
+
+    if ( ! QDir().mkpath( dir_path ) )
+    {
+        std::cerr << "Failed to create the team graphic cache directory ["
+                  << dir_path.toStdString() << "]"
+                  << std::endl;
+        return false;
+    }
+
+    const QString path = cacheFilePath( dir_path, team_name );
+
+    if ( ! M_image.save( path + ".png", "PNG" ) )
+    {
+        std::cerr << "Failed to save the team graphic cache [" << path.toStdString() << ".png]"
+                  << std::endl;
+        return false;
+    }
+
+    QFile tile_file( path + ".tiles" );
+    if ( ! tile_file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+    {
+        std::cerr << "Failed to save the team graphic cache [" << path.toStdString() << ".tiles]"
+                  << std::endl;
+        return false;
+    }
+
+    QTextStream out( &tile_file );
+    for ( TileMap::const_iterator it = M_tiles.begin(); it != M_tiles.end(); ++it )
+    {
+        out << it->first.first << ' ' << it->first.second << ' '
+            << QString::number( it->second.hash_, 16 ) << '\n';
+    }
+
+    return true;
 }
@@ -33,7 +33,9 @@
 #ifndef RCSSMONITOR_TEAM_GRAPHIC_H
 #define RCSSMONITOR_TEAM_GRAPHIC_H
 
-#include <boost/shared_ptr.hpp>
+#include <QImage>
+#include <QHash>
+#include <QString>
 
 #include <vector>
 #include <map>
@@ -42,6 +44,19 @@
 /*!
   \class TeamGraphic
   \brief team graphic data management class
+
+  The xpm tiles are decoded directly into one palette indexed image.
+  The palette index of each color is found by the hash table, and the
+  image is converted to the 32 bit format only if the total number of
+  colors exceeds the palette size. The indices of the decoded tiles are
+  recorded in the received order, so the painter can upload only the
+  changed tile rectangles.
+
+  The assembled image can be saved to and loaded from the cache
+  directory. The cache files are named by the team name, and each tile
+  in the cache has the hash value of its xpm data. The loaded tiles are
+  validated against the incoming tiles: the same tile is not decoded
+  again, and the cached tiles are discarded if a different tile arrives.
  */
 class TeamGraphic {
 public:
@@ -55,125 +70,50 @@ public:
     //! max colors
     static const int MAX_COLOR;
 
+    typedef std::pair< int, int > Index; //!<  xpm tile index
 
     /*!
-      \class XpmTile
-      \brief 8x8 pixels xpm data contained by the TeamGraphic
-    */
-    class XpmTile {
-    private:
-        const int M_width; //!< width of this tile
-        const int M_height; //!< height of this tile
-        const int M_cpp; //!< character per pixel of this tile
-
-        //! shared color strings
-        std::vector< boost::shared_ptr< std::string > > M_colors;
-        //! pixel lines
-        std::vector< std::string > M_pixel_lines;
-
-        // not used
-        XpmTile();
-    public:
-
-        /*!
-          \brief initialize xpm header information
-          \param width xpm width
-          \param height xpm height
-          \param n_color number of
-          \param cpp characters per pixel
-        */
-        XpmTile( const int width,
-                 const int height,
-                 const int cpp );
-
-        /*!
-          \brief get the xpm width
-          \return pixel width value
-        */
-        int width() const
-          {
-              return M_width;
-          }
-
-        /*!
-          \brief get the xpm height
-          \return pixel height value
-        */
-        int height() const
-          {
-              return M_width;
-          }
-
-        /*!
-          \brief get the value of characters per pixel.
-          \return the value of characters per pixel.
-        */
-        int cpp() const
-          {
-              return M_cpp;
-          }
-
-        /*!
-          \brief get used color strings
-          \return color string container
-        */
-        const
-        std::vector< boost::shared_ptr< std::string > > & colors() const
-          {
-              return M_colors;
-          }
-
-        /*!
-          \brief get pixel lines
-          \return pixel line container
-        */
-        const
-        std::vector< std::string > & pixelLines() const
-          {
-              return M_pixel_lines;
-          }
-
-        /*!
-          \brief add xpm color data string
-          \param line pointer to the color data string
-        */
-        void addColor( boost::shared_ptr< std::string > color )
-          {
-              M_colors.push_back( color );
-          }
-
-        /*!
-          \brief add pixel line data
-          \param line pixel line string
-        */
-        void addPixelLine( const std::string & line )
-          {
-              M_pixel_lines.push_back( line );
-          }
-
-        /*!
-          \brief output xpm lines
-          \param os refrence to the output stream
-          \return refrence to the output stream
-        */
-        std::ostream & print( std::ostream & os ) const;
+      \struct Tile
+      \brief state of the received or cached tile
+     */
+    struct Tile {
+        quint64 hash_; //!< hash value of the xpm data
+        bool cached_; //!< true if loaded from the cache and not yet validated
+
+        Tile()
+            : hash_( 0 ),
+              cached_( false )
+          { }
+        Tile( const quint64 hash,
+              const bool cached )
+            : hash_( hash ),
+              cached_( cached )
+          { }
     };
 
-
-    typedef boost::shared_ptr< XpmTile > Ptr; //!< XpmTile pointer
-    typedef std::pair< int, int > Index; //!<  xpm tile index
-    typedef std::map< Index, Ptr > Map; //!< xpm tile map
+    typedef std::map< Index, Tile > TileMap; //!< tile state map
 
 private:
     int M_width; //!< total pixmap width
     int M_height; //!< total pixmap height
-    int M_cpp; //!< char per pixel
 
-    //! color data strings
-    std::vector< boost::shared_ptr< std::string > > M_colors;
+    //! incremented when all data are replaced
+    int M_generation;
+
+    //! decoded image. the size is always MAX_WIDTH x MAX_HEIGHT.
+    QImage M_image;
+
+    //! hashed color table. key: color value, value: palette index
+    QHash< QRgb, int > M_palette_index;
+
+    //! state of the received or cached tiles
+    TileMap M_tiles;
+
+    //! true if any tile has been decoded after the cache was loaded
+    bool M_modified;
 
-    //! 8x8 xpm tiles
-    Map M_tiles;
+    //! indices of the decoded tiles in the received order
+    std::vector< Index > M_updated_tiles;
 
 public:
 
@@ -206,25 +146,45 @@ public:
       }
 
     /*!
-      \brief get the xpm color data strings
-      \return color strings container
+      \brief get the generation number, which is changed when all data are replaced.
+      \return generation number
+     */
+    int generation() const
+      {
+          return M_generation;
+      }
+
+    /*!
+      \brief get the decoded image. only the area of width() x height() is valid.
+      \return const reference to the image
      */
     const
-    std::vector< boost::shared_ptr< std::string > > & colors() const
+    QImage & image() const
       {
-          return M_colors;
+          return M_image;
       }
 
     /*!
-      \brief get the tiled xpm data
-      \return tiled xpm data map container
+      \brief get the state of the received or cached tiles
+      \return tile state container
      */
     const
-    Map & tiles() const
+    TileMap & tiles() const
       {
           return M_tiles;
       }
 
+    /*!
+      \brief get the indices of the decoded tiles in the received order.
+      the same index may appear more than once.
+      \return tile index container
+     */
+    const
+    std::vector< Index > & updatedTiles() const
+      {
+          return M_updated_tiles;
+      }
+
     /*!
       \brief create tiled xpm from the raw xpm data
       \param xpm_data raw xpm string array
@@ -239,23 +199,69 @@ public:
      */
     bool parse( const char * server_msg );
 
+    /*!
+      \brief load the cached team graphic. all current data are replaced.
+      \param dir_path cache directory path
+      \param team_name team name string
+      \return true if successfully loaded
+     */
+    bool load( const QString & dir_path,
+               const std::string & team_name );
+
+    /*!
+      \brief save the team graphic if any tile has been received after loaded.
+      \param dir_path cache directory path
+      \param team_name team name string
+      \return true if successfully saved
+     */
+    bool save( const QString & dir_path,
+               const std::string & team_name ) const;
+
 private:
 
+    static
+    QString cacheFilePath( const QString & dir_path,
+                           const std::string & team_name );
+
+    void discardCachedTiles();
+
+    void initImage();
+
     /*!
-      \brief find string from the color string pool
-      \param str searched string
-      \return string pointer. if not found null pointer is returned.
+      \brief analyze the xpm color line.
+      \param line color line string. the first character is the color symbol.
+      \param rgb reference to the result variable
+      \return true if successfully analyzed
      */
-    boost::shared_ptr< std::string > findColor( const std::string & str );
+    static
+    bool parseColor( const char * line,
+                     QRgb & rgb );
 
-public:
+    /*!
+      \brief get the palette index of the color. new color is added to the palette.
+      \param rgb color value
+      \return palette index, or -1 if the palette is full.
+     */
+    int paletteIndex( const QRgb rgb );
 
     /*!
-      \brief output all tiled xpm data
-      \param os reference to the output stream
-      \return reference to the output stream
+      \brief decode pixel characters into the image.
+      \param x left pixel coordinate in the image
+      \param y top pixel coordinate in the image
+      \param width the number of the pixel characters in each line
+      \param pixel_lines pixel line strings
+      \param n_lines the number of pixel lines
+      \param colors color value of each symbol character
+      \param defined true if the symbol is defined
      */
-    std::ostream & print( std::ostream & os ) const;
+    void decodePixels( const int x,
+                       const int y,
+                       const int width,
+                       const char * const * pixel_lines,
+                       const int n_lines,
+                       const QRgb * colors,
+                       const bool * defined );
+
 };
 
 #endif
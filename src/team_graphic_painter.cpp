@@ -39,10 +39,7 @@
 #include "team_graphic_painter.h"
 
 #include "disp_holder.h"
-#include "options.h"
-
-#include <iostream>
-#include <cstring>
+#include "render_settings.h"
 
 
 /*-------------------------------------------------------------------*/
@@ -50,7 +47,11 @@
 
 */
 TeamGraphicPainter::TeamGraphicPainter( const DispHolder & disp_holder )
-    : M_disp_holder( disp_holder )
+    : M_disp_holder( disp_holder ),
+      M_team_graphic_left_generation( -1 ),
+      M_team_graphic_left_updated( 0 ),
+      M_team_graphic_right_generation( -1 ),
+      M_team_graphic_right_updated( 0 )
 {
 
 }
@@ -60,65 +61,21 @@ TeamGraphicPainter::TeamGraphicPainter( const DispHolder & disp_holder )
 
 */
 void
-TeamGraphicPainter::draw( QPainter & painter )
+TeamGraphicPainter::prepare( const RenderSettings & settings )
 {
-    const Options & opt = Options::instance();
-
-    if ( ! opt.showTeamGraphic() )
+    if ( ! settings.showTeamGraphic() )
     {
         return;
     }
 
-    // update left team pixmap
-    if ( M_team_graphic_left_set.size() != M_disp_holder.teamGraphicLeft().tiles().size() )
-    {
-        if ( M_disp_holder.teamGraphicLeft().tiles().empty() )
-        {
-            M_team_graphic_left_set.clear();
-            M_team_graphic_pixmap_left = QPixmap();
-        }
-        else
-        {
-            copyTeamGraphic( M_team_graphic_pixmap_left,
-                             M_team_graphic_left_set,
-                             M_disp_holder.teamGraphicLeft() );
-        }
-    }
-
-    // update right team pixmap
-    if ( M_team_graphic_right_set.size() != M_disp_holder.teamGraphicRight().tiles().size() )
-    {
-        if ( M_disp_holder.teamGraphicRight().tiles().empty() )
-        {
-            M_team_graphic_right_set.clear();
-            M_team_graphic_pixmap_right = QPixmap();
-        }
-        else
-        {
-            copyTeamGraphic( M_team_graphic_pixmap_right,
-                             M_team_graphic_right_set,
-                             M_disp_holder.teamGraphicRight() );
-        }
-    }
-
-    if ( ! M_team_graphic_pixmap_left.isNull() )
-    {
-        int x = 0;
-        int y = 0;
-        //int x = ( 256 - M_team_graphic_pixmap_left.width() ) / 2;
-        //int y = ( 64 -  M_team_graphic_pixmap_left.height() ) / 2;
-        painter.drawPixmap( x, y, M_team_graphic_pixmap_left );
-    }
-
-    if ( ! M_team_graphic_pixmap_right.isNull() )
-    {
-        int x = painter.window().width() - M_team_graphic_pixmap_right.width() - 1;
-        int y = 0;
-        //int x = painter.window().width() - 256
-        //    + ( 256 - M_team_graphic_pixmap_right.width() ) / 2;
-        //int y = ( 64 -  M_team_graphic_pixmap_right.height() ) / 2;
-        painter.drawPixmap( x, y, M_team_graphic_pixmap_right );
-    }
+    copyTeamGraphic( M_team_graphic_image_left,
+                     M_team_graphic_left_generation,
+                     M_team_graphic_left_updated,
+                     M_disp_holder.teamGraphicLeft() );
+    copyTeamGraphic( M_team_graphic_image_right,
+                     M_team_graphic_right_generation,
+                     M_team_graphic_right_updated,
+                     M_disp_holder.teamGraphicRight() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -126,111 +83,101 @@ TeamGraphicPainter::draw( QPainter & painter )
 
 */
 void
-TeamGraphicPainter::copyTeamGraphic( QPixmap & dst_pixmap,
-                                     std::set< TeamGraphic::Index > & index_set,
-                                     const TeamGraphic & team_graphic )
+TeamGraphicPainter::draw( QPainter & painter,
+                          const RenderSettings & settings )
 {
-    if ( dst_pixmap.width() != team_graphic.width()
-         || dst_pixmap.height() != team_graphic.height() )
+    if ( ! settings.showTeamGraphic() )
     {
-        dst_pixmap = QPixmap( team_graphic.width(),
-                              team_graphic.height() );
-        dst_pixmap.fill( Qt::transparent );
+        return;
     }
 
-    const TeamGraphic::Map::const_reverse_iterator end = team_graphic.tiles().rend();
-    for ( TeamGraphic::Map::const_reverse_iterator tile = team_graphic.tiles().rbegin();
-          tile != end;
-          ++tile )
+    if ( ! M_team_graphic_image_left.isNull() )
     {
-        index_set.insert( tile->first );
+        int x = 0;
+        int y = 0;
+        //int x = ( 256 - M_team_graphic_image_left.width() ) / 2;
+        //int y = ( 64 -  M_team_graphic_image_left.height() ) / 2;
+        painter.drawImage( x, y, M_team_graphic_image_left );
+    }
 
-        copyTeamGraphicXpmTile( dst_pixmap,
-                                tile->first,
-                                *(tile->second) );
+    if ( ! M_team_graphic_image_right.isNull() )
+    {
+        int x = painter.window().width() - M_team_graphic_image_right.width() - 1;
+        int y = 0;
+        //int x = painter.window().width() - 256
+        //    + ( 256 - M_team_graphic_image_right.width() ) / 2;
+        //int y = ( 64 -  M_team_graphic_image_right.height() ) / 2;
+        painter.drawImage( x, y, M_team_graphic_image_right );
     }
 }
 
 /*-------------------------------------------------------------------*/
 /*!
-
+  copy the decoded image to the destination image. only the tiles updated
+  after the last copy are copied, unless the size or the generation is
+  changed.
 */
 void
-TeamGraphicPainter::copyTeamGraphicXpmTile( QPixmap & dst_pixmap,
-                                            const TeamGraphic::Index & index,
-                                            const TeamGraphic::XpmTile & tile )
+TeamGraphicPainter::copyTeamGraphic( QImage & dst_image,
+                                     int & generation,
+                                     std::size_t & updated,
+                                     const TeamGraphic & team_graphic )
 {
-    const int array_size = 1 + tile.colors().size() + tile.height();
-
-    char ** xpm;
-    xpm = new char*[ array_size ];
-
-    // header
-    xpm[0] = new char[64];
-    snprintf( xpm[0], 64, "%d %d %d %d",
-              tile.width(), tile.height(),
-              static_cast< int >( tile.colors().size() ), tile.cpp() );
-
-    // colors
-    std::size_t idx = 1;
-    for ( std::vector< boost::shared_ptr< std::string > >::const_iterator col = tile.colors().begin();
-          col != tile.colors().end();
-          ++col )
-    {
-        xpm[idx] = new char[ (*col)->length() + 1 ];
-        std::strcpy( xpm[idx], (*col)->c_str() );
-        ++idx;
-    }
+    const std::vector< TeamGraphic::Index > & tiles = team_graphic.updatedTiles();
 
-    // pixels
-    for ( std::vector< std::string >::const_iterator line = tile.pixelLines().begin();
-          line != tile.pixelLines().end();
-          ++line )
+    if ( tiles.empty() )
     {
-        xpm[idx] = new char[ tile.width() + 1 ];
-        std::strcpy( xpm[idx], line->c_str() );
-        ++idx;
+        if ( ! dst_image.isNull() )
+        {
+            dst_image = QImage();
+        }
+        generation = team_graphic.generation();
+        updated = 0;
+        return;
     }
 
-    copyTeamGraphicXpmTile( dst_pixmap, index.first, index.second, xpm );
-
-    // release memories
-    for ( int i = 0; i < array_size; ++i )
+    if ( generation == team_graphic.generation()
+         && updated == tiles.size() )
     {
-        delete [] xpm[i];
+        // no change
+        return;
     }
-    delete [] xpm;
-}
-
-/*-------------------------------------------------------------------*/
-/*!
 
-*/
-void
-TeamGraphicPainter::copyTeamGraphicXpmTile( QPixmap & dst_pixmap,
-                                            const int x,
-                                            const int y,
-                                            const char * const * xpm )
-{
-    if ( dst_pixmap.width() < (x+1) * TeamGraphic::TILE_SIZE
-         || dst_pixmap.height() < (y+1) * TeamGraphic::TILE_SIZE )
+    if ( generation != team_graphic.generation()
+         || tiles.size() < updated
+         || dst_image.width() != team_graphic.width()
+         || dst_image.height() != team_graphic.height() )
     {
+        // rebuild the whole image
+        dst_image = QImage( team_graphic.width(),
+                            team_graphic.height(),
+                            QImage::Format_ARGB32_Premultiplied );
+        dst_image.fill( 0 );
+
+        QPainter painter( &dst_image );
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+        painter.drawImage( 0, 0, team_graphic.image(),
+                           0, 0, team_graphic.width(), team_graphic.height() );
+        painter.end();
+
+        generation = team_graphic.generation();
+        updated = tiles.size();
         return;
     }
 
-    QPixmap pixmap( xpm );
+    QPainter painter( &dst_image );
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
 
-    if ( pixmap.isNull()
-         || pixmap.width() != TeamGraphic::TILE_SIZE
-         || pixmap.height() != TeamGraphic::TILE_SIZE )
+    for ( std::size_t i = updated; i < tiles.size(); ++i )
     {
-        std::cerr << "Failed to create a pixmap from the xpm tile ("
-                  << x << ',' << y << ')'
-                  << std::endl;
-        return;
+        const int x = tiles[i].first * TeamGraphic::TILE_SIZE;
+        const int y = tiles[i].second * TeamGraphic::TILE_SIZE;
+
+        painter.drawImage( x, y, team_graphic.image(),
+                           x, y, TeamGraphic::TILE_SIZE, TeamGraphic::TILE_SIZE );
     }
 
-    QPainter painter( &dst_pixmap );
-    painter.drawPixmap( x * 8, y * 8, pixmap );
     painter.end();
+
+    updated = tiles.size();
 }
@@ -37,9 +37,9 @@
 
 #include "team_graphic.h"
 
-#include <QPixmap>
+#include <QImage>
 
-#include <set>
+#include <cstddef>
 
 class DispHolder;
 
@@ -48,11 +48,17 @@ class TeamGraphicPainter
 private:
     const DispHolder & M_disp_holder;
 
-    std::set< TeamGraphic::Index > M_team_graphic_left_set;
-    QPixmap M_team_graphic_pixmap_left;
+    //! generation of the left team graphic when the image was built
+    int M_team_graphic_left_generation;
+    //! the number of the left team tiles already copied to the image
+    std::size_t M_team_graphic_left_updated;
+    QImage M_team_graphic_image_left;
 
-    std::set< TeamGraphic::Index > M_team_graphic_right_set;
-    QPixmap M_team_graphic_pixmap_right;
+    //! generation of the right team graphic when the image was built
+    int M_team_graphic_right_generation;
+    //! the number of the right team tiles already copied to the image
+    std::size_t M_team_graphic_right_updated;
+    QImage M_team_graphic_image_right;
 
     // not used
     TeamGraphicPainter();
@@ -61,20 +67,17 @@ public:
     explicit
     TeamGraphicPainter( const DispHolder & disp_holder );
 
-    void draw( QPainter & painter );
+    void prepare( const RenderSettings & settings );
+
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
 
 private:
 
-    void copyTeamGraphic( QPixmap & dst_pixmap,
-                          std::set< TeamGraphic::Index > & index_set,
+    void copyTeamGraphic( QImage & dst_image,
+                          int & generation,
+                          std::size_t & updated,
                           const TeamGraphic & team_graphic );
-    void copyTeamGraphicXpmTile( QPixmap & dst_pixmap,
-                                 const TeamGraphic::Index & index,
-                                 const TeamGraphic::XpmTile & tile );
-    void copyTeamGraphicXpmTile( QPixmap & dst_pixmap,
-                                 const int x,
-                                 const int y,
-                                 const char * const * xpm );
 
 };
 
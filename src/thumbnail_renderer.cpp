@@ -0,0 +1,262 @@
+// -*-c++-*-
+
+/*!
+  \file thumbnail_renderer.cpp
+  \brief background thumbnail renderer class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "thumbnail_renderer.h"
+
+#include "options.h"
+
+#include <algorithm>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ThumbnailRenderer::ThumbnailRenderer( QObject * parent )
+    : QThread( parent ),
+      M_stop( false )
+{
+    M_colors.field_ = QColor( 31, 160, 31 );
+    M_colors.line_ = Qt::white;
+    M_colors.ball_ = Qt::white;
+    M_colors.left_team_ = Qt::yellow;
+    M_colors.right_team_ = Qt::cyan;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ThumbnailRenderer::~ThumbnailRenderer()
+{
+    stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::setColors( const Colors & colors )
+{
+    QMutexLocker lock( &M_mutex );
+    M_colors = colors;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::request( const int index,
+                            const DispConstPtr & disp,
+                            const QSize & size,
+                            const int generation )
+{
+    Request req;
+    req.index_ = index;
+    req.disp_ = disp;
+    req.size_ = size;
+    req.generation_ = generation;
+    req.preview_ = false;
+
+    QMutexLocker lock( &M_mutex );
+    M_requests.push_back( req );
+    M_wait_condition.wakeOne();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::requestPreview( const int index,
+                                   const DispConstPtr & disp,
+                                   const QSize & size,
+                                   const int generation )
+{
+    QMutexLocker lock( &M_mutex );
+    M_preview_request.index_ = index;
+    M_preview_request.disp_ = disp;
+    M_preview_request.size_ = size;
+    M_preview_request.generation_ = generation;
+    M_preview_request.preview_ = true;
+    M_wait_condition.wakeOne();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::clearRequests()
+{
+    QMutexLocker lock( &M_mutex );
+    M_requests.clear();
+    M_preview_request = Request();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::stop()
+{
+    {
+        QMutexLocker lock( &M_mutex );
+        M_stop = true;
+        M_requests.clear();
+        M_preview_request = Request();
+        M_wait_condition.wakeOne();
+    }
+
+    wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ThumbnailRenderer::run()
+{
+    while ( true )
+    {
+        Request req;
+        Colors colors;
+
+        {
+            QMutexLocker lock( &M_mutex );
+
+            while ( ! M_stop
+                    && M_requests.empty()
+                    && ! M_preview_request.disp_ )
+            {
+                M_wait_condition.wait( &M_mutex );
+            }
+
+            if ( M_stop )
+            {
+                return;
+            }
+
+            if ( M_preview_request.disp_ )
+            {
+                req = M_preview_request;
+                M_preview_request = Request();
+            }
+            else
+            {
+                req = M_requests.front();
+                M_requests.pop_front();
+            }
+
+            colors = M_colors;
+        }
+
+        // render without the lock. the display data is never modified after stored.
+        const QImage image = render( *req.disp_, req.size_, colors );
+
+        emit rendered( req.index_, image, req.generation_, req.preview_ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  simplified field painter. only the pitch outline, the center line, the
+  ball and the players are drawn.
+*/
+QImage
+ThumbnailRenderer::render( const rcss::rcg::DispInfoT & disp,
+                           const QSize & size,
+                           const Colors & colors )
+{
+    QImage image( size, QImage::Format_RGB32 );
+    image.fill( colors.field_.rgb() );
+
+    const double field_length = Options::PITCH_LENGTH + Options::PITCH_MARGIN * 2.0;
+    const double field_width = Options::PITCH_WIDTH + Options::PITCH_MARGIN * 2.0;
+    const double scale = std::min( size.width() / field_length,
+                                   size.height() / field_width );
+
+    QPainter painter( &image );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+    painter.translate( size.width() * 0.5, size.height() * 0.5 );
+    painter.scale( scale, scale );
+
+    // the pen width must not be scaled
+    QPen line_pen( colors.line_, 0 );
+    painter.setPen( line_pen );
+    painter.setBrush( Qt::NoBrush );
+    painter.drawRect( QRectF( -Options::PITCH_HALF_LENGTH,
+                              -Options::PITCH_HALF_WIDTH,
+                              Options::PITCH_LENGTH,
+                              Options::PITCH_WIDTH ) );
+    painter.drawLine( QLineF( 0.0, -Options::PITCH_HALF_WIDTH,
+                              0.0, Options::PITCH_HALF_WIDTH ) );
+
+    // players and ball are drawn at least one pixel radius
+    const double player_r = std::max( 1.0 / scale, 1.2 );
+    const double ball_r = std::max( 1.0 / scale, 0.8 );
+
+    painter.setPen( Qt::NoPen );
+
+    const rcss::rcg::ShowInfoT & show = disp.show_;
+    for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+    {
+        const rcss::rcg::PlayerT & p = show.player_[i];
+        if ( p.state_ == 0 )
+        {
+            continue;
+        }
+
+        painter.setBrush( i < rcss::rcg::MAX_PLAYER
+                          ? colors.left_team_
+                          : colors.right_team_ );
+        painter.drawEllipse( QRectF( p.x_ - player_r, p.y_ - player_r,
+                                     player_r * 2.0, player_r * 2.0 ) );
+    }
+
+    painter.setBrush( colors.ball_ );
+    painter.drawEllipse( QRectF( show.ball_.x_ - ball_r, show.ball_.y_ - ball_r,
+                                 ball_r * 2.0, ball_r * 2.0 ) );
+
+    painter.end();
+
+    return image;
+}
@@ -0,0 +1,160 @@
+// -*-c++-*-
+
+/*!
+  \file thumbnail_renderer.h
+  \brief background thumbnail renderer class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_THUMBNAIL_RENDERER_H
+#define RCSSMONITOR_THUMBNAIL_RENDERER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QColor>
+#include <QImage>
+#include <QSize>
+
+#include "disp_holder.h"
+
+#include <deque>
+
+/*!
+  \class ThumbnailRenderer
+  \brief worker thread that renders the mini field images of display data.
+
+  The requests hold their own reference to the immutable display data,
+  so the worker never touches DispHolder while the GUI thread appends
+  new frames or seeks. Only QImage and QPainter are used in the worker
+  thread. The rendered images are delivered by the queued signal.
+*/
+class ThumbnailRenderer
+    : public QThread {
+
+    Q_OBJECT
+
+public:
+
+    /*!
+      \struct Colors
+      \brief colors used by the simplified painter. copied from Options by the GUI thread.
+     */
+    struct Colors {
+        QColor field_;
+        QColor line_;
+        QColor ball_;
+        QColor left_team_;
+        QColor right_team_;
+    };
+
+private:
+
+    struct Request {
+        int index_; //!< buffered index of the display data
+        DispConstPtr disp_; //!< display data
+        QSize size_; //!< image size
+        int generation_; //!< generation number when requested
+        bool preview_; //!< true if the hover preview
+
+        Request()
+            : index_( -1 ),
+              generation_( 0 ),
+              preview_( false )
+          { }
+    };
+
+    QMutex M_mutex;
+    QWaitCondition M_wait_condition;
+
+    //! pending thumbnail requests. protected by M_mutex.
+    std::deque< Request > M_requests;
+    //! the latest preview request. only one preview is kept. protected by M_mutex.
+    Request M_preview_request;
+    //! colors of the simplified painter. protected by M_mutex.
+    Colors M_colors;
+    //! true if the thread should exit. protected by M_mutex.
+    bool M_stop;
+
+    // not used
+    ThumbnailRenderer();
+    ThumbnailRenderer( const ThumbnailRenderer & );
+    const ThumbnailRenderer & operator=( const ThumbnailRenderer & );
+
+public:
+
+    explicit
+    ThumbnailRenderer( QObject * parent );
+    ~ThumbnailRenderer();
+
+    void setColors( const Colors & colors );
+
+    /*!
+      \brief append the thumbnail request. never blocks except the queue lock.
+     */
+    void request( const int index,
+                  const DispConstPtr & disp,
+                  const QSize & size,
+                  const int generation );
+
+    /*!
+      \brief replace the preview request. the preview is rendered before the thumbnails.
+     */
+    void requestPreview( const int index,
+                         const DispConstPtr & disp,
+                         const QSize & size,
+                         const int generation );
+
+    /*!
+      \brief discard all pending requests.
+     */
+    void clearRequests();
+
+    /*!
+      \brief stop the thread and wait for its finish.
+     */
+    void stop();
+
+    static
+    QImage render( const rcss::rcg::DispInfoT & disp,
+                   const QSize & size,
+                   const Colors & colors );
+
+protected:
+
+    void run();
+
+signals:
+
+    void rendered( int index,
+                   const QImage & image,
+                   int generation,
+                   bool preview );
+
+};
+
+#endif
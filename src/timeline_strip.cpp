@@ -0,0 +1,476 @@
+// -*-c++-*-
+
+/*!
+  \file timeline_strip.cpp
+  \brief timeline thumbnail strip widget class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "timeline_strip.h"
+
+#include "options.h"
+
+#include <algorithm>
+
+namespace {
+//! pixel size of one thumbnail. the aspect ratio is the same as the field with margin.
+const int THUMBNAIL_WIDTH = 58;
+const int THUMBNAIL_HEIGHT = 40;
+//! pixel size of the hover preview
+const int PREVIEW_WIDTH = 232;
+const int PREVIEW_HEIGHT = 160;
+//! the minimum number of frames between the slots
+const int MIN_SLOT_INTERVAL = 50;
+//! the max number of the cached thumbnails
+const std::size_t CACHE_SIZE = 512;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TimelineStrip::TimelineStrip( const DispHolder & disp_holder,
+                              QWidget * parent )
+    : QWidget( parent ),
+      M_disp_holder( disp_holder ),
+      M_renderer( new ThumbnailRenderer( this ) ),
+      M_generation( 0 ),
+      M_buffer_revision( disp_holder.bufferRevision() ),
+      M_preview_label( new QLabel( this, Qt::ToolTip ) ),
+      M_hover_index( -1 )
+{
+    this->setMouseTracking( true );
+    this->setMinimumHeight( THUMBNAIL_HEIGHT );
+    this->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Fixed );
+
+    M_preview_label->hide();
+
+    connect( M_renderer, SIGNAL( rendered( int, const QImage &, int, bool ) ),
+             this, SLOT( receiveImage( int, const QImage &, int, bool ) ) );
+
+    checkColors();
+
+    M_renderer->start( QThread::LowPriority );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TimelineStrip::~TimelineStrip()
+{
+    M_renderer->stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QSize
+TimelineStrip::sizeHint() const
+{
+    return QSize( THUMBNAIL_WIDTH * 10, THUMBNAIL_HEIGHT );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::clearCache()
+{
+    ++M_generation;
+    M_renderer->clearRequests();
+
+    M_cache.clear();
+    M_lru.clear();
+    M_pending.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::checkReset()
+{
+    const DispCont & cont = M_disp_holder.dispCont();
+    const DispConstPtr first = ( cont.empty() ? DispConstPtr() : cont.front() );
+
+    if ( first != M_first_disp )
+    {
+        // the holder has been cleared or a new log has been opened.
+        M_first_disp = first;
+        M_buffer_revision = M_disp_holder.bufferRevision();
+        clearCache();
+        return;
+    }
+
+    if ( M_buffer_revision != M_disp_holder.bufferRevision() )
+    {
+        // the late show has shifted the buffered data.
+        const size_t shifted = M_disp_holder.firstShiftedIndex( M_buffer_revision );
+        M_buffer_revision = M_disp_holder.bufferRevision();
+        dropCache( static_cast< int >( std::min( shifted, cont.size() ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  drop the thumbnails from the given index, which show the frames before
+  the shift.
+*/
+void
+TimelineStrip::dropCache( const int first )
+{
+    if ( ! M_pending.empty()
+         && *M_pending.rbegin() >= first )
+    {
+        // the pending results would be stored at the shifted indices.
+        // the other pending indices are requested again by the next paint.
+        ++M_generation;
+        M_renderer->clearRequests();
+        M_pending.clear();
+    }
+
+    Cache::iterator it = M_cache.lower_bound( first );
+    while ( it != M_cache.end() )
+    {
+        M_lru.erase( it->second.lru_pos_ );
+        M_cache.erase( it++ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::checkColors()
+{
+    const Options & opt = Options::instance();
+
+    ThumbnailRenderer::Colors colors;
+    colors.field_ = opt.fieldBrush().color();
+    colors.line_ = opt.linePen().color();
+    colors.ball_ = opt.ballBrush().color();
+    colors.left_team_ = opt.leftTeamBrush().color();
+    colors.right_team_ = opt.rightTeamBrush().color();
+
+    if ( colors.field_ != M_colors.field_
+         || colors.line_ != M_colors.line_
+         || colors.ball_ != M_colors.ball_
+         || colors.left_team_ != M_colors.left_team_
+         || colors.right_team_ != M_colors.right_team_ )
+    {
+        M_colors = colors;
+        M_renderer->setColors( colors );
+        clearCache();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+TimelineStrip::slotCount() const
+{
+    return std::max( 1, this->width() / THUMBNAIL_WIDTH );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the interval is a power of two multiple of MIN_SLOT_INTERVAL, so the
+  slot indices of the longer interval are the subset of the shorter one.
+*/
+int
+TimelineStrip::slotInterval( const int slot_count ) const
+{
+    const int size = static_cast< int >( M_disp_holder.dispCont().size() );
+
+    int interval = MIN_SLOT_INTERVAL;
+    while ( slot_count * interval < size )
+    {
+        interval *= 2;
+    }
+
+    return interval;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+TimelineStrip::indexAt( const int x ) const
+{
+    const int size = static_cast< int >( M_disp_holder.dispCont().size() );
+    if ( size == 0 )
+    {
+        return -1;
+    }
+
+    const int interval = slotInterval( slotCount() );
+    const int index = static_cast< int >( static_cast< double >( std::max( 0, x ) )
+                                          * interval / THUMBNAIL_WIDTH );
+
+    return std::min( index, size - 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const QImage *
+TimelineStrip::findThumbnail( const int index )
+{
+    Cache::iterator it = M_cache.find( index );
+    if ( it == M_cache.end() )
+    {
+        return static_cast< const QImage * >( 0 );
+    }
+
+    // move to the front of the LRU list
+    M_lru.splice( M_lru.begin(), M_lru, it->second.lru_pos_ );
+    return &it->second.image_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::requestThumbnail( const int index )
+{
+    if ( ! M_pending.insert( index ).second )
+    {
+        // already requested
+        return;
+    }
+
+    M_renderer->request( index,
+                         M_disp_holder.dispCont()[index],
+                         QSize( THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT ),
+                         M_generation );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::updatePreview( const QPoint & global_pos )
+{
+    if ( M_hover_index < 0 )
+    {
+        M_preview_label->hide();
+        return;
+    }
+
+    M_renderer->requestPreview( M_hover_index,
+                                M_disp_holder.dispCont()[M_hover_index],
+                                QSize( PREVIEW_WIDTH, PREVIEW_HEIGHT ),
+                                M_generation );
+
+    // show the preview above the strip
+    const QPoint top = this->mapToGlobal( QPoint( 0, 0 ) );
+    M_preview_label->move( global_pos.x() - PREVIEW_WIDTH / 2,
+                           top.y() - PREVIEW_HEIGHT - 4 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::paintEvent( QPaintEvent * )
+{
+    checkColors();
+    checkReset();
+
+    QPainter painter( this );
+    painter.fillRect( this->rect(), Qt::black );
+
+    const DispCont & cont = M_disp_holder.dispCont();
+    if ( cont.empty() )
+    {
+        return;
+    }
+
+    const int slot_count = slotCount();
+    const int interval = slotInterval( slot_count );
+    const int size = static_cast< int >( cont.size() );
+
+    for ( int i = 0; i < slot_count; ++i )
+    {
+        const int index = i * interval;
+        if ( size <= index )
+        {
+            break;
+        }
+
+        const int x = i * THUMBNAIL_WIDTH;
+        const QImage * image = findThumbnail( index );
+        if ( image )
+        {
+            painter.drawImage( x, 0, *image );
+        }
+        else
+        {
+            // the thumbnail is drawn when the renderer delivers it.
+            requestThumbnail( index );
+            painter.fillRect( x + 1, 1, THUMBNAIL_WIDTH - 2, THUMBNAIL_HEIGHT - 2,
+                              M_colors.field_.darker() );
+        }
+    }
+
+    const std::size_t current = M_disp_holder.currentIndex();
+    if ( current != DispHolder::INVALID_INDEX )
+    {
+        const int x = static_cast< int >( static_cast< double >( current )
+                                          * THUMBNAIL_WIDTH / interval );
+        painter.setPen( Qt::red );
+        painter.drawLine( x, 0, x, this->height() );
+    }
+
+    if ( M_hover_index >= 0 )
+    {
+        const int x = static_cast< int >( static_cast< double >( M_hover_index )
+                                          * THUMBNAIL_WIDTH / interval );
+        painter.setPen( Qt::white );
+        painter.drawLine( x, 0, x, this->height() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::mousePressEvent( QMouseEvent * event )
+{
+    if ( event->button() == Qt::LeftButton )
+    {
+        const int index = indexAt( event->pos().x() );
+        if ( index >= 0 )
+        {
+            emit indexSelected( index );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::mouseMoveEvent( QMouseEvent * event )
+{
+    M_hover_index = indexAt( event->pos().x() );
+
+    if ( ( event->buttons() & Qt::LeftButton )
+         && M_hover_index >= 0 )
+    {
+        // scrubbing
+        emit indexSelected( M_hover_index );
+    }
+
+    updatePreview( event->globalPos() );
+    this->update();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::leaveEvent( QEvent * )
+{
+    M_hover_index = -1;
+    M_preview_label->hide();
+    this->update();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TimelineStrip::receiveImage( int index,
+                             const QImage & image,
+                             int generation,
+                             bool preview )
+{
+    if ( generation != M_generation )
+    {
+        // rendered before the holder was reset
+        return;
+    }
+
+    if ( preview )
+    {
+        if ( M_hover_index >= 0 )
+        {
+            M_preview_label->setPixmap( QPixmap::fromImage( image ) );
+            M_preview_label->resize( image.size() );
+            M_preview_label->show();
+        }
+        return;
+    }
+
+    M_pending.erase( index );
+
+    Cache::iterator it = M_cache.find( index );
+    if ( it != M_cache.end() )
+    {
+        it->second.image_ = image;
+        M_lru.splice( M_lru.begin(), M_lru, it->second.lru_pos_ );
+    }
+    else
+    {
+        M_lru.push_front( index );
+        CacheEntry & entry = M_cache[index];
+        entry.image_ = image;
+        entry.lru_pos_ = M_lru.begin();
+
+        // evict the least recently used thumbnails
+        while ( M_cache.size() > CACHE_SIZE )
+        {
+            M_cache.erase( M_lru.back() );
+            M_lru.pop_back();
+        }
+    }
+
+    this->update();
+}
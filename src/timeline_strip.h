@@ -0,0 +1,145 @@
+// -*-c++-*-
+
+/*!
+  \file timeline_strip.h
+  \brief timeline thumbnail strip widget class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.	If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_TIMELINE_STRIP_H
+#define RCSSMONITOR_TIMELINE_STRIP_H
+
+#include <QWidget>
+#include <QImage>
+
+#include "disp_holder.h"
+#include "thumbnail_renderer.h"
+
+#include <list>
+#include <map>
+#include <set>
+
+class QLabel;
+
+/*!
+  \class TimelineStrip
+  \brief scrubber widget that shows the thumbnails of the buffered data.
+
+  Each slot of the strip shows the thumbnail of the frame at a multiple
+  of the slot interval. The interval is doubled when the buffer becomes
+  longer than the strip, so the cached thumbnails remain valid. The
+  thumbnails are rendered by ThumbnailRenderer in the background and
+  kept in a LRU cache. Seeking only emits indexSelected(), and never
+  waits for the renderer.
+*/
+class TimelineStrip
+    : public QWidget {
+
+    Q_OBJECT
+
+private:
+
+    struct CacheEntry {
+        QImage image_;
+        std::list< int >::iterator lru_pos_;
+    };
+    typedef std::map< int, CacheEntry > Cache;
+
+    const DispHolder & M_disp_holder;
+
+    ThumbnailRenderer * M_renderer;
+    //! colors passed to the renderer. the cache is cleared when they are changed.
+    ThumbnailRenderer::Colors M_colors;
+
+    //! rendered thumbnails. key: buffered index.
+    Cache M_cache;
+    //! used order of the cached thumbnails. the front is the most recently used.
+    std::list< int > M_lru;
+    //! requested but not yet rendered indices.
+    std::set< int > M_pending;
+
+    //! incremented when the holder is reset. the results of the older generation are discarded.
+    int M_generation;
+    //! the first buffered data when the cache was built. used to detect the reset of the holder.
+    DispConstPtr M_first_disp;
+    //! buffer revision of the holder when the cache was checked. used to detect the late shows.
+    int M_buffer_revision;
+
+    //! hover preview popup
+    QLabel * M_preview_label;
+    //! buffered index under the mouse cursor. -1 if none.
+    int M_hover_index;
+
+    // not used
+    TimelineStrip();
+    TimelineStrip( const TimelineStrip & );
+    const TimelineStrip & operator=( const TimelineStrip & );
+
+public:
+
+    TimelineStrip( const DispHolder & disp_holder,
+                   QWidget * parent = 0 );
+    ~TimelineStrip();
+
+    QSize sizeHint() const;
+
+private:
+
+    void checkReset();
+    void checkColors();
+    void clearCache();
+    void dropCache( const int first );
+    int slotCount() const;
+    int slotInterval( const int slot_count ) const;
+    int indexAt( const int x ) const;
+
+    const QImage * findThumbnail( const int index );
+    void requestThumbnail( const int index );
+
+    void updatePreview( const QPoint & global_pos );
+
+protected:
+
+    void paintEvent( QPaintEvent * event );
+    void mousePressEvent( QMouseEvent * event );
+    void mouseMoveEvent( QMouseEvent * event );
+    void leaveEvent( QEvent * event );
+
+private slots:
+
+    void receiveImage( int index,
+                       const QImage & image,
+                       int generation,
+                       bool preview );
+
+signals:
+
+    void indexSelected( int index );
+
+};
+
+#endif
@@ -0,0 +1,252 @@
+// -*-c++-*-
+
+/*!
+  \file trace_painter.cpp
+  \brief ball and player trail painter class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C)  The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGui>
+
+#include "trace_painter.h"
+
+#include "render_settings.h"
+
+#include <algorithm>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TracePainter::TracePainter( const DispHolder & disp_holder )
+    : M_disp_holder( disp_holder ),
+      M_buffer_revision( disp_holder.bufferRevision() ),
+      M_current( DispHolder::INVALID_INDEX ),
+      M_ball_first( DispHolder::INVALID_INDEX ),
+      M_player_first( DispHolder::INVALID_INDEX )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TracePainter::~TracePainter()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TracePainter::prepare( const RenderSettings & settings )
+{
+    M_current_disp.reset();
+    M_current = DispHolder::INVALID_INDEX;
+    M_ball_first = DispHolder::INVALID_INDEX;
+    M_player_first = DispHolder::INVALID_INDEX;
+
+    const int ball_cycle = ( settings.showBall()
+                             ? settings.ballTraceCycle()
+                             : 0 );
+    const int player_cycle = ( settings.showPlayer()
+                               && ( settings.playerTraceAll()
+                                    || settings.selectedNumber() != 0 )
+                               ? settings.playerTraceCycle()
+                               : 0 );
+
+    if ( ball_cycle <= 0
+         && player_cycle <= 0 )
+    {
+        return;
+    }
+
+    // trails are available only for the buffered data.
+    const DispCont & cont = M_disp_holder.dispCont();
+    const std::size_t current = M_disp_holder.currentIndex();
+
+    if ( current == DispHolder::INVALID_INDEX
+         || cont.size() <= current )
+    {
+        return;
+    }
+
+    updatePoints( current );
+
+    M_current_disp = cont[current];
+    M_current = current;
+
+    const int time = static_cast< int >( M_current_disp->show_.time_ );
+
+    if ( ball_cycle > 0 )
+    {
+        M_ball_first = M_disp_holder.getIndex( std::max( 0, time - ball_cycle ) );
+    }
+
+    if ( player_cycle > 0 )
+    {
+        M_player_first = M_disp_holder.getIndex( std::max( 0, time - player_cycle ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TracePainter::draw( QPainter & painter,
+                    const RenderSettings & settings )
+{
+    if ( ! M_current_disp )
+    {
+        return;
+    }
+
+    // draw in the field coordinates
+    painter.save();
+    painter.translate( settings.fieldCenter() );
+    painter.scale( settings.fieldScale(), settings.fieldScale() );
+    painter.setBrush( Qt::NoBrush );
+
+    drawTrace( painter, settings.ballPen(), M_ball_points, M_ball_first, M_current );
+
+    if ( M_player_first != DispHolder::INVALID_INDEX )
+    {
+        const rcss::rcg::ShowInfoT & show = M_current_disp->show_;
+
+        for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+        {
+            const rcss::rcg::PlayerT & player = show.player_[i];
+
+            if ( player.state_ == 0 )
+            {
+                continue;
+            }
+
+            if ( ! settings.playerTraceAll()
+                 && ! settings.selectedPlayer( player.side(), player.unum_ ) )
+            {
+                continue;
+            }
+
+            drawTrace( painter,
+                       ( i < rcss::rcg::MAX_PLAYER
+                         ? settings.leftTeamPen()
+                         : settings.rightTeamPen() ),
+                       M_player_points[i], M_player_first, M_current );
+        }
+    }
+
+    painter.restore();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  append the positions of the display data that have not been converted
+  yet, up to the given index.
+*/
+void
+TracePainter::updatePoints( const std::size_t last )
+{
+    const DispCont & cont = M_disp_holder.dispCont();
+
+    if ( cont.empty()
+         || cont.front() != M_first_disp
+         || cont.size() < M_ball_points.size() )
+    {
+        // the holder has been cleared or a new log has been opened.
+        M_first_disp = ( cont.empty() ? DispConstPtr() : cont.front() );
+        M_ball_points.clear();
+        for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+        {
+            M_player_points[i].clear();
+        }
+    }
+
+    if ( M_buffer_revision != M_disp_holder.bufferRevision() )
+    {
+        // the late show has shifted the buffered data.
+        const std::size_t shifted = M_disp_holder.firstShiftedIndex( M_buffer_revision );
+        M_buffer_revision = M_disp_holder.bufferRevision();
+
+        if ( shifted < M_ball_points.size() )
+        {
+            M_ball_points.resize( shifted );
+            for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+            {
+                M_player_points[i].resize( shifted );
+            }
+        }
+    }
+
+    for ( std::size_t idx = M_ball_points.size();
+          idx <= last && idx < cont.size();
+          ++idx )
+    {
+        const rcss::rcg::ShowInfoT & show = cont[idx]->show_;
+
+        M_ball_points.push_back( QPointF( show.ball_.x_, show.ball_.y_ ) );
+        for ( int i = 0; i < rcss::rcg::MAX_PLAYER*2; ++i )
+        {
+            M_player_points[i].push_back( QPointF( show.player_[i].x_,
+                                                   show.player_[i].y_ ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TracePainter::drawTrace( QPainter & painter,
+                         const QPen & pen,
+                         const std::vector< QPointF > & points,
+                         const std::size_t first,
+                         const std::size_t last ) const
+{
+    if ( first == DispHolder::INVALID_INDEX
+         || last <= first
+         || points.size() <= last )
+    {
+        return;
+    }
+
+    // the line width must not be scaled by the painter transformation.
+    QPen cosmetic_pen( pen );
+    cosmetic_pen.setCosmetic( true );
+
+    painter.setPen( cosmetic_pen );
+    painter.drawPolyline( &points[first], static_cast< int >( last - first + 1 ) );
+}
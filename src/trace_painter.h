@@ -0,0 +1,107 @@
+// -*-c++-*-
+
+/*!
+  \file trace_painter.h
+  \brief ball and player trail painter class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C)  The RoboCup Soccer Server Maintenance Group.
+ Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSSMONITOR_TRACE_PAINTER_H
+#define RCSSMONITOR_TRACE_PAINTER_H
+
+#include <QPointF>
+
+#include "painter_interface.h"
+#include "disp_holder.h"
+
+#include <rcsslogplayer/types.h>
+
+#include <vector>
+
+class QPen;
+
+/*!
+  \class TracePainter
+  \brief draw the trails of the ball and players over the last cycles.
+
+  The positions of the buffered display data are converted to the
+  vertex arrays only once. The arrays are extended when the current
+  index goes beyond the converted frames, and truncated at the first
+  shifted index when a late show is inserted. Each trail is drawn as one
+  polyline of the sub range of the arrays.
+*/
+class TracePainter
+    : public PainterInterface {
+private:
+    const DispHolder & M_disp_holder;
+
+    //! the first buffered data when the vertex arrays were built. used to detect the reset of the holder.
+    DispConstPtr M_first_disp;
+    //! buffer revision of the holder when the vertex arrays were updated.
+    int M_buffer_revision;
+
+    //! ball positions of each buffered display data in the field coordinates.
+    std::vector< QPointF > M_ball_points;
+    //! player positions of each buffered display data in the field coordinates.
+    std::vector< QPointF > M_player_points[rcss::rcg::MAX_PLAYER*2];
+
+    //! the current display data when prepared. null if no trail is drawn.
+    DispConstPtr M_current_disp;
+    //! the current index when prepared
+    std::size_t M_current;
+    //! the first index of the ball trail. INVALID_INDEX if not drawn.
+    std::size_t M_ball_first;
+    //! the first index of the player trails. INVALID_INDEX if not drawn.
+    std::size_t M_player_first;
+
+    // not used
+    TracePainter();
+    TracePainter( const TracePainter & );
+    const TracePainter & operator=( const TracePainter & );
+public:
+
+    TracePainter( const DispHolder & disp_holder );
+    ~TracePainter();
+
+    void prepare( const RenderSettings & settings );
+
+    void draw( QPainter & painter,
+               const RenderSettings & settings );
+
+private:
+
+    void updatePoints( const std::size_t last );
+
+    void drawTrace( QPainter & painter,
+                    const QPen & pen,
+                    const std::vector< QPointF > & points,
+                    const std::size_t first,
+                    const std::size_t last ) const;
+
+};
+
+#endif